@@ -0,0 +1,571 @@
+/**
+ * The offline benchmark of the request engine, the JSON parser, the CRC, the stream and the error queue.
+ *
+ * fb_bench [iterations]
+ *
+ * The requests are served by FB_Replay_Client (the recorded responses) and FB_Local_RTDB (the
+ * in-memory database, which also sends the chunked bodies), the time is the host time per operation
+ * and only compares the builds.
+ * The injected latency and dropped connections of the transport give the request rate of the slow
+ * server and the error queue that recovers the dropped writes.
+ */
+
+#include <Firebase.h>
+#include "wcs/replay/FB_Local_RTDB.h"
+#include "json/extras/parse/fb_json_strtod.h"
+#include "json/extras/print/fb_json_dtoa.h"
+
+static int iterations = 2000;
+static int failures = 0;
+
+static void report(const char *name, unsigned long start, int n, size_t bytes)
+{
+    unsigned long us = micros() - start;
+    printf("%-24s %8d ops %10.2f us/op", name, n, n > 0 ? (double)us / n : 0.0);
+    if (bytes)
+        printf(" %10.1f bytes/op", (double)bytes / n);
+    printf("\n");
+}
+
+//the throughput of the operations that process the data of the given size
+static void reportRate(const char *name, unsigned long start, int n, size_t bytes)
+{
+    unsigned long us = micros() - start;
+    printf("%-24s %8d ops %10.2f us/op %10.1f MB/s\n", name, n, n > 0 ? (double)us / n : 0.0, us > 0 ? (double)bytes / us : 0.0);
+}
+
+//the operations per second e.g. the requests or the delivered stream events
+static void reportPerSec(const char *name, unsigned long start, int n)
+{
+    unsigned long us = micros() - start;
+    printf("%-24s %8d ops %10.2f us/op %10.1f ops/s\n", name, n, n > 0 ? (double)us / n : 0.0, us > 0 ? n * 1e6 / us : 0.0);
+}
+
+static void check(bool ok, FirebaseData &fbdo, const char *name)
+{
+    if (!ok)
+    {
+        if (failures++ < 5)
+            printf("%s failed: %s\n", name, fbdo.errorReason().c_str());
+    }
+}
+
+static MB_String jsonDocument(int items)
+{
+    FirebaseJson json;
+    for (int i = 0; i < items; i++)
+    {
+        MB_String key = "uid_";
+        key += i;
+        json.set(MB_String(key + "/name").c_str(), "door reader");
+        json.set(MB_String(key + "/count").c_str(), i);
+        json.set(MB_String(key + "/open").c_str(), i % 2 == 0);
+    }
+    MB_String s;
+    json.toString(s);
+    return s;
+}
+
+static void benchGetInt()
+{
+    FB_Replay_Client replay;
+    FirebaseData fbdo;
+    fbdo.setTransport(&replay, true);
+    replay.addResponse("HTTP/1.1 200 OK\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: 4\r\n\r\n1234");
+    replay.setRepeat(true);
+
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++)
+        check(Firebase.getInt(fbdo, "/doors/front/count"), fbdo, "get_int");
+    report("get_int", start, iterations, replay.bytesWritten());
+}
+
+static void benchGetJsonChunked()
+{
+    MB_String body = jsonDocument(20);
+    MB_String response = "HTTP/1.1 200 OK\r\nContent-Type: application/json; charset=utf-8\r\nTransfer-Encoding: chunked\r\n\r\n";
+    for (size_t i = 0; i < body.length(); i += 256)
+    {
+        size_t n = body.length() - i < 256 ? body.length() - i : 256;
+        char size[16];
+        snprintf(size, sizeof(size), "%x\r\n", (unsigned)n);
+        response += size;
+        response += body.substr(i, n);
+        response += "\r\n";
+    }
+    response += "0\r\n\r\n";
+
+    FB_Replay_Client replay;
+    FirebaseData fbdo;
+    fbdo.setTransport(&replay, true);
+    fbdo.setResponseSize(8192);
+    replay.addResponse(response.c_str());
+    replay.setRepeat(true);
+
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++)
+        check(Firebase.getJSON(fbdo, "/doors"), fbdo, "get_json_chunked");
+    report("get_json_chunked", start, iterations, replay.bytesWritten());
+}
+
+static void benchLocalSetGet()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+
+    FirebaseJson json;
+    json.set("uid", "04A1B2C3");
+    json.set("granted", true);
+
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++)
+    {
+        json.set("ts", i);
+        check(Firebase.setJSON(fbdo, "/logs/front", json), fbdo, "local_set_json");
+        check(Firebase.getInt(fbdo, "/logs/front/ts"), fbdo, "local_get_int");
+    }
+    report("local_set_get", start, iterations, client.bytesWritten());
+}
+
+//the large GET and the file download from the local RTDB with the Content-Length and the chunked bodies
+static void benchLocalChunked()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+    fbdo.setResponseSize(32768);
+
+    MB_String body = jsonDocument(200);
+    db.set("/doors", body.c_str());
+
+    std::vector<uint8_t> data(16384);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = i * 31 + 7;
+    check(Firebase.setBlob(fbdo, "/firmware", data.data(), data.size()), fbdo, "local_set_blob");
+
+    size_t chunks[] = {0, 4096, 256};
+    const char *names[] = {"length", "chunk_4k", "chunk_256"};
+    int n = iterations / 10 > 0 ? iterations / 10 : 1;
+
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++)
+    {
+        db.setChunkSize(chunks[c]);
+        char name[32];
+
+        snprintf(name, sizeof(name), "local_json_%s", names[c]);
+        unsigned long start = micros();
+        for (int i = 0; i < n; i++)
+            check(Firebase.getJSON(fbdo, "/doors") && fbdo.jsonString().length() > body.length() / 2, fbdo, name);
+        reportRate(name, start, n, body.length() * n);
+
+        snprintf(name, sizeof(name), "local_file_%s", names[c]);
+        start = micros();
+        for (int i = 0; i < n; i++)
+        {
+            bool ok = Firebase.getFile(fbdo, mem_storage_type_flash, "/firmware", "/firmware.bin");
+            File file = SPIFFS.open("/firmware.bin", "r");
+            check(ok && file.size() == data.size(), fbdo, name);
+            file.close();
+        }
+        reportRate(name, start, n, data.size() * n);
+    }
+}
+
+static void benchJson()
+{
+    MB_String doc = jsonDocument(20);
+    FirebaseJson json;
+    MB_String out;
+
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++)
+    {
+        json.setJsonData(doc.c_str());
+        json.toString(out);
+    }
+    report("json_parse_serialize", start, iterations, doc.length() * iterations);
+}
+
+static void benchNumbers()
+{
+    //the sensor history, two decimal values separated as in a JSON array
+    MB_String doc;
+    char buf[16];
+    for (int i = 0; i < 100; i++)
+    {
+        snprintf(buf, sizeof(buf), "%d.%02d,", 20 + i % 15, (i * 37) % 100);
+        doc += buf;
+    }
+
+    volatile double sum = 0;
+    const unsigned char *p = (const unsigned char *)doc.c_str();
+    size_t len = doc.length();
+
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++)
+    {
+        double value = 0;
+        int64_t ivalue = 0;
+        int isInt = 0;
+        for (size_t pos = 0; pos < len; pos++)
+        {
+            size_t n = fb_json_strtod(p + pos, len - pos, &value, &ivalue, &isInt);
+            if (n == 0)
+                value = strtod((const char *)p + pos, nullptr);
+            sum = sum + value;
+            while (pos < len && p[pos] != ',')
+                pos++;
+        }
+    }
+    report("json_number_parse", start, iterations, len * iterations);
+
+    start = micros();
+    for (int i = 0; i < iterations; i++)
+    {
+        for (size_t pos = 0; pos < len; pos++)
+        {
+            sum = sum + strtod((const char *)p + pos, nullptr);
+            while (pos < len && p[pos] != ',')
+                pos++;
+        }
+    }
+    report("json_number_strtod", start, iterations, len * iterations);
+}
+
+static void benchPrintNumbers()
+{
+    //the telemetry array of the two decimal readings and the full precision values
+    std::vector<double> values;
+    uint32_t x = 1;
+    MB_JSON *arr = MB_JSON_CreateArray();
+    for (int i = 0; i < 500; i++)
+    {
+        x = x * 1103515245 + 12345;
+        double v = i % 2 == 0 ? 20 + (x >> 16) % 1500 / 100.0 : (double)x / 3.0e7;
+        values.push_back(v);
+        MB_JSON_AddItemToArray(arr, MB_JSON_CreateNumber(v));
+    }
+
+    //the printed numbers are parsed back to the same values
+    char num[FB_JSON_DTOA_BUFFER_SIZE];
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        fb_json_dtoa(values[i], num);
+        if (strtod(num, nullptr) != values[i] && failures++ < 5)
+            printf("json_print_number %s does not round trip\n", num);
+    }
+
+    std::vector<char> out(values.size() * FB_JSON_DTOA_BUFFER_SIZE);
+    size_t len = 0;
+
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++)
+    {
+        MB_JSON_PrintPreallocated(arr, out.data(), (int)out.size(), 0);
+        len = strlen(out.data());
+    }
+    reportRate("json_print_numbers", start, iterations, len * iterations);
+
+    //the earlier printf round trip of each number as the baseline
+    start = micros();
+    for (int i = 0; i < iterations; i++)
+    {
+        char *p = out.data();
+        *p++ = '[';
+        for (size_t j = 0; j < values.size(); j++)
+        {
+            double test = 0;
+            int n = snprintf(p, FB_JSON_DTOA_BUFFER_SIZE, "%1.15g", values[j]);
+            if (sscanf(p, "%lg", &test) != 1 || test != values[j])
+                n = snprintf(p, FB_JSON_DTOA_BUFFER_SIZE, "%1.17g", values[j]);
+            p += n;
+            *p++ = ',';
+        }
+        p[-1] = ']';
+        *p = 0;
+    }
+    reportRate("json_print_printf", start, iterations, strlen(out.data()) * iterations);
+
+    MB_JSON_Delete(arr);
+}
+
+static void benchCRC()
+{
+    //the flash sector of the OTA image and the TCP segments of the streamed download
+    std::vector<uint8_t> buf(4096 + 1);
+    for (size_t i = 0; i < buf.size(); i++)
+        buf[i] = (uint8_t)(i * 131 + 7);
+
+    FastCRC32 crc;
+    volatile uint32_t value = 0;
+    int n = iterations * 10;
+
+    unsigned long start = micros();
+    for (int i = 0; i < n; i++)
+        value = value ^ crc.crc32(buf.data(), 4096);
+    reportRate("crc32_sector", start, n, (size_t)n * 4096);
+
+    start = micros();
+    for (int i = 0; i < n; i++)
+    {
+        FastCRC32_Context ctx;
+        crc.crc32_begin(ctx);
+        for (size_t pos = 0; pos < 4096; pos += 1460)
+            crc.update(ctx, buf.data() + 1 + pos, 4096 - pos < 1460 ? 4096 - pos : 1460);
+        value = value ^ crc.result(ctx);
+    }
+    reportRate("crc32_stream_unaligned", start, n, (size_t)n * 4096);
+
+    //the bitwise CRC as the baseline
+    n = iterations > 10 ? iterations / 10 : 1;
+    start = micros();
+    for (int i = 0; i < n; i++)
+    {
+        uint32_t c = 0xffffffff;
+        for (size_t j = 0; j < 4096; j++)
+        {
+            c ^= buf[j];
+            for (int k = 0; k < 8; k++)
+                c = (c >> 1) ^ (0xedb88320 & (0 - (c & 1)));
+        }
+        value = value ^ ~c;
+    }
+    reportRate("crc32_bitwise", start, n, (size_t)n * 4096);
+}
+
+static void benchRequestRate()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+    check(Firebase.setInt(fbdo, "/doors/front/count", 1), fbdo, "request_rate");
+
+    //the server time and the round trip of the LAN and the cloud
+    uint32_t latency[] = {0, 1, 5};
+    const char *names[] = {"requests_0ms", "requests_1ms", "requests_5ms"};
+
+    for (int l = 0; l < 3; l++)
+    {
+        client.setLatency(latency[l]);
+        int n = latency[l] == 0 ? iterations : (iterations / 10 > 0 ? iterations / 10 : 1);
+        unsigned long start = micros();
+        for (int i = 0; i < n; i++)
+            check(Firebase.getInt(fbdo, "/doors/front/count"), fbdo, "request_rate");
+        reportPerSec(names[l], start, n);
+    }
+}
+
+static void benchFanOut()
+{
+    //one writer and the streams of 8 door readers on the same node
+    const int readers = 8;
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client writer(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&writer, true);
+
+    std::vector<FB_Local_RTDB_Client *> clients;
+    std::vector<FirebaseData *> streams;
+    for (int r = 0; r < readers; r++)
+    {
+        clients.push_back(new FB_Local_RTDB_Client(db));
+        streams.push_back(new FirebaseData());
+        streams[r]->setTransport(clients[r], true);
+        check(Firebase.beginStream(*streams[r], "/allowlist"), *streams[r], "fan_out_begin");
+        check(Firebase.readStream(*streams[r]), *streams[r], "fan_out_read");
+    }
+
+    db.resetCounters();
+    int received = 0, n = iterations / 4 > 0 ? iterations / 4 : 1;
+    unsigned long start = micros();
+    for (int i = 0; i < n; i++)
+    {
+        check(Firebase.setIntAsync(fbdo, "/allowlist/04A1B2C3", i), fbdo, "fan_out_set");
+        for (int r = 0; r < readers; r++)
+        {
+            for (int j = 0; j < 10; j++)
+            {
+                check(Firebase.readStream(*streams[r]), *streams[r], "fan_out_read");
+                if (streams[r]->streamAvailable())
+                {
+                    received++;
+                    break;
+                }
+            }
+        }
+    }
+    reportPerSec("stream_fan_out", start, received);
+
+    if (received != n * readers || db.eventCount() != (size_t)(n * readers))
+    {
+        printf("stream_fan_out received %d of %d events (%d sent)\n", received, n * readers, (int)db.eventCount());
+        failures++;
+    }
+
+    for (int r = 0; r < readers; r++)
+    {
+        delete streams[r];
+        delete clients[r];
+    }
+}
+
+static void benchQueueDrops()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+    Firebase.setMaxRetry(fbdo, 1);
+    Firebase.setMaxErrorQueue(fbdo, 100);
+
+    //30% of the connections are dropped, the failed writes are queued and sent again
+    randomSeed(1);
+    client.setDropRate(30);
+    int n = iterations / 20 > 0 ? (iterations / 20 < 100 ? iterations / 20 : 100) : 1;
+    int rounds = 0;
+
+    unsigned long start = micros();
+    for (int i = 0; i < n; i++)
+    {
+        MB_String path = "/queue/";
+        path += i;
+        Firebase.setInt(fbdo, path, i);
+    }
+
+    while (Firebase.errorQueueCount(fbdo) > 0 && rounds < 1000)
+    {
+        Firebase.processErrorQueue(fbdo);
+        rounds++;
+    }
+    reportPerSec("queue_under_drops", start, n);
+    printf("%-24s %8d drops %6d rounds\n", "", (int)client.dropCount(), rounds);
+
+    //all writes were delivered in the end
+    int missing = 0;
+    for (int i = 0; i < n; i++)
+    {
+        MB_String path = "/queue/", value;
+        path += i;
+        db.get(path.c_str(), value);
+        if (value != MB_String(i))
+            missing++;
+    }
+
+    if (missing > 0 || Firebase.errorQueueCount(fbdo) > 0)
+    {
+        printf("queue_under_drops has %d missing writes, %d queued\n", missing, Firebase.errorQueueCount(fbdo));
+        failures++;
+    }
+}
+
+static void benchStream()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client c1(db), c2(db);
+    FirebaseData fbdo, stream;
+    fbdo.setTransport(&c1, true);
+    stream.setTransport(&c2, true);
+
+    check(Firebase.beginStream(stream, "/doors"), stream, "begin_stream");
+    check(Firebase.readStream(stream), stream, "read_stream");
+
+    int received = 0;
+    unsigned long start = micros();
+    for (int i = 0; i < iterations; i++)
+    {
+        check(Firebase.setIntAsync(fbdo, "/doors/front/count", i), fbdo, "stream_set");
+        for (int j = 0; j < 10; j++)
+        {
+            check(Firebase.readStream(stream), stream, "read_stream");
+            if (stream.streamAvailable())
+            {
+                received++;
+                break;
+            }
+        }
+    }
+    report("stream_event", start, received, 0);
+
+    if (received != iterations)
+    {
+        printf("stream_event received %d of %d events\n", received, iterations);
+        failures++;
+    }
+}
+
+static void benchQueuePersistence()
+{
+    FB_Replay_Client replay;
+    FirebaseData fbdo;
+    fbdo.setTransport(&replay, true);
+    Firebase.setMaxRetry(fbdo, 1);
+    Firebase.setMaxErrorQueue(fbdo, 20);
+
+    //the dropped writes are kept in the error queue
+    replay.setDropRate(100);
+    for (int i = 0; i < 20; i++)
+    {
+        MB_String path = "/logs/";
+        path += i;
+        Firebase.setInt(fbdo, path, i);
+    }
+
+    if (Firebase.errorQueueCount(fbdo) != 20)
+    {
+        printf("queue_save has %d of 20 queued writes\n", Firebase.errorQueueCount(fbdo));
+        failures++;
+        return;
+    }
+
+    int n = iterations / 10 > 0 ? iterations / 10 : 1;
+    unsigned long start = micros();
+    for (int i = 0; i < n; i++)
+        check(Firebase.saveErrorQueue(fbdo, "/queue.txt", mem_storage_type_flash), fbdo, "queue_save");
+    report("queue_save", start, n, 0);
+
+    start = micros();
+    for (int i = 0; i < n; i++)
+    {
+        Firebase.clearErrorQueue(fbdo);
+        check(Firebase.restoreErrorQueue(fbdo, "/queue.txt", mem_storage_type_flash), fbdo, "queue_restore");
+    }
+    report("queue_restore", start, n, 0);
+
+    if (Firebase.errorQueueCount(fbdo) != 20)
+    {
+        printf("queue_restore has %d of 20 queued writes\n", Firebase.errorQueueCount(fbdo));
+        failures++;
+    }
+}
+
+int fb_host_main(int argc, char *argv[])
+{
+    if (argc > 1)
+        iterations = atoi(argv[1]);
+
+    FirebaseConfig config;
+    FirebaseAuth auth;
+    config.database_url = "bench.firebaseio.com";
+    config.signer.tokens.legacy_token = "secret";
+    Firebase.begin(&config, &auth);
+
+    benchGetInt();
+    benchGetJsonChunked();
+    benchLocalSetGet();
+    benchLocalChunked();
+    benchJson();
+    benchNumbers();
+    benchPrintNumbers();
+    benchCRC();
+    benchRequestRate();
+    benchStream();
+    benchFanOut();
+    benchQueuePersistence();
+    benchQueueDrops();
+
+    return failures == 0 ? 0 : 1;
+}
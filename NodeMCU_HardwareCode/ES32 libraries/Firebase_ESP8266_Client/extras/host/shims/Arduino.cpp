@@ -0,0 +1,77 @@
+/**
+ * The host (Linux) runtime of the shims, the global objects and main.
+ *
+ * The library keeps the object addresses in 32-bit integers (e.g. MB_StringPtr and the queue
+ * item addresses) as on the device, the host program is linked as the non-PIE executable to
+ * place its code and data in the low 4 GB, all heap blocks are taken from the program break
+ * (no mmap and no thread arena) and fb_host_main runs on the stack that is allocated from the heap.
+ */
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+#include <SPI.h>
+#include <ESP8266WiFi.h>
+#include <Updater.h>
+#include <malloc.h>
+#include <pthread.h>
+
+#define FB_HOST_STACK_SIZE (8 * 1024 * 1024)
+
+HardwareSerial Serial;
+EspClass ESP;
+SPIClass SPI;
+ESP8266WiFiClass WiFi;
+UpdaterClass Update;
+fs::FS SPIFFS("flash");
+fs::FS LittleFS("flash");
+SDClass SD;
+SDFSClass SDFS;
+
+struct fb_host_args_t
+{
+    int argc;
+    char **argv;
+    int ret;
+};
+
+static bool fb_host_low(const void *p) { return (uintptr_t)p < 0xffffffffULL; }
+
+static void *fb_host_run(void *arg)
+{
+    fb_host_args_t *args = (fb_host_args_t *)arg;
+    args->ret = fb_host_main(args->argc, args->argv);
+    return nullptr;
+}
+
+int main(int argc, char *argv[])
+{
+    mallopt(M_MMAP_MAX, 0);
+    mallopt(M_ARENA_MAX, 1);
+    mallopt(M_TRIM_THRESHOLD, -1);
+
+    void *stack = malloc(FB_HOST_STACK_SIZE);
+    static int data;
+
+    if (!stack || !fb_host_low(stack) || !fb_host_low(&data) || !fb_host_low((void *)&main))
+    {
+        fprintf(stderr, "the host runtime could not place the program in the low 4 GB (link with -no-pie)\n");
+        return 1;
+    }
+
+    fb_host_args_t args = {argc, argv, 0};
+    pthread_attr_t attr;
+    pthread_t thread;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, FB_HOST_STACK_SIZE);
+
+    if (pthread_create(&thread, &attr, fb_host_run, &args) != 0)
+    {
+        fprintf(stderr, "the host runtime could not start the program thread\n");
+        return 1;
+    }
+
+    pthread_join(thread, nullptr);
+    pthread_attr_destroy(&attr);
+    return args.ret;
+}
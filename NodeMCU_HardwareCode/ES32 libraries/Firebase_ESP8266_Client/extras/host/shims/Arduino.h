@@ -0,0 +1,517 @@
+/**
+ * The host (Linux) shim of the Arduino core API that is used by the library.
+ *
+ * Only the parts of String, Print, Stream, Client, IPAddress, the PROGMEM helpers and the
+ * time functions that the library calls are provided, the behavior follows the ESP8266 core.
+ */
+
+#ifndef FB_HOST_ARDUINO_H
+#define FB_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <thread>
+
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+
+#define FB_HOST_BUILD 1
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define PGM_P const char *
+#define PGM_VOID_P const void *
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s) FPSTR(s)
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr) (*(const void *const *)(addr))
+#define memcpy_P memcpy
+#define memcmp_P memcmp
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcat_P strcat
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcasecmp_P strcasecmp
+#define strncasecmp_P strncasecmp
+#define strstr_P strstr
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+
+#ifndef __STRINGIFY
+#define __STRINGIFY(a) #a
+#endif
+
+//the host clock starts at zero as the device does after boot
+inline std::chrono::steady_clock::time_point fb_host_start()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+inline unsigned long millis()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - fb_host_start()).count();
+}
+
+inline unsigned long micros()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - fb_host_start()).count();
+}
+
+inline void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+inline void yield() {}
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return 0; }
+inline long random(long max) { return max > 0 ? rand() % max : 0; }
+inline long random(long min, long max) { return max > min ? min + rand() % (max - min) : min; }
+inline void randomSeed(unsigned long seed) { srand((unsigned)seed); }
+
+class String
+{
+public:
+    String() {}
+    String(const char *cstr) { if (cstr) s = cstr; }
+    String(const String &str) : s(str.s) {}
+    String(const __FlashStringHelper *str) { if (str) s = reinterpret_cast<const char *>(str); }
+    String(const std::string &str) : s(str) {}
+    explicit String(char c) : s(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) { fromInt(value, base); }
+    explicit String(int value, unsigned char base = 10) { fromInt(value, base); }
+    explicit String(unsigned int value, unsigned char base = 10) { fromUInt(value, base); }
+    explicit String(long value, unsigned char base = 10) { fromInt(value, base); }
+    explicit String(unsigned long value, unsigned char base = 10) { fromUInt(value, base); }
+    explicit String(long long value, unsigned char base = 10) { fromInt(value, base); }
+    explicit String(unsigned long long value, unsigned char base = 10) { fromUInt(value, base); }
+    explicit String(float value, unsigned char decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+    explicit String(double value, unsigned char decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+
+    String &operator=(const String &rhs) { s = rhs.s; return *this; }
+    String &operator=(const char *cstr) { s = cstr ? cstr : ""; return *this; }
+    String &operator=(const __FlashStringHelper *str) { s = str ? reinterpret_cast<const char *>(str) : ""; return *this; }
+
+    const char *c_str() const { return s.c_str(); }
+    unsigned int length() const { return (unsigned int)s.length(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+    void clear() { s.clear(); }
+
+    bool concat(const String &str) { s += str.s; return true; }
+    bool concat(const char *cstr) { if (cstr) s += cstr; return true; }
+    bool concat(const char *cstr, unsigned int len) { if (cstr) s.append(cstr, len); return true; }
+    bool concat(char c) { s += c; return true; }
+    bool concat(unsigned char c) { return concat(String((unsigned int)c)); }
+    bool concat(int num) { return concat(String(num)); }
+    bool concat(unsigned int num) { return concat(String(num)); }
+    bool concat(long num) { return concat(String(num)); }
+    bool concat(unsigned long num) { return concat(String(num)); }
+    bool concat(long long num) { return concat(String(num)); }
+    bool concat(unsigned long long num) { return concat(String(num)); }
+    bool concat(float num) { return concat(String(num)); }
+    bool concat(double num) { return concat(String(num)); }
+    bool concat(const __FlashStringHelper *str) { return concat(reinterpret_cast<const char *>(str)); }
+
+    template <typename T>
+    String &operator+=(const T &rhs)
+    {
+        concat(rhs);
+        return *this;
+    }
+
+    explicit operator bool() const { return true; }
+
+    int compareTo(const String &str) const { return s.compare(str.s); }
+    bool equals(const String &str) const { return s == str.s; }
+    bool equals(const char *cstr) const { return s == (cstr ? cstr : ""); }
+    bool equalsIgnoreCase(const String &str) const { return strcasecmp(s.c_str(), str.c_str()) == 0; }
+    bool operator==(const String &rhs) const { return equals(rhs); }
+    bool operator==(const char *cstr) const { return equals(cstr); }
+    bool operator!=(const String &rhs) const { return !equals(rhs); }
+    bool operator!=(const char *cstr) const { return !equals(cstr); }
+    bool operator<(const String &rhs) const { return s < rhs.s; }
+    bool startsWith(const String &prefix) const { return s.compare(0, prefix.s.length(), prefix.s) == 0; }
+    bool endsWith(const String &suffix) const { return s.length() >= suffix.s.length() && s.compare(s.length() - suffix.s.length(), suffix.s.length(), suffix.s) == 0; }
+
+    char charAt(unsigned int index) const { return index < s.length() ? s[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < s.length()) s[index] = c; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index) { return s[index]; }
+    void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const
+    {
+        if (!bufsize || !buf)
+            return;
+        size_t n = index < s.length() ? std::min((size_t)bufsize - 1, s.length() - index) : 0;
+        memcpy(buf, s.c_str() + index, n);
+        buf[n] = 0;
+    }
+
+    int indexOf(char ch, unsigned int fromIndex = 0) const { return find(s.find(ch, fromIndex)); }
+    int indexOf(const String &str, unsigned int fromIndex = 0) const { return find(s.find(str.s, fromIndex)); }
+    int lastIndexOf(char ch) const { return find(s.rfind(ch)); }
+    int lastIndexOf(const String &str) const { return find(s.rfind(str.s)); }
+    String substring(unsigned int beginIndex) const { return beginIndex < s.length() ? String(s.substr(beginIndex)) : String(); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const
+    {
+        if (beginIndex > endIndex)
+            std::swap(beginIndex, endIndex);
+        if (beginIndex >= s.length())
+            return String();
+        return String(s.substr(beginIndex, endIndex - beginIndex));
+    }
+
+    void replace(const String &find, const String &replace)
+    {
+        if (find.s.empty())
+            return;
+        size_t pos = 0;
+        while ((pos = s.find(find.s, pos)) != std::string::npos)
+        {
+            s.replace(pos, find.s.length(), replace.s);
+            pos += replace.s.length();
+        }
+    }
+
+    void remove(unsigned int index) { if (index < s.length()) s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < s.length()) s.erase(index, count); }
+    void toLowerCase() { for (auto &c : s) c = tolower(c); }
+    void toUpperCase() { for (auto &c : s) c = toupper(c); }
+    void trim()
+    {
+        size_t b = s.find_first_not_of(" \t\r\n");
+        size_t e = s.find_last_not_of(" \t\r\n");
+        s = b == std::string::npos ? std::string() : s.substr(b, e - b + 1);
+    }
+
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+    double toDouble() const { return atof(s.c_str()); }
+
+    friend class StringSumHelper;
+
+    friend String operator+(const String &lhs, const String &rhs)
+    {
+        String r(lhs);
+        r.concat(rhs);
+        return r;
+    }
+
+    friend String operator+(const String &lhs, const char *rhs)
+    {
+        String r(lhs);
+        r.concat(rhs);
+        return r;
+    }
+
+    friend String operator+(const char *lhs, const String &rhs)
+    {
+        String r(lhs);
+        r.concat(rhs);
+        return r;
+    }
+
+private:
+    std::string s;
+
+    static int find(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+
+    void fromInt(long long value, unsigned char base)
+    {
+        if (value < 0 && base == 10)
+        {
+            s = "-";
+            fromUInt((unsigned long long)(-value), base, true);
+        }
+        else
+            fromUInt((unsigned long long)value, base);
+    }
+
+    void fromUInt(unsigned long long value, unsigned char base, bool append = false)
+    {
+        char buf[72];
+        int i = sizeof(buf) - 1;
+        buf[i] = 0;
+        if (base < 2)
+            base = 10;
+        do
+        {
+            int d = value % base;
+            buf[--i] = d < 10 ? '0' + d : 'a' + d - 10;
+            value /= base;
+        } while (value);
+        if (append)
+            s += buf + i;
+        else
+            s = buf + i;
+    }
+
+    void fromDouble(double value, unsigned char decimalPlaces)
+    {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+        s = buf;
+    }
+};
+
+class StringSumHelper : public String
+{
+public:
+    StringSumHelper(const String &s) : String(s) {}
+    StringSumHelper(const char *p) : String(p) {}
+};
+
+inline char *fb_host_utoa(unsigned long long value, char *result, int base)
+{
+    String s(value, (unsigned char)base);
+    strcpy(result, s.c_str());
+    return result;
+}
+
+inline char *fb_host_itoa(long long value, char *result, int base)
+{
+    String s(value, (unsigned char)base);
+    strcpy(result, s.c_str());
+    return result;
+}
+
+inline char *itoa(int value, char *result, int base) { return fb_host_itoa(value, result, base); }
+inline char *ltoa(long value, char *result, int base) { return fb_host_itoa(value, result, base); }
+inline char *utoa(unsigned value, char *result, int base) { return fb_host_utoa(value, result, base); }
+inline char *ultoa(unsigned long value, char *result, int base) { return fb_host_utoa(value, result, base); }
+
+//the host keeps its own clock, the SNTP servers are not contacted
+inline void configTime(int timezone, int daylightOffset_sec, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr)
+{
+    (void)timezone;
+    (void)daylightOffset_sec;
+    (void)server1;
+    (void)server2;
+    (void)server3;
+}
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size--)
+            n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const String &s) { return write(s.c_str(), s.length()); }
+    size_t print(const char *s) { return write(s); }
+    size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned int n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(long n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned long n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(long long n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned long long n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(double n, int digits = 2) { return print(String(n, (unsigned char)digits)); }
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T &v) { return print(v) + println(); }
+    template <typename T>
+    size_t println(const T &v, int base) { return print(v, base) + println(); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char buf[256];
+        va_list arg;
+        va_start(arg, format);
+        int len = vsnprintf(buf, sizeof(buf), format, arg);
+        va_end(arg);
+        if (len < 0)
+            return 0;
+        if ((size_t)len < sizeof(buf))
+            return write((const uint8_t *)buf, len);
+        std::string s(len + 1, 0);
+        va_start(arg, format);
+        vsnprintf(&s[0], s.size(), format, arg);
+        va_end(arg);
+        return write((const uint8_t *)s.data(), len);
+    }
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+
+    virtual size_t readBytes(char *buffer, size_t length)
+    {
+        size_t n = 0;
+        unsigned long start = millis();
+        while (n < length && millis() - start < _timeout)
+        {
+            int c = read();
+            if (c < 0)
+            {
+                if (available() <= 0)
+                    break;
+                continue;
+            }
+            buffer[n++] = (char)c;
+        }
+        return n;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+
+    String readStringUntil(char terminator)
+    {
+        String r;
+        int c;
+        while ((c = read()) >= 0 && c != terminator)
+            r += (char)c;
+        return r;
+    }
+
+    String readString()
+    {
+        String r;
+        int c;
+        while ((c = read()) >= 0)
+            r += (char)c;
+        return r;
+    }
+
+protected:
+    unsigned long _timeout = 1000;
+};
+
+class IPAddress
+{
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t address) : addr(address) {}
+    operator uint32_t() const { return addr; }
+    uint8_t operator[](int index) const { return (addr >> (8 * index)) & 0xff; }
+    bool isSet() const { return addr != 0; }
+    bool fromString(const char *s)
+    {
+        unsigned a, b, c, d;
+        if (sscanf(s, "%u.%u.%u.%u", &a, &b, &c, &d) != 4)
+            return false;
+        *this = IPAddress(a, b, c, d);
+        return true;
+    }
+    String toString() const
+    {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+        return String(buf);
+    }
+
+private:
+    uint32_t addr = 0;
+};
+
+class Client : public Stream
+{
+public:
+    virtual int connect(IPAddress ip, uint16_t port) = 0;
+    virtual int connect(const char *host, uint16_t port) = 0;
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buf, size_t size) = 0;
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int read(uint8_t *buf, size_t size) = 0;
+    virtual int peek() = 0;
+    virtual void flush() = 0;
+    virtual void stop() = 0;
+    virtual uint8_t connected() = 0;
+    virtual operator bool() = 0;
+    using Print::write;
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+    size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass
+{
+public:
+    uint32_t getFreeHeap() { return freeHeap; }
+    uint32_t getMaxFreeBlockSize() { return freeHeap; }
+    uint32_t getFreeContStack() { return 4096; }
+    uint32_t getChipId() { return 0x00f1b0; }
+    uint32_t getFreeSketchSpace() { return 1024 * 1024; }
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    uint32_t getFlashChipRealSize() { return 4 * 1024 * 1024; }
+    uint32_t magicFlashChipSize(uint8_t byte) { return byte < 5 ? (512 * 1024) << byte : 0; }
+    uint32_t getCycleCount() { return (uint32_t)micros() * 80; }
+    void restart() {}
+    void reset() {}
+    void wdtFeed() {}
+
+    //the value that is reported as the free heap, set by the test
+    uint32_t freeHeap = 40000;
+};
+
+extern EspClass ESP;
+
+/** The entry of the host program, it is called by main (see Arduino.cpp).
+ *
+ * @note The library keeps the addresses in 32-bit integers as the device is 32-bit, the host runtime
+ * places the heap, the data and the stack of this function in the low 4 GB to keep them valid.
+*/
+int fb_host_main(int argc, char *argv[]);
+
+#endif
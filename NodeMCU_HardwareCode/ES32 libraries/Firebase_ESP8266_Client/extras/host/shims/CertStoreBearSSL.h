@@ -0,0 +1 @@
+#include <WiFiClientSecure.h>
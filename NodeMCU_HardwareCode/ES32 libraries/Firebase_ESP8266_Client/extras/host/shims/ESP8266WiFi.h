@@ -0,0 +1,61 @@
+/**
+ * The host (Linux) shim of the ESP8266WiFi library, the host network is always connected.
+ */
+
+#ifndef FB_HOST_ESP8266WIFI_H
+#define FB_HOST_ESP8266WIFI_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+
+typedef enum
+{
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_WRONG_PASSWORD = 6,
+    WL_DISCONNECTED = 7
+} wl_status_t;
+
+class ESP8266WiFiClass
+{
+public:
+    wl_status_t status() { return connected ? WL_CONNECTED : WL_DISCONNECTED; }
+    bool isConnected() { return connected; }
+    bool reconnect()
+    {
+        reconnects++;
+        return connected;
+    }
+    bool getAutoReconnect() { return autoReconnect; }
+    bool setAutoReconnect(bool autoReconnect)
+    {
+        this->autoReconnect = autoReconnect;
+        return true;
+    }
+    int hostByName(const char *host, IPAddress &result)
+    {
+        IPAddress ip;
+        if (ip.fromString(host) || strcmp(host, "localhost") == 0)
+        {
+            result = ip.isSet() ? ip : IPAddress(127, 0, 0, 1);
+            return 1;
+        }
+        return 0;
+    }
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    int32_t RSSI() { return -40; }
+
+    //the link state that is set by the test
+    bool connected = true;
+    bool autoReconnect = true;
+    int reconnects = 0;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
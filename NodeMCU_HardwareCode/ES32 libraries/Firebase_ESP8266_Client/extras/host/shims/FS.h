@@ -0,0 +1,187 @@
+/**
+ * The host (Linux) shim of the ESP8266 FS API, the files are kept in the host directory.
+ *
+ * SPIFFS and LittleFS map to <root>/flash and SD to <root>/sd where the root is set by
+ * fs::setHostRoot (default is the FB_HOST_FS environment variable or "fb_host_fs").
+ */
+
+#ifndef FB_HOST_FS_H
+#define FB_HOST_FS_H
+
+#include <Arduino.h>
+#include <memory>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define FILE_READ 0x01
+#define FILE_WRITE 0x13
+
+namespace fs
+{
+    enum SeekMode
+    {
+        SeekSet = 0,
+        SeekCur = 1,
+        SeekEnd = 2
+    };
+
+    inline std::string &hostRoot()
+    {
+        static std::string root = getenv("FB_HOST_FS") ? getenv("FB_HOST_FS") : "fb_host_fs";
+        return root;
+    }
+
+    inline void setHostRoot(const char *root) { hostRoot() = root; }
+
+    inline void makeDirs(const std::string &path)
+    {
+        for (size_t i = 1; i < path.length(); i++)
+        {
+            if (path[i] == '/')
+                mkdir(path.substr(0, i).c_str(), 0755);
+        }
+        mkdir(path.c_str(), 0755);
+    }
+
+    class File : public Stream
+    {
+    public:
+        File() {}
+        File(FILE *fp, const std::string &name) : fp(fp, [](FILE *f) { fclose(f); }), _name(name) {}
+
+        size_t write(uint8_t c) override { return write(&c, 1); }
+        size_t write(const uint8_t *buf, size_t size) override { return fp ? fwrite(buf, 1, size, fp.get()) : 0; }
+        using Print::write;
+
+        int available() override
+        {
+            if (!fp)
+                return 0;
+            long pos = ftell(fp.get());
+            return (int)(size() - pos);
+        }
+
+        int read() override
+        {
+            if (!fp)
+                return -1;
+            return fgetc(fp.get());
+        }
+
+        int read(uint8_t *buf, size_t size) { return fp ? (int)fread(buf, 1, size, fp.get()) : -1; }
+        size_t readBytes(char *buffer, size_t length) override { return fp ? fread(buffer, 1, length, fp.get()) : 0; }
+
+        int peek() override
+        {
+            if (!fp)
+                return -1;
+            int c = fgetc(fp.get());
+            if (c >= 0)
+                ungetc(c, fp.get());
+            return c;
+        }
+
+        void flush() override
+        {
+            if (fp)
+                fflush(fp.get());
+        }
+
+        bool seek(uint32_t pos, SeekMode mode = SeekSet) { return fp && fseek(fp.get(), pos, mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END) == 0; }
+        size_t position() const { return fp ? ftell(fp.get()) : 0; }
+
+        size_t size() const
+        {
+            if (!fp)
+                return 0;
+            fflush(fp.get());
+            struct stat st;
+            return fstat(fileno(fp.get()), &st) == 0 ? st.st_size : 0;
+        }
+
+        void close() { fp.reset(); }
+        const char *name() const { return _name.c_str(); }
+        bool isDirectory() const { return false; }
+        operator bool() const { return fp != nullptr; }
+
+    private:
+        std::shared_ptr<FILE> fp;
+        std::string _name;
+    };
+
+    class FS
+    {
+    public:
+        FS(const char *dir) : dir(dir) {}
+
+        bool begin()
+        {
+            makeDirs(path(""));
+            return true;
+        }
+
+        bool format() { return true; }
+        void end() {}
+
+        File open(const char *name, const char *mode)
+        {
+            std::string p = path(name);
+            if (mode[0] != 'r')
+                makeDirs(p.substr(0, p.rfind('/')));
+            std::string m = mode[0] == 'r' ? "rb" : mode[0] == 'w' ? "w+b" : "a+b";
+            FILE *fp = fopen(p.c_str(), m.c_str());
+            return fp ? File(fp, name) : File();
+        }
+
+        File open(const char *name, uint8_t mode) { return open(name, mode == FILE_READ ? "r" : "a"); }
+        File open(const String &name, const char *mode) { return open(name.c_str(), mode); }
+
+        bool exists(const char *name)
+        {
+            struct stat st;
+            return stat(path(name).c_str(), &st) == 0;
+        }
+
+        bool exists(const String &name) { return exists(name.c_str()); }
+        bool remove(const char *name) { return ::remove(path(name).c_str()) == 0; }
+        bool remove(const String &name) { return remove(name.c_str()); }
+        bool rename(const char *from, const char *to) { return ::rename(path(from).c_str(), path(to).c_str()) == 0; }
+
+        bool mkdir(const char *name)
+        {
+            makeDirs(path(name));
+            return true;
+        }
+
+        bool rmdir(const char *name) { return ::rmdir(path(name).c_str()) == 0; }
+
+    protected:
+        std::string dir;
+
+        std::string path(const char *name)
+        {
+            std::string p = hostRoot() + "/" + dir;
+            if (name && *name)
+            {
+                if (*name != '/')
+                    p += '/';
+                p += name;
+            }
+            return p;
+        }
+    };
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekMode;
+using fs::SeekSet;
+
+extern fs::FS SPIFFS;
+extern fs::FS LittleFS;
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * The host (Linux) shim of the ESP8266 SD and SDFS API, see FS.h.
+ */
+
+#ifndef FB_HOST_SD_H
+#define FB_HOST_SD_H
+
+#include <FS.h>
+
+#ifndef SD_CS_PIN
+#define SD_CS_PIN 15
+#endif
+
+class SDFSConfig
+{
+public:
+    SDFSConfig(uint8_t csPin = 4, uint32_t spi = 0) : csPin(csPin), spi(spi) {}
+    uint8_t csPin;
+    uint32_t spi;
+};
+
+class SDClass : public fs::FS
+{
+public:
+    SDClass() : fs::FS("sd") {}
+    bool begin(uint8_t csPin = SD_CS_PIN, uint32_t cfg = 0)
+    {
+        (void)csPin;
+        (void)cfg;
+        return fs::FS::begin();
+    }
+    using fs::FS::open;
+};
+
+class SDFSClass : public fs::FS
+{
+public:
+    SDFSClass() : fs::FS("sd") {}
+    bool setConfig(const SDFSConfig &) { return true; }
+};
+
+extern SDClass SD;
+extern SDFSClass SDFS;
+
+#endif
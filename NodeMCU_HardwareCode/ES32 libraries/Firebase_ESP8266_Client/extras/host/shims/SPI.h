@@ -0,0 +1,18 @@
+/**
+ * The host (Linux) shim of the SPI class.
+ */
+
+#ifndef FB_HOST_SPI_H
+#define FB_HOST_SPI_H
+
+class SPIClass
+{
+public:
+    void begin() {}
+    void begin(int8_t, int8_t, int8_t, int8_t) {}
+    void end() {}
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,32 @@
+/**
+ * The host (Linux) shim of the ESP8266 scheduled functions, they run when the test calls
+ * run_scheduled_functions (the core runs them after each loop).
+ */
+
+#ifndef FB_HOST_SCHEDULE_H
+#define FB_HOST_SCHEDULE_H
+
+#include <functional>
+#include <vector>
+
+inline std::vector<std::function<void(void)>> &fb_host_scheduled()
+{
+    static std::vector<std::function<void(void)>> fns;
+    return fns;
+}
+
+inline bool schedule_function(const std::function<void(void)> &fn)
+{
+    fb_host_scheduled().push_back(fn);
+    return true;
+}
+
+inline void run_scheduled_functions()
+{
+    std::vector<std::function<void(void)>> fns;
+    fns.swap(fb_host_scheduled());
+    for (auto &fn : fns)
+        fn();
+}
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * The host (Linux) shim of the SoftwareSerial class, it has no data.
+ */
+
+#ifndef FB_HOST_SOFTWARESERIAL_H
+#define FB_HOST_SOFTWARESERIAL_H
+
+#include <Arduino.h>
+
+class SoftwareSerial : public Stream
+{
+public:
+    SoftwareSerial(int8_t rxPin = -1, int8_t txPin = -1)
+    {
+        (void)rxPin;
+        (void)txPin;
+    }
+    void begin(uint32_t) {}
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override {}
+};
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * The host (Linux) shim of the ESP8266 Updater, the written image is kept in memory.
+ */
+
+#ifndef FB_HOST_UPDATER_H
+#define FB_HOST_UPDATER_H
+
+#include <Arduino.h>
+#include <vector>
+
+#define U_FLASH 0
+
+class UpdaterClass
+{
+public:
+    bool begin(size_t size, int command = U_FLASH, int ledPin = -1, uint8_t ledOn = LOW)
+    {
+        (void)command;
+        (void)ledPin;
+        (void)ledOn;
+        if (running || size == 0)
+            return false;
+        this->size = size;
+        image.clear();
+        running = true;
+        return true;
+    }
+
+    size_t write(uint8_t *data, size_t len)
+    {
+        if (!running || image.size() + len > size)
+            return 0;
+        image.insert(image.end(), data, data + len);
+        return len;
+    }
+
+    bool end(bool evenIfRemaining = false)
+    {
+        if (!running)
+            return false;
+        running = false;
+        if (!evenIfRemaining && image.size() != size)
+            return false;
+        completed = true;
+        return true;
+    }
+
+    void abort() { running = false; }
+    bool isRunning() { return running; }
+    bool hasError() { return false; }
+    uint8_t getError() { return 0; }
+
+    //the written image that is checked by the test
+    std::vector<uint8_t> image;
+    bool completed = false;
+
+private:
+    size_t size = 0;
+    bool running = false;
+};
+
+extern UpdaterClass Update;
+
+#endif
@@ -0,0 +1,180 @@
+/**
+ * The host (Linux) shim of the ESP8266 WiFiClient, a plain TCP client on the POSIX sockets.
+ */
+
+#ifndef FB_HOST_WIFICLIENT_H
+#define FB_HOST_WIFICLIENT_H
+
+#include <Arduino.h>
+#include <memory>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+class WiFiClient : public Client
+{
+public:
+    WiFiClient() {}
+    virtual ~WiFiClient() { closeSocket(); }
+
+    WiFiClient(const WiFiClient &) = delete;
+    WiFiClient &operator=(const WiFiClient &) = delete;
+
+    int connect(IPAddress ip, uint16_t port) override { return connect(ip.toString().c_str(), port); }
+
+    int connect(const char *host, uint16_t port) override
+    {
+        closeSocket();
+
+        struct addrinfo hints, *res = nullptr;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        char service[8];
+        snprintf(service, sizeof(service), "%u", port);
+
+        if (getaddrinfo(host, service, &hints, &res) != 0)
+            return 0;
+
+        for (struct addrinfo *ai = res; ai && fd < 0; ai = ai->ai_next)
+        {
+            fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0)
+                continue;
+            if (::connect(fd, ai->ai_addr, ai->ai_addrlen) != 0)
+                closeSocket();
+        }
+
+        freeaddrinfo(res);
+
+        if (fd < 0)
+            return 0;
+
+        int one = 1;
+        if (noDelay)
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        return 1;
+    }
+
+    size_t write(uint8_t b) override { return write(&b, 1); }
+
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        size_t sent = 0;
+        while (fd >= 0 && sent < size)
+        {
+            ssize_t n = ::send(fd, buf + sent, size - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                closeSocket();
+                break;
+            }
+            sent += n;
+        }
+        return sent;
+    }
+
+    using Print::write;
+
+    int available() override
+    {
+        if (fd < 0)
+            return 0;
+        int n = 0;
+        if (ioctl(fd, FIONREAD, &n) != 0)
+            return 0;
+        if (n == 0 && waitReadable(0))
+        {
+            //readable with nothing to read is the closed connection
+            char c;
+            if (recv(fd, &c, 1, MSG_PEEK) == 0)
+                peerClosed = true;
+        }
+        return n;
+    }
+
+    int read() override
+    {
+        uint8_t c;
+        return read(&c, 1) == 1 ? c : -1;
+    }
+
+    int read(uint8_t *buf, size_t size) override
+    {
+        if (fd < 0 || !waitReadable((int)_timeout))
+            return -1;
+        ssize_t n = recv(fd, buf, size, 0);
+        if (n == 0)
+            peerClosed = true;
+        return n > 0 ? (int)n : -1;
+    }
+
+    size_t readBytes(char *buffer, size_t length) override
+    {
+        int n = read((uint8_t *)buffer, length);
+        return n > 0 ? n : 0;
+    }
+
+    virtual size_t peekBytes(uint8_t *buffer, size_t length)
+    {
+        if (fd < 0 || !waitReadable((int)_timeout))
+            return 0;
+        ssize_t n = recv(fd, buffer, length, MSG_PEEK);
+        return n > 0 ? n : 0;
+    }
+
+    int peek() override
+    {
+        uint8_t c;
+        if (fd < 0 || recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) != 1)
+            return -1;
+        return c;
+    }
+
+    void flush() override {}
+
+    void stop() override { closeSocket(); }
+
+    uint8_t connected() override
+    {
+        if (fd < 0)
+            return 0;
+        return !peerClosed || available() > 0;
+    }
+
+    operator bool() override { return connected(); }
+
+    void setNoDelay(bool nodelay) { noDelay = nodelay; }
+    bool getNoDelay() const { return noDelay; }
+    void setSync(bool) {}
+    void keepAlive(uint16_t = 7200, uint16_t = 75, uint8_t = 9) {}
+    void disableKeepAlive() {}
+
+protected:
+    int fd = -1;
+    bool peerClosed = false;
+    bool noDelay = false;
+
+    bool waitReadable(int ms)
+    {
+        struct pollfd p = {fd, POLLIN, 0};
+        return poll(&p, 1, ms) > 0;
+    }
+
+    void closeSocket()
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+        peerClosed = false;
+    }
+};
+
+#endif
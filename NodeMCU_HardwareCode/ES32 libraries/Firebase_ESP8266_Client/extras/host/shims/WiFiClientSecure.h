@@ -0,0 +1,110 @@
+/**
+ * The host (Linux) shim of the ESP8266 BearSSL client classes.
+ *
+ * There is no TLS on the host, the secure client refuses to connect unless it was set to
+ * the plain mode by setInsecure (the local stand-in servers speak plain HTTP), the key and
+ * certificate classes only keep their arguments.
+ */
+
+#ifndef FB_HOST_WIFICLIENTSECURE_H
+#define FB_HOST_WIFICLIENTSECURE_H
+
+#include <WiFiClient.h>
+#include <bearssl/bearssl.h>
+
+namespace BearSSL
+{
+    class X509List
+    {
+    public:
+        X509List() {}
+        X509List(const char *pemCert) { (void)pemCert; }
+        X509List(const uint8_t *derCert, size_t derLen)
+        {
+            (void)derCert;
+            (void)derLen;
+        }
+        bool append(const char *pemCert)
+        {
+            (void)pemCert;
+            return true;
+        }
+    };
+
+    class PublicKey
+    {
+    public:
+        PublicKey() {}
+        PublicKey(const char *pemKey) : valid(pemKey && strstr(pemKey, "-----BEGIN PUBLIC KEY-----")) {}
+        bool isRSA() const { return valid; }
+        bool isEC() const { return false; }
+
+    private:
+        bool valid = false;
+    };
+
+    class PrivateKey
+    {
+    public:
+        PrivateKey() {}
+        PrivateKey(const char *pemKey) { (void)pemKey; }
+        PrivateKey(const uint8_t *derKey, size_t derLen)
+        {
+            (void)derKey;
+            (void)derLen;
+        }
+        bool parse(const char *pemKey) { return pemKey != nullptr; }
+        bool isRSA() const { return false; }
+        bool isEC() const { return false; }
+        const br_rsa_private_key *getRSA() const { return nullptr; }
+    };
+
+    class Session
+    {
+    };
+
+    class WiFiClientSecure : public WiFiClient
+    {
+    public:
+        int connect(IPAddress ip, uint16_t port) override { return connect(ip.toString().c_str(), port); }
+        int connect(const char *host, uint16_t port) override { return insecure && !knownKey && !trustAnchors ? WiFiClient::connect(host, port) : 0; }
+
+        void setInsecure()
+        {
+            insecure = true;
+            knownKey = nullptr;
+            trustAnchors = nullptr;
+        }
+        void setKnownKey(const PublicKey *pk, unsigned usages = 0)
+        {
+            (void)usages;
+            knownKey = pk;
+        }
+        void setTrustAnchors(const X509List *ta) { trustAnchors = ta; }
+        void setSession(Session *session) { this->session = session; }
+        void setBufferSizes(int recv, int xmit)
+        {
+            rxSize = recv;
+            txSize = xmit;
+        }
+        bool probeMaxFragmentLength(const char *, uint16_t, uint16_t) { return false; }
+        void setX509Time(time_t) {}
+        void setFingerprint(const uint8_t *) {}
+        void setClientRSACert(const X509List *, const PrivateKey *) {}
+
+        //the state of the client that is checked by the test
+        bool insecure = false;
+        const PublicKey *knownKey = nullptr;
+        const X509List *trustAnchors = nullptr;
+        Session *session = nullptr;
+        int rxSize = 16384;
+        int txSize = 512;
+    };
+
+    typedef WiFiClientSecure WiFiClientSecureCtx;
+
+} // namespace BearSSL
+
+using namespace BearSSL;
+
+#endif
@@ -0,0 +1,120 @@
+/**
+ * The host (Linux) shim of the ESP8266 WiFiUDP class on the POSIX sockets.
+ */
+
+#ifndef FB_HOST_WIFIUDP_H
+#define FB_HOST_WIFIUDP_H
+
+#include <Arduino.h>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+class WiFiUDP : public Stream
+{
+public:
+    ~WiFiUDP() { stop(); }
+
+    uint8_t begin(uint16_t port)
+    {
+        stop();
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0)
+            return 0;
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(port);
+        if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+        {
+            stop();
+            return 0;
+        }
+        return 1;
+    }
+
+    void stop()
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+
+    int beginPacket(IPAddress ip, uint16_t port)
+    {
+        out.clear();
+        memset(&dest, 0, sizeof(dest));
+        dest.sin_family = AF_INET;
+        dest.sin_port = htons(port);
+        return inet_pton(AF_INET, ip.toString().c_str(), &dest.sin_addr) == 1;
+    }
+
+    int endPacket()
+    {
+        if (fd < 0)
+            return 0;
+        return sendto(fd, out.data(), out.size(), 0, (struct sockaddr *)&dest, sizeof(dest)) == (ssize_t)out.size();
+    }
+
+    size_t write(uint8_t b) override { return write(&b, 1); }
+
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        out.insert(out.end(), buf, buf + size);
+        return size;
+    }
+
+    using Print::write;
+
+    int parsePacket()
+    {
+        in.clear();
+        inPos = 0;
+        if (fd < 0)
+            return 0;
+        uint8_t buf[1500];
+        socklen_t len = sizeof(from);
+        ssize_t n = recvfrom(fd, buf, sizeof(buf), MSG_DONTWAIT, (struct sockaddr *)&from, &len);
+        if (n <= 0)
+            return 0;
+        in.assign(buf, buf + n);
+        return (int)n;
+    }
+
+    int available() override { return (int)(in.size() - inPos); }
+    int read() override { return inPos < in.size() ? in[inPos++] : -1; }
+
+    int read(uint8_t *buf, size_t len)
+    {
+        size_t n = std::min(len, in.size() - inPos);
+        memcpy(buf, in.data() + inPos, n);
+        inPos += n;
+        return (int)n;
+    }
+
+    int read(char *buf, size_t len) { return read((uint8_t *)buf, len); }
+    int peek() override { return inPos < in.size() ? in[inPos] : -1; }
+    void flush() override {}
+
+    IPAddress remoteIP()
+    {
+        IPAddress ip;
+        ip.fromString(inet_ntoa(from.sin_addr));
+        return ip;
+    }
+
+    uint16_t remotePort() { return ntohs(from.sin_port); }
+
+private:
+    int fd = -1;
+    struct sockaddr_in dest = {};
+    struct sockaddr_in from = {};
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> in;
+    size_t inPos = 0;
+};
+
+#endif
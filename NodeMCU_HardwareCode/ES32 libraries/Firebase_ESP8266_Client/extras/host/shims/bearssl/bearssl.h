@@ -0,0 +1,51 @@
+/**
+ * The host (Linux) shim of the BearSSL API that is used by the token signer.
+ *
+ * The RSA signing of the service account JWT is not available on the host, the signer reports
+ * FIREBASE_ERROR_TOKEN_SIGN and the host tests use the legacy token or the test mode.
+ */
+
+#ifndef FB_HOST_BEARSSL_H
+#define FB_HOST_BEARSSL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define br_sha256_SIZE 32
+
+typedef struct
+{
+    size_t len;
+} br_sha256_context;
+
+typedef struct
+{
+    uint32_t n_bitlen;
+} br_rsa_private_key;
+
+static const unsigned char BR_HASH_OID_SHA256[] = {0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01};
+
+inline void br_sha256_init(br_sha256_context *ctx) { ctx->len = 0; }
+inline void br_sha256_update(br_sha256_context *ctx, const void *data, size_t len)
+{
+    (void)data;
+    ctx->len += len;
+}
+inline void br_sha256_out(const br_sha256_context *ctx, void *out)
+{
+    (void)ctx;
+    memset(out, 0, br_sha256_SIZE);
+}
+
+inline uint32_t br_rsa_i15_pkcs1_sign(const unsigned char *hash_oid, const unsigned char *hash, size_t hash_len, const br_rsa_private_key *sk, unsigned char *x)
+{
+    (void)hash_oid;
+    (void)hash;
+    (void)hash_len;
+    (void)sk;
+    (void)x;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,6 @@
+/**
+ * The host (Linux) shim of the ESP8266 core version, the API of core 3.0.2.
+ */
+#define ARDUINO_ESP8266_GIT_VER 0x4d9c9d4b
+#define ARDUINO_ESP8266_RELEASE_3_0_2
+#define ARDUINO_ESP8266_RELEASE "3_0_2"
@@ -0,0 +1 @@
+/* the host (Linux) build has no ESP8266 system API */
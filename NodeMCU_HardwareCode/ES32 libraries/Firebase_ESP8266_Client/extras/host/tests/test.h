@@ -0,0 +1,35 @@
+/**
+ * The minimal check macros of the host tests, the failed checks are printed and counted.
+ */
+
+#ifndef FB_HOST_TEST_H
+#define FB_HOST_TEST_H
+
+#include <Arduino.h>
+
+static int fb_test_failures = 0;
+
+#define CHECK(cond)                                                              \
+    do                                                                           \
+    {                                                                            \
+        if (!(cond))                                                             \
+        {                                                                        \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            fb_test_failures++;                                                  \
+        }                                                                        \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                                           \
+    do                                                                                                           \
+    {                                                                                                            \
+        long long _a = (long long)(a), _b = (long long)(b);                                                      \
+        if (_a != _b)                                                                                            \
+        {                                                                                                        \
+            fprintf(stderr, "%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+            fb_test_failures++;                                                                                  \
+        }                                                                                                        \
+    } while (0)
+
+#define TEST_RESULT() (fb_test_failures == 0 ? (printf("passed\n"), 0) : (printf("%d failed\n", fb_test_failures), 1))
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * The test of the attendance event codec and the event log upload queue.
+ */
+
+#include "test.h"
+#include <Firebase.h>
+#include <addons/Attendance/AttendanceCodec.h>
+#include <addons/Attendance/AttendanceAggregator.h>
+#include "wcs/replay/FB_Local_RTDB.h"
+
+static AttendanceCodec::record_t makeRecord(uint32_t time, uint8_t n)
+{
+    AttendanceCodec::record_t rec;
+    rec.time = time;
+    for (int i = 0; i < ATTENDANCE_UID_SIZE; i++)
+        rec.uid[i] = n + i * 16;
+    rec.device = n;
+    rec.status = n % 2;
+    return rec;
+}
+
+static void testRoundTrip()
+{
+    AttendanceEventBuffer buf;
+    for (uint8_t i = 0; i < 7; i++)
+        CHECK(buf.add(makeRecord(7200 + i, i)));
+
+    //the other bucket
+    CHECK(!buf.add(makeRecord(10800, 0)));
+
+    std::string b64;
+    buf.toBase64(b64);
+    CHECK_EQ(b64.length(), AttendanceCodec::encodedLength(7 * ATTENDANCE_RECORD_SIZE));
+
+    //the other strings of the events node are not decoded
+    std::string json = "{\"7200\":{\"-Nabcdefghijklmnopqr\":\"";
+    json += b64;
+    json += "\",\"name\":\"QUJDREVGR0hJSktM\"},\"-Nabcdefghijklmnopqs\":\"QUJD\"}";
+
+    int n = 0;
+    bool same = true;
+    size_t count = AttendanceCodec::decodeJson(json.c_str(), json.length(), [&](const AttendanceCodec::record_t &rec)
+                                               {
+                                                   AttendanceCodec::record_t src = makeRecord(7200 + n, n);
+                                                   same &= rec.time == src.time && memcmp(rec.uid, src.uid, ATTENDANCE_UID_SIZE) == 0 && rec.device == src.device && rec.status == src.status;
+                                                   n++;
+                                               });
+    CHECK_EQ(count, 7);
+    CHECK(same);
+
+    //the nibbles in decimal as the door unit sketch
+    char uid[17];
+    AttendanceCodec::uidString(makeRecord(0, 0x1a).uid, uid);
+    CHECK(strcmp(uid, "110210310410") == 0);
+}
+
+static void testEventLog()
+{
+    FB_Replay_Client replay;
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+
+    //the uploads fail until the transport is changed
+    fbdo.setTransport(&replay, true);
+    replay.addResponse("HTTP/1.1 500 Internal Server Error\r\nContent-Length: 2\r\n\r\n{}");
+    replay.setRepeat(true);
+
+    AttendanceEventLog log;
+    log.setBucket(3600, 2);
+    log.setQueueSize(1);
+
+    CHECK(log.log(fbdo, "/events", makeRecord(3600, 1)));
+    CHECK(log.log(fbdo, "/events", makeRecord(3601, 2)));
+    //the full buffer is queued
+    CHECK(log.log(fbdo, "/events", makeRecord(3602, 3)));
+    CHECK(log.log(fbdo, "/events", makeRecord(3603, 4)));
+    //the queue and the buffer are full, the new record is rejected without dropping the buffered records
+    CHECK(!log.log(fbdo, "/events", makeRecord(7200, 5)));
+    CHECK_EQ(log.lostCount(), 1);
+
+    fbdo.setTransport(&client, true);
+    CHECK(log.flush(fbdo, "/events"));
+    CHECK_EQ(log.size(), 0);
+
+    MB_String value;
+    db.get("/events/3600", value);
+
+    int n = 0;
+    size_t count = AttendanceCodec::decodeJson(value.c_str(), value.length(), [&](const AttendanceCodec::record_t &rec)
+                                               { n += rec.device; });
+    CHECK_EQ(count, 4);
+    CHECK_EQ(n, 1 + 2 + 3 + 4);
+}
+
+static uint32_t summaryValue(FB_Local_RTDB &db, const char *node, const char *name)
+{
+    MB_String value;
+    db.get(node, value);
+    FirebaseJson json;
+    FirebaseJsonData data;
+    json.setJsonData(value.c_str());
+    json.get(data, name);
+    return data.success ? data.to<uint32_t>() : 0xffffffff;
+}
+
+static void testAggregator()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+
+    //2024-10-06 is day 20002
+    const uint32_t day = 20002 * ATTENDANCE_SECONDS_PER_DAY;
+    {
+        AttendanceAggregator agg;
+        agg.addEvent("A", day - 400, 1);
+        CHECK(agg.update(fbdo, "/summary"));
+
+        //the next day's update prunes the day of the open session
+        agg.addEvent("B", day + 100, 1);
+        CHECK(agg.update(fbdo, "/summary"));
+
+        agg.addEvent("A", day + 600, 0);
+        agg.addEvent("C", day + ATTENDANCE_SECONDS_PER_DAY - 3600, 1);
+        CHECK(agg.update(fbdo, "/summary"));
+    }
+
+    //the split seconds are added to the stored day
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-05/A", "sec"), 400);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-05/A", "in"), 1);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-05/A", "open"), 0);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-06/A", "sec"), 600);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-06/A", "out"), 1);
+
+    {
+        //after restart, the session opened the day before is resumed
+        AttendanceAggregator agg;
+        CHECK(agg.load(fbdo, "/summary", day + ATTENDANCE_SECONDS_PER_DAY + 10));
+        agg.addEvent("C", day + ATTENDANCE_SECONDS_PER_DAY + 3600, 0);
+
+        //the late event of the day that was not loaded keeps the stored counters
+        agg.addEvent("A", day - 100, 0);
+        CHECK(agg.update(fbdo, "/summary"));
+    }
+
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-06/C", "sec"), 3600);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-06/C", "in"), 1);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-06/C", "open"), 0);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-07/C", "sec"), 3600);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-07/C", "out"), 1);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-05/A", "sec"), 400);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-05/A", "in"), 1);
+    CHECK_EQ(summaryValue(db, "/summary/2024-10-05/A", "out"), 1);
+}
+
+int fb_host_main(int argc, char *argv[])
+{
+    FirebaseConfig config;
+    FirebaseAuth auth;
+    config.database_url = "test.firebaseio.com";
+    config.signer.tokens.legacy_token = "secret";
+    Firebase.begin(&config, &auth);
+
+    testRoundTrip();
+    testEventLog();
+    testAggregator();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,140 @@
+/**
+ * The property test of the slicing-by-8 CRC-32 and its streaming context against the bitwise CRC.
+ */
+
+#include "test.h"
+#include <vector>
+#include "addons/fastcrc/FastCRC.h"
+
+static uint32_t rng = 1;
+
+static uint32_t next()
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+//the reflected CRC-32 (zlib) bit by bit
+static uint32_t refCRC32(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+//the non-reflected CRC-32/POSIX bit by bit, without the length that cksum(1) appends
+static uint32_t refCksum(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= (uint32_t)data[i] << 24;
+        for (int j = 0; j < 8; j++)
+            crc = (crc << 1) ^ (0x04c11db7 & (0 - (crc >> 31)));
+    }
+    return ~crc;
+}
+
+static void testCheckValues()
+{
+    FastCRC32 crc;
+    const uint8_t *s = (const uint8_t *)"123456789";
+    CHECK(crc.crc32(s, 9) == 0xcbf43926);
+    CHECK(crc.cksum(s, 9) == 0x765e7680);
+    CHECK(crc.crc32(s, 0) == 0);
+}
+
+static void testRandom()
+{
+    FastCRC32 crc;
+    std::vector<uint8_t> buf(4096 + 16);
+
+    //the lengths and the alignments around the 4 and 16 bytes steps of the slicing loop
+    for (int n = 0; n < 3000; n++)
+    {
+        size_t ofs = next() % 8;
+        size_t len = n < 100 ? n : next() % 4096;
+        for (size_t i = 0; i < len; i++)
+            buf[ofs + i] = next();
+
+        const uint8_t *p = buf.data() + ofs;
+        uint32_t expect = refCRC32(p, len);
+        CHECK(crc.crc32(p, len) == expect);
+        CHECK(crc.cksum(p, len) == refCksum(p, len));
+
+        //the random splits of the stream and the legacy seed update give the same result
+        FastCRC32_Context c32, ck;
+        crc.crc32_begin(c32);
+        crc.cksum_begin(ck);
+        size_t pos = 0, first = len > 0 ? next() % (len + 1) : 0;
+        uint32_t upd = crc.crc32(p, first);
+        if (first < len)
+            upd = crc.crc32_upd(p + first, len - first);
+        CHECK(upd == expect);
+
+        while (pos < len)
+        {
+            size_t part = 1 + next() % (len - pos < 300 ? len - pos : 300);
+            crc.update(c32, p + pos, part);
+            crc.update(ck, p + pos, part);
+            pos += part;
+        }
+
+        CHECK(crc.result(c32) == expect);
+        CHECK(crc.result(ck) == refCksum(p, len));
+        CHECK_EQ(c32.length, len);
+    }
+}
+
+static void testInterleaved()
+{
+    //the contexts do not share the state
+    FastCRC32 crc;
+    uint8_t a[1000], b[777];
+    for (size_t i = 0; i < sizeof(a); i++)
+        a[i] = next();
+    for (size_t i = 0; i < sizeof(b); i++)
+        b[i] = next();
+
+    FastCRC32_Context ca, cb;
+    crc.crc32_begin(ca);
+    crc.crc32_begin(cb);
+    for (size_t i = 0; i < sizeof(a); i += 100)
+    {
+        crc.update(ca, a + i, 100);
+        if (i < sizeof(b))
+            crc.update(cb, b + i, sizeof(b) - i < 100 ? sizeof(b) - i : 100);
+        //the large one shot call in between does not change them
+        crc.crc32(a, sizeof(a));
+    }
+
+    CHECK(crc.result(ca) == refCRC32(a, sizeof(a)));
+    CHECK(crc.result(cb) == refCRC32(b, sizeof(b)));
+}
+
+static void testLarge()
+{
+    //the length above 64 KB in one call
+    FastCRC32 crc;
+    std::vector<uint8_t> buf(200000);
+    for (size_t i = 0; i < buf.size(); i++)
+        buf[i] = next();
+    CHECK(crc.crc32(buf.data(), buf.size()) == refCRC32(buf.data(), buf.size()));
+}
+
+int fb_host_main(int argc, char *argv[])
+{
+    testCheckValues();
+    testRandom();
+    testInterleaved();
+    testLarge();
+
+    return TEST_RESULT();
+}
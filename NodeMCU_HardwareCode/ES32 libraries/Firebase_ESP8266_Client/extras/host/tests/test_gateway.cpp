@@ -0,0 +1,199 @@
+/**
+ * The test of the edge gateway batching and the reader authentication without the reader transport.
+ */
+
+#include "test.h"
+#include <Firebase.h>
+#include <addons/Gateway/EdgeGateway.h>
+
+static const uint8_t key[EDGE_GATEWAY_KEY_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+//send the start hello of the reader and get its session
+static uint32_t start(EdgeGatewayCore &gw, uint8_t device, uint16_t seq)
+{
+    EdgeGatewayCore::endpoint_t from;
+    std::vector<uint8_t> frame, reply;
+    EdgeGatewayCore::helloFrame(frame, device, seq);
+    EdgeGatewayCore::sign(frame, key, 0);
+
+    uint16_t ackSeq = 0;
+    uint8_t status = 0xff;
+    uint32_t session = 0;
+    CHECK(gw.handleFrame(frame.data(), frame.size(), from, 0, reply));
+    size_t len = reply.size();
+    CHECK(EdgeGatewayCore::verify(reply.data(), len, key, 0));
+    CHECK(EdgeGatewayCore::parseAck(reply.data(), len, ackSeq, status, &session));
+    CHECK(ackSeq == seq && status == EdgeGatewayCore::ack_ok && session != 0);
+    return session;
+}
+
+//send the signed frame and get the ack status
+static uint8_t send(EdgeGatewayCore &gw, std::vector<uint8_t> &frame, uint32_t session)
+{
+    EdgeGatewayCore::endpoint_t from;
+    std::vector<uint8_t> reply;
+    EdgeGatewayCore::sign(frame, key, session);
+    if (!gw.handleFrame(frame.data(), frame.size(), from, 0, reply))
+        return 0xff;
+
+    uint16_t seq;
+    uint8_t status = 0xff;
+    size_t len = reply.size();
+    if (!EdgeGatewayCore::verify(reply.data(), len, key, session) && !EdgeGatewayCore::verify(reply.data(), len, key, 0))
+        return 0xfe;
+    EdgeGatewayCore::parseAck(reply.data(), len, seq, status);
+    return status;
+}
+
+static void testPushKey()
+{
+    EdgeGatewayCore gw;
+    gw.setNodes("events", "users");
+    gw.setReaderKey(1, key);
+    uint32_t session = start(gw, 1, 0);
+
+    AttendanceCodec::record_t rec;
+    rec.time = 7200;
+    std::vector<uint8_t> frame;
+    EdgeGatewayCore::attendanceFrame(frame, 1, 1, &rec, 1);
+    CHECK(send(gw, frame, session) == EdgeGatewayCore::ack_ok);
+
+    //the batch is not written without the push key
+    std::string body;
+    CHECK(!gw.buildUpdate(body, []() { return std::string(); }));
+    CHECK(gw.ready(DEFAULT_EDGE_GATEWAY_INTERVAL));
+
+    CHECK(gw.buildUpdate(body, []() { return std::string("-Nabcdefghijklmnopqr"); }));
+    CHECK(body.find("\"events/7200/-Nabcdefghijklmnopqr\":\"") != std::string::npos);
+}
+
+static void testStates()
+{
+    EdgeGatewayCore gw;
+    gw.setNodes("events", "");
+    gw.setReaderKey(1, key);
+    uint32_t session = start(gw, 1, 0);
+    std::vector<uint8_t> frame;
+
+    //the nested name and the name of the events node are rejected
+    EdgeGatewayCore::stateFrame(frame, 1, 1, "12345678/in", "1");
+    CHECK(send(gw, frame, session) == EdgeGatewayCore::ack_invalid);
+
+    EdgeGatewayCore::stateFrame(frame, 1, 2, "events", "1");
+    CHECK(send(gw, frame, session) == EdgeGatewayCore::ack_invalid);
+
+    EdgeGatewayCore::stateFrame(frame, 1, 3, "12345678", "\"open\"");
+    CHECK(send(gw, frame, session) == EdgeGatewayCore::ack_ok);
+
+    AttendanceCodec::record_t rec;
+    rec.time = 7200;
+    EdgeGatewayCore::attendanceFrame(frame, 1, 4, &rec, 1);
+    CHECK(send(gw, frame, session) == EdgeGatewayCore::ack_ok);
+
+    //the records and the state values are sent with the separate updates
+    std::string body;
+    CHECK(gw.buildUpdate(body, []() { return std::string("-Nabcdefghijklmnopqr"); }));
+    CHECK(body.find("12345678") == std::string::npos);
+    gw.commit(true, 0);
+
+    CHECK(gw.buildStateUpdate(body));
+    CHECK(body == "{\"12345678\":\"open\"}");
+
+    //the failed state update is sent again
+    gw.commit(false, 0);
+    CHECK_EQ(gw.pendingRecordCount(), 0);
+    CHECK_EQ(gw.pendingStateCount(), 1);
+}
+
+static void testAuth()
+{
+    //the SipHash-2-4 test vector, the session is the first 4 bytes of the message
+    uint8_t k[EDGE_GATEWAY_KEY_SIZE], m[11];
+    for (int i = 0; i < EDGE_GATEWAY_KEY_SIZE; i++)
+        k[i] = i;
+    for (int i = 0; i < 11; i++)
+        m[i] = 4 + i;
+    CHECK(EdgeGatewayCore::tag(k, 0x03020100, m, sizeof(m)) == 0xa129ca6149be45e5ULL);
+
+    EdgeGatewayCore gw;
+    EdgeGatewayCore::endpoint_t from;
+    std::vector<uint8_t> frame, reply;
+
+    //the reader without the key is not served and not known
+    EdgeGatewayCore::helloFrame(frame, 2, 0);
+    EdgeGatewayCore::sign(frame, key, 0);
+    CHECK(!gw.handleFrame(frame.data(), frame.size(), from, 0, reply));
+    CHECK_EQ(gw.readerCount(), 0);
+    CHECK_EQ(gw.stats().unauthorized, 1);
+
+    //the wrong tag of the start hello gets no reply
+    gw.setReaderKey(2, key);
+    frame.back() ^= 1;
+    CHECK(!gw.handleFrame(frame.data(), frame.size(), from, 0, reply));
+    CHECK_EQ(gw.readerCount(), 0);
+
+    //the frame before the start hello gets the session ack
+    AttendanceCodec::record_t rec;
+    rec.time = 7200;
+    EdgeGatewayCore::attendanceFrame(frame, 2, 1, &rec, 1);
+    CHECK(send(gw, frame, 0) == EdgeGatewayCore::ack_session);
+    CHECK_EQ(gw.readerCount(), 0);
+
+    uint32_t session = start(gw, 2, 0);
+    CHECK_EQ(gw.readerCount(), 1);
+
+    std::vector<uint8_t> old;
+    EdgeGatewayCore::attendanceFrame(old, 2, 1, &rec, 1);
+    CHECK(send(gw, old, session) == EdgeGatewayCore::ack_ok);
+    CHECK_EQ(gw.pendingRecordCount(), 1);
+
+    //the forged frame with the other key
+    uint8_t other[EDGE_GATEWAY_KEY_SIZE] = {0};
+    rec.time = 7300;
+    EdgeGatewayCore::attendanceFrame(frame, 2, 2, &rec, 1);
+    EdgeGatewayCore::sign(frame, other, session);
+    CHECK(gw.handleFrame(frame.data(), frame.size(), from, 0, reply));
+    CHECK_EQ(gw.pendingRecordCount(), 1);
+
+    //the frame of the earlier session is not accepted after the new start hello
+    uint32_t session2 = start(gw, 2, 0);
+    CHECK(session2 != session);
+    CHECK(gw.handleFrame(old.data(), old.size(), from, 0, reply));
+    uint16_t seq;
+    uint8_t status = 0;
+    size_t len = reply.size();
+    CHECK(EdgeGatewayCore::verify(reply.data(), len, key, 0));
+    CHECK(EdgeGatewayCore::parseAck(reply.data(), len, seq, status) && status == EdgeGatewayCore::ack_session);
+    CHECK_EQ(gw.pendingRecordCount(), 1);
+
+    //the downlink is signed with the reader session
+    size_t count = 0;
+    gw.makeDownlink(EdgeGatewayCore::op_put, "12345678", "1", 1, [&](const uint8_t *data, size_t n)
+                    { gw.forEachReader([&](EdgeGatewayCore::reader_t &r)
+                                       { count += gw.signFrame(r, data, n, frame); }); });
+    CHECK_EQ(count, 1);
+    len = frame.size();
+    CHECK(!EdgeGatewayCore::verify(frame.data(), len, key, session));
+    CHECK(EdgeGatewayCore::verify(frame.data(), len, key, session2));
+
+    uint8_t op = 0xff;
+    std::string path, json;
+    CHECK(EdgeGatewayCore::parseDownlink(frame.data(), len, op, path, json, &seq));
+    CHECK(op == EdgeGatewayCore::op_put && path == "12345678" && json == "1" && seq == 0);
+
+    //the removed reader is not served
+    gw.setReaderKey(2, nullptr);
+    CHECK_EQ(gw.readerCount(), 0);
+    EdgeGatewayCore::helloFrame(frame, 2, 0);
+    EdgeGatewayCore::sign(frame, key, 0);
+    CHECK(!gw.handleFrame(frame.data(), frame.size(), from, 0, reply));
+}
+
+int fb_host_main(int argc, char *argv[])
+{
+    testPushKey();
+    testStates();
+    testAuth();
+
+    return TEST_RESULT();
+}
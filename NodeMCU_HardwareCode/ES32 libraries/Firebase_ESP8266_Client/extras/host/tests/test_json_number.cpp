@@ -0,0 +1,112 @@
+/**
+ * The differential test of the JSON number parser against the C library strtod.
+ */
+
+#include "test.h"
+#include <Firebase.h>
+#include "json/extras/parse/fb_json_strtod.h"
+
+static uint64_t seed = 0x9e3779b97f4a7c15ULL;
+static size_t fastCount = 0;
+
+static uint64_t next()
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+//the parser may decline the number, what it returns must match strtod bit for bit
+static void compare(const char *s)
+{
+    size_t len = strlen(s);
+    double value = 0;
+    int64_t ivalue = 0;
+    int isInt = 0;
+    size_t n = fb_json_strtod((const unsigned char *)s, len, &value, &ivalue, &isInt);
+    if (n == 0)
+        return;
+
+    fastCount++;
+    char *end = nullptr;
+    double ref = strtod(s, &end);
+    bool same = memcmp(&value, &ref, sizeof(double)) == 0 && n == (size_t)(end - s);
+    if (same && isInt)
+        same = strtoll(s, nullptr, 10) == ivalue && (double)ivalue == ref;
+
+    if (!same)
+    {
+        if (fb_test_failures < 10)
+            fprintf(stderr, "%s: %.17g (%d chars) != strtod %.17g (%d chars)\n", s, value, (int)n, ref, (int)(end - s));
+        fb_test_failures++;
+    }
+}
+
+static void testEdges()
+{
+    const char *edges[] = {"0", "-0", "1", "-1", "1.", "1.5", "-.5", "1e", "1e+", "1e-", "1E5", "1e22", "1e23", "9007199254740993",
+                           "9223372036854775807", "9223372036854775808", "-9223372036854775808", "12345678901234567890",
+                           "0.1", "0.30000000000000004", "1.7976931348623157e308", "2.2250738585072014e-308", "4.9e-324",
+                           "1e-400", "1e400", "00012", "3.14159,", "42}", "7]", "25.50 "};
+
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+        compare(edges[i]);
+
+    //the length limits the read of an unterminated number
+    double value = 0;
+    int64_t ivalue = 0;
+    int isInt = 0;
+    CHECK_EQ(fb_json_strtod((const unsigned char *)"12345", 3, &value, &ivalue, &isInt), 3);
+    CHECK(isInt && ivalue == 123);
+}
+
+static void testRandom(int count)
+{
+    char buf[64];
+    size_t start = fastCount;
+    for (int i = 0; i < count; i++)
+    {
+        uint64_t r = next();
+        switch (i % 5)
+        {
+        case 0:
+            //integers of any width
+            snprintf(buf, sizeof(buf), "%s%llu", r & 1 ? "-" : "", (unsigned long long)(r >> (r % 64)));
+            break;
+        case 1:
+            //sensor values with fixed decimals
+            snprintf(buf, sizeof(buf), "%.*f", (int)(r % 7), (double)(int64_t)(r >> 20) / 1e6);
+            break;
+        case 2:
+        {
+            //random bit patterns that are finite
+            double d;
+            memcpy(&d, &r, sizeof(d));
+            if (d != d || d - d != 0)
+                d = (double)r;
+            snprintf(buf, sizeof(buf), "%.17g", d);
+            break;
+        }
+        case 3:
+            //short digits with an exponent
+            snprintf(buf, sizeof(buf), "%de%d", (int)(r % 100000), (int)((r >> 32) % 64) - 32);
+            break;
+        default:
+            snprintf(buf, sizeof(buf), "%.*g", 1 + (int)(r % 17), (double)(r >> 11) * 1e-9);
+            break;
+        }
+        compare(buf);
+    }
+
+    //most telemetry numbers take the fast path
+    CHECK(fastCount - start > (size_t)count / 2);
+}
+
+int fb_host_main(int argc, char *argv[])
+{
+    testEdges();
+    testRandom(argc > 1 ? atoi(argv[1]) : 200000);
+
+    return TEST_RESULT();
+}
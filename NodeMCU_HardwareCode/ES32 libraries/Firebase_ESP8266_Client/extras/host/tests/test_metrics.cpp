@@ -0,0 +1,99 @@
+/**
+ * The test of the request metrics (ENABLE_FB_METRICS) over the replay transport.
+ */
+
+#include "test.h"
+#include <Firebase.h>
+#include "wcs/replay/FB_Replay_Client.h"
+
+static const char *response = "HTTP/1.1 200 OK\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: 2\r\n\r\n42";
+
+static void testPhases()
+{
+    FB_Replay_Client replay;
+    FirebaseData fbdo;
+    fbdo.setTransport(&replay, true);
+    fbdo.metrics().reset();
+
+    //the latency of the response is the wait phase
+    replay.addResponse(response);
+    replay.setLatency(30);
+    CHECK(Firebase.getInt(fbdo, "/a"));
+
+    FirebaseMetrics &m = fbdo.metrics();
+    CHECK_EQ(m.requests, 1);
+    CHECK_EQ(m.errors, 0);
+    CHECK_EQ(m.handshakes, 1);
+    CHECK(m.last_ms[fb_esp_metrics_phase_wait] >= 30);
+    CHECK(m.last_ms[fb_esp_metrics_phase_send] < 30);
+    CHECK(m.latency_ms >= m.last_ms[fb_esp_metrics_phase_wait]);
+
+    //the phases add up to the request time
+    uint32_t sum = 0;
+    for (int i = 0; i < fb_esp_metrics_phase_max; i++)
+        sum += m.last_ms[i];
+    CHECK(sum <= m.latency_ms + 1);
+
+    //the byte counts are the request that was written and the response payload
+    CHECK_EQ(m.bytes_out, replay.bytesWritten());
+    CHECK_EQ(m.bytes_in, 2);
+
+    //the kept connection is not counted as the new handshake
+    replay.setLatency(0);
+    replay.addResponse(response);
+    CHECK(Firebase.getInt(fbdo, "/a"));
+    CHECK_EQ(m.requests, 2);
+    CHECK_EQ(m.handshakes, 1);
+    CHECK(m.last_ms[fb_esp_metrics_phase_wait] < 30);
+    CHECK_EQ(m.bytes_out, replay.bytesWritten());
+    CHECK_EQ(m.bytes_in, 4);
+
+    //the failed request
+    replay.addResponse("HTTP/1.1 401 Unauthorized\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: 31\r\n\r\n{\"error\" : \"Permission denied\"}");
+    CHECK(!Firebase.setInt(fbdo, "/a", 1));
+    CHECK_EQ(m.requests, 3);
+    CHECK_EQ(m.errors, 1);
+    CHECK_EQ(m.bytes_out, replay.bytesWritten());
+}
+
+static void testPercentiles()
+{
+    FB_Replay_Client replay;
+    FirebaseData fbdo;
+    fbdo.setTransport(&replay, true);
+    replay.setRepeat(true);
+    replay.addResponse(response);
+
+    FirebaseMetrics &m = fbdo.metrics();
+    m.reset();
+    CHECK_EQ(m.percentile(50), 0);
+
+    //95 fast requests and 5 slow ones (40 ms, the bucket below 64 ms)
+    for (int i = 0; i < 100; i++)
+    {
+        replay.setLatency(i % 20 == 19 ? 40 : 0);
+        CHECK(Firebase.getInt(fbdo, "/a"));
+    }
+
+    CHECK_EQ(m.requests, 100);
+    CHECK_EQ(m.percentile(50), 8);
+    CHECK_EQ(m.percentile(90), 8);
+    CHECK_EQ(m.percentile(99), 64);
+    CHECK(m.latency_max_ms >= 40 && m.latency_max_ms < 64);
+    CHECK_EQ(m.hist[0] + m.hist[3], 100);
+    CHECK(m.total_ms[fb_esp_metrics_phase_wait] >= 5 * 40);
+}
+
+int fb_host_main(int argc, char *argv[])
+{
+    FirebaseConfig config;
+    FirebaseAuth auth;
+    config.database_url = "test.firebaseio.com";
+    config.signer.tokens.legacy_token = "secret";
+    Firebase.begin(&config, &auth);
+
+    testPhases();
+    testPercentiles();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,533 @@
+/**
+ * The test of the request engine over the replay transport and the local RTDB stand-in.
+ */
+
+#include "test.h"
+#include <Firebase.h>
+#include "wcs/replay/FB_Local_RTDB.h"
+
+static void begin(FirebaseConfig &config, FirebaseAuth &auth)
+{
+    config.database_url = "test.firebaseio.com";
+    config.signer.tokens.legacy_token = "secret";
+    Firebase.begin(&config, &auth);
+}
+
+static void testReplay()
+{
+    //the transport outlives the Firebase Data object that uses it
+    FB_Replay_Client replay;
+    FirebaseData fbdo;
+    fbdo.setTransport(&replay, true);
+
+    replay.addResponse("HTTP/1.1 200 OK\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: 2\r\n\r\n42");
+    CHECK(Firebase.getInt(fbdo, "/a/b"));
+    CHECK_EQ(fbdo.intData(), 42);
+    CHECK(strstr(replay.lastRequest(), "GET /a/b.json?auth=secret") != nullptr);
+
+    replay.addResponse("HTTP/1.1 200 OK\r\nContent-Type: application/json; charset=utf-8\r\nTransfer-Encoding: chunked\r\n\r\n5\r\n{\"x\":\r\n3\r\n12}\r\n0\r\n\r\n");
+    CHECK(Firebase.getJSON(fbdo, "/a"));
+    FirebaseJsonData data;
+    fbdo.jsonObject().get(data, "x");
+    CHECK(data.success && data.intValue == 12);
+
+    //the generated key of the failed push is kept for the retry
+    replay.addResponse("HTTP/1.1 503 Service Unavailable\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: 2\r\n\r\n{}");
+    Firebase.setLocalPushID(fbdo, true);
+    CHECK(!Firebase.pushInt(fbdo, "/a", 1));
+    CHECK_EQ(fbdo.pushName().length(), 20);
+    CHECK(strstr(replay.lastRequest(), (String("PUT /a/") + fbdo.pushName()).c_str()) != nullptr);
+    Firebase.setLocalPushID(fbdo, false);
+
+    replay.addResponse("HTTP/1.1 401 Unauthorized\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: 31\r\n\r\n{\"error\" : \"Permission denied\"}");
+    CHECK(!Firebase.setInt(fbdo, "/a/b", 1));
+    CHECK_EQ(fbdo.httpCode(), 401);
+
+    //the escape sequences of the error are decoded
+    replay.addResponse("HTTP/1.1 400 Bad Request\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: 45\r\n\r\n{\"error\":\"Invalid \\\"a\\\"\\n\\u00e9\\ud83d\\ude00\"}");
+    CHECK(!Firebase.setInt(fbdo, "/a/b", 1));
+    CHECK(fbdo.errorReason() == "Invalid \"a\"\n\xc3\xa9\xf0\x9f\x98\x80");
+}
+
+//the stream that makes its data available up to the limit, as the data arrives in the network packets
+class SplitStream : public Stream
+{
+public:
+    SplitStream(const char *data) : data(data) {}
+    size_t write(uint8_t) override { return 0; }
+    int available() override { return (int)(limit - pos); }
+    int read() override { return pos < limit ? (uint8_t)data[pos++] : -1; }
+    int peek() override { return pos < limit ? (uint8_t)data[pos] : -1; }
+    void release(size_t n) { limit = std::min(limit + n, data.length()); }
+
+private:
+    std::string data;
+    size_t pos = 0, limit = 0;
+};
+
+static void testChunkedSplit()
+{
+    SplitStream stream("5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n");
+    int state = 0, size = 0, len = 0;
+    char buf[16];
+    MB_String out;
+
+    //the read ends right after the size line, more data is pending
+    stream.release(3);
+    CHECK_EQ(MB_Chunked::read(&stream, buf, state, size, len, 8), 0);
+    stream.release(4);
+    CHECK_EQ(MB_Chunked::read(&stream, buf, state, size, len, 8), 4);
+    out += buf;
+
+    //the size line is split over the reads
+    stream.release(4);
+    CHECK_EQ(MB_Chunked::read(&stream, out, state, size, len), 1);
+    stream.release(1);
+    CHECK_EQ(MB_Chunked::read(&stream, out, state, size, len), 0);
+    stream.release(100);
+    CHECK_EQ(MB_Chunked::read(&stream, out, state, size, len), 6);
+    CHECK(out == "hello world");
+    CHECK_EQ(MB_Chunked::read(&stream, out, state, size, len), -1);
+}
+
+static void testTxBufferResize()
+{
+    FB_Replay_Client replay;
+    FirebaseData fbdo;
+    fbdo.setTransport(&replay, true);
+    replay.addResponse("HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\n\"ok\"");
+    replay.setRepeat(true);
+
+    fbdo.setBSSLBufferSize(512, 512);
+    CHECK(Firebase.setString(fbdo, "/a", "small"));
+
+    //the gather buffer was allocated with 512 bytes, the larger size applies to the next request
+    fbdo.setBSSLBufferSize(4096, 4096);
+    MB_String value;
+    for (int i = 0; i < 300; i++)
+        value += "abcdefgh";
+    CHECK(Firebase.setString(fbdo, "/a", value.c_str()));
+    CHECK(strstr(replay.lastRequest(), value.c_str()) != nullptr);
+}
+
+static void testLocal()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client c1(db), c2(db);
+    FirebaseData fbdo, stream;
+    fbdo.setTransport(&c1, true);
+    stream.setTransport(&c2, true);
+
+    CHECK(Firebase.setInt(fbdo, "/door/count", 5));
+    CHECK(Firebase.getInt(fbdo, "/door/count"));
+    CHECK_EQ(fbdo.intData(), 5);
+
+    CHECK(Firebase.beginStream(stream, "/door"));
+    CHECK(Firebase.readStream(stream));
+
+    FirebaseJson json;
+    json.set("count", 6);
+    json.set("state", "open");
+    CHECK(Firebase.updateNode(fbdo, "/door", json));
+
+    bool received = false;
+    for (int i = 0; i < 20 && !received; i++)
+    {
+        CHECK(Firebase.readStream(stream));
+        received = stream.streamAvailable();
+    }
+
+    CHECK(received);
+    CHECK(stream.eventType() == "patch");
+
+    MB_String value;
+    db.get("/door/state", value);
+    CHECK(value == "\"open\"");
+}
+
+static void testWriteCoalescing()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+
+    Firebase.RTDB.setWriteCoalescing(&fbdo, 60000);
+
+    //the keys are escaped in the multi-path update
+    size_t requests = db.requestCount();
+    CHECK(Firebase.setInt(fbdo, "/door/count", 5));
+    CHECK(Firebase.setInt(fbdo, "/door/count", 6));
+    CHECK(Firebase.setString(fbdo, "/door/a\"b", "open"));
+    CHECK(Firebase.setBool(fbdo, "/door/c\\d", true));
+    CHECK_EQ(db.requestCount(), requests);
+
+    //the cached value is read back without a request
+    CHECK(Firebase.getInt(fbdo, "/door/count"));
+    CHECK_EQ(fbdo.intData(), 6);
+    CHECK_EQ(db.requestCount(), requests);
+
+    CHECK(Firebase.RTDB.flushWrites(&fbdo));
+    CHECK_EQ(db.requestCount(), requests + 1);
+
+    MB_String value;
+    db.get("/door/count", value);
+    CHECK(value == "6");
+    db.get("/door/a\"b", value);
+    CHECK(value == "\"open\"");
+    db.get("/door/c\\d", value);
+    CHECK(value == "true");
+
+    //nothing left to send
+    CHECK(Firebase.RTDB.flushWrites(&fbdo));
+    CHECK_EQ(db.requestCount(), requests + 1);
+
+    Firebase.RTDB.setWriteCoalescing(&fbdo, 0);
+}
+
+static void readManifest(const char *name, FirebaseJson &json)
+{
+    File file = SPIFFS.open(name, "r");
+    String str;
+    while (file.available())
+        str += (char)file.read();
+    file.close();
+    json.setJsonData(str);
+}
+
+static void testBackupChunks()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+
+    FirebaseJson json;
+    const char *keys[] = {"2", "10", "a b\"c", "d", "e", "f", "g"};
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    {
+        MB_String path = "/";
+        path += keys[i];
+        json.set(path.c_str(), (int)i);
+    }
+    CHECK(Firebase.setJSON(fbdo, "/log", json));
+
+    //start the new backup instead of resuming the one left by the previous run
+    SPIFFS.remove("/backup/log.mft");
+
+    //7 keys in 3 chunks, the boundary key of the previous chunk is not counted again
+    CHECK(Firebase.backupChunks(fbdo, mem_storage_type_flash, "/log", "/backup/log", 3));
+
+    FirebaseJson manifest;
+    FirebaseJsonData data;
+    readManifest("/backup/log.mft", manifest);
+
+    manifest.get(data, "count");
+    CHECK_EQ(data.intValue, 3);
+    manifest.get(data, "status");
+    CHECK_EQ(data.intValue, 1);
+
+    //each chunk has its own record
+    readManifest("/backup/log.000.mft", manifest);
+    manifest.get(data, "start");
+    CHECK(data.stringValue == "2");
+    readManifest("/backup/log.001.mft", manifest);
+    manifest.get(data, "start");
+    CHECK(data.stringValue == "d");
+    readManifest("/backup/log.002.mft", manifest);
+    manifest.get(data, "end");
+    CHECK(data.stringValue == "g");
+    CHECK(!SPIFFS.exists("/backup/log.003"));
+
+    //the changed chunk is downloaded again when the backup is resumed
+    SPIFFS.remove("/backup/log.001.mft");
+    manifest.clear();
+    manifest.set("path", "/log");
+    manifest.set("count", 3);
+    manifest.set("status", 0);
+    File file = SPIFFS.open("/backup/log.mft", "w");
+    String str;
+    manifest.toString(str);
+    file.print(str);
+    file.close();
+    CHECK(Firebase.backupChunks(fbdo, mem_storage_type_flash, "/log", "/backup/log", 3));
+    readManifest("/backup/log.001.mft", manifest);
+    manifest.get(data, "end");
+    CHECK(data.stringValue == "f");
+
+    CHECK(Firebase.deleteNode(fbdo, "/log"));
+    CHECK(Firebase.restoreChunks(fbdo, mem_storage_type_flash, "/log", "/backup/log"));
+
+    MB_String value;
+    db.get("/log/a b\"c", value);
+    CHECK(value == "2");
+    db.get("/log/g", value);
+    CHECK(value == "6");
+}
+
+static void testAdaptiveBufferSize()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+    fbdo.setResponseSize(8192);
+    fbdo.setAdaptiveBufferSize(true);
+
+    FirebaseJson json;
+    for (int i = 0; i < 100; i++)
+    {
+        MB_String path = "/k";
+        path += 1000 + i;
+        json.set(path.c_str(), "0123456789012345678901234567890123456789");
+    }
+    CHECK(Firebase.setJSON(fbdo, "/adaptive", json));
+
+    //the grown buffer sizes wait for the next connection, the open connection is kept
+    for (int i = 0; i < 5; i++)
+    {
+        CHECK(Firebase.getJSON(fbdo, "/adaptive"));
+        CHECK(Firebase.getString(fbdo, "/adaptive/k1000"));
+    }
+    CHECK_EQ(client.connectCount(), 1);
+
+    fbdo.setAdaptiveBufferSize(false);
+}
+
+static void testKeyCursor()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+    fbdo.setAdaptiveBufferSize(false);
+
+    //the page of 50 children does not fit in the default response buffer
+    FirebaseJson json;
+    MB_String value;
+    for (int i = 0; i < 100; i++)
+        value += 'x';
+    for (int i = 0; i < 120; i++)
+    {
+        MB_String path = "/k";
+        path += 1000 + i;
+        json.set(path.c_str(), value.c_str());
+    }
+    CHECK(Firebase.setJSON(fbdo, "/users", json));
+
+    RTDB_KeyCursor cursor;
+    Firebase.beginKeyCursor(cursor, "/users");
+
+    String keys[50];
+    size_t total = 0;
+    bool ordered = true;
+    while (!cursor.done)
+    {
+        size_t n = Firebase.readKeys(fbdo, cursor, keys, 50);
+        CHECK(n > 0 || cursor.done);
+        for (size_t i = 0; i < n; i++)
+        {
+            MB_String key = "k";
+            key += 1000 + total + i;
+            ordered &= key == keys[i].c_str();
+        }
+        total += n;
+        if (n == 0 && !cursor.done)
+            break;
+    }
+
+    CHECK_EQ(total, 120);
+    CHECK(ordered);
+
+    //the keys are unescaped
+    FirebaseJson esc;
+    esc.add("a\"b", 1);
+    esc.add("c\\d", 2);
+    CHECK(Firebase.setJSON(fbdo, "/esc", esc));
+
+    Firebase.beginKeyCursor(cursor, "/esc");
+    CHECK_EQ(Firebase.readKeys(fbdo, cursor, keys, 50), 2);
+    CHECK(keys[0] == "a\"b" && keys[1] == "c\\d");
+}
+
+static void base64(const std::vector<uint8_t> &in, MB_String &out)
+{
+    static const char *table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (size_t i = 0; i < in.size(); i += 3)
+    {
+        uint32_t v = in[i] << 16 | (i + 1 < in.size() ? in[i + 1] << 8 : 0) | (i + 2 < in.size() ? in[i + 2] : 0);
+        for (size_t j = 0; j < 4; j++)
+            out += i + j <= in.size() ? table[(v >> (18 - 6 * j)) & 0x3f] : '=';
+    }
+}
+
+static void testBase64Upload(FirebaseConfig &config)
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+    //the blob is read back in one response
+    fbdo.setResponseSize(16384);
+
+    //the sizes around the base64 groups and the 1536 bytes file blocks, the small upload buffers
+    size_t sizes[] = {1, 2, 3, 4, 5, 191, 1535, 1536, 1537, 4609, 10001};
+    size_t buffers[] = {256, 301, 2048, 16384};
+    size_t saved = config.rtdb.upload_buffer_size;
+    uint32_t x = 7;
+
+    for (size_t b = 0; b < sizeof(buffers) / sizeof(buffers[0]); b++)
+    {
+        config.rtdb.upload_buffer_size = buffers[b];
+
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+        {
+            std::vector<uint8_t> data(sizes[s]);
+            for (size_t i = 0; i < data.size(); i++)
+            {
+                x = x * 1103515245 + 12345;
+                data[i] = x >> 24;
+            }
+
+            MB_String b64, value;
+            base64(data, b64);
+
+            CHECK(Firebase.setBlob(fbdo, "/blob", data.data(), data.size()));
+            db.get("/blob", value);
+            CHECK(value == MB_String("\"blob,base64,") + b64 + "\"");
+
+            CHECK(Firebase.getBlob(fbdo, "/blob"));
+            CHECK(*fbdo.blobData() == data);
+
+            //the signature of the file keeps the pad length
+            File file = SPIFFS.open("/upload.bin", "w");
+            file.write(data.data(), data.size());
+            file.close();
+
+            CHECK(Firebase.setFile(fbdo, mem_storage_type_flash, "/file", "/upload.bin"));
+            db.get("/file", value);
+            const char *sig = data.size() % 3 == 1 ? "\"fIle,base64," : data.size() % 3 == 2 ? "\"File,base64," : "\"file,base64,";
+            CHECK(value == MB_String(sig) + b64 + "\"");
+        }
+    }
+
+    config.rtdb.upload_buffer_size = saved;
+}
+
+//the connection that makes its data available in the small network packets
+class PacketClient : public FB_Local_RTDB_Client
+{
+public:
+    PacketClient(FB_Local_RTDB &db, int packet) : FB_Local_RTDB_Client(db), packet(packet) {}
+    int available() override
+    {
+        int n = FB_Local_RTDB_Client::available();
+        return n < packet ? n : packet;
+    }
+
+private:
+    int packet;
+};
+
+static void testChunkedDownload()
+{
+    FB_Local_RTDB db;
+    FB_Local_RTDB_Client client(db);
+    FirebaseData fbdo;
+    fbdo.setTransport(&client, true);
+    fbdo.setResponseSize(32768);
+
+    std::vector<uint8_t> data(10001);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = i * 31 + 7;
+
+    File file = SPIFFS.open("/upload.bin", "w");
+    file.write(data.data(), data.size());
+    file.close();
+    CHECK(Firebase.setFile(fbdo, mem_storage_type_flash, "/file", "/upload.bin"));
+
+    //the chunk sizes split the signature, the base64 groups and the size lines
+    size_t chunks[] = {0, 5000, 4096, 256, 7};
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++)
+    {
+        db.setChunkSize(chunks[c]);
+        CHECK(Firebase.getFile(fbdo, mem_storage_type_flash, "/file", "/download.bin"));
+
+        std::vector<uint8_t> out;
+        file = SPIFFS.open("/download.bin", "r");
+        while (file.available())
+            out.push_back(file.read());
+        file.close();
+        CHECK(out == data);
+    }
+}
+
+static uint32_t crc32(const std::vector<uint8_t> &data)
+{
+    uint32_t crc = 0xffffffff;
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static void testOTA()
+{
+    FB_Local_RTDB db;
+
+    //the images of all pad lengths that span the flash sectors, the packets split the base64 quads
+    size_t sizes[] = {7, OTA_WRITE_BUFFER_SIZE, OTA_WRITE_BUFFER_SIZE * 2 + 1000, OTA_WRITE_BUFFER_SIZE * 2 + 1001};
+    int packets[] = {1 << 20, 997, 1460};
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        std::vector<uint8_t> image(sizes[s]);
+        uint32_t x = 1 + s;
+        for (size_t i = 0; i < image.size(); i++)
+        {
+            x = x * 1103515245 + 12345;
+            image[i] = x >> 24;
+        }
+
+        for (size_t p = 0; p < sizeof(packets) / sizeof(packets[0]); p++)
+        {
+            PacketClient client(db, packets[p]);
+            FirebaseData fbdo;
+            fbdo.setTransport(&client, true);
+
+            CHECK(Firebase.setBlob(fbdo, "/fw", image.data(), image.size()));
+
+            Update.image.clear();
+            Update.completed = false;
+            CHECK(Firebase.downloadOTA(fbdo, "/fw"));
+            CHECK(Update.completed);
+            CHECK(Update.image == image);
+            CHECK_EQ(fbdo.otaWrittenBytes(), image.size());
+            CHECK(fbdo.otaCRC32() == crc32(image));
+        }
+    }
+}
+
+int fb_host_main(int argc, char *argv[])
+{
+    FirebaseConfig config;
+    FirebaseAuth auth;
+    begin(config, auth);
+
+    testReplay();
+    testChunkedSplit();
+    testTxBufferResize();
+    testLocal();
+    testWriteCoalescing();
+    testBackupChunks();
+    testAdaptiveBufferSize();
+    testKeyCursor();
+    testOTA();
+    testChunkedDownload();
+    testBase64Upload(config);
+
+    return TEST_RESULT();
+}
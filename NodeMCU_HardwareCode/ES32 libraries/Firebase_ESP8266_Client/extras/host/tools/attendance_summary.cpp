@@ -0,0 +1,105 @@
+/**
+ * The per user and per day attendance summary of the backup file of the attendence node.
+ *
+ * attendance_summary <backup file> [time offset]
+ * attendance_summary --bench [events]
+ *
+ * The summary JSON is written to stdout, it has the same layout as the summary node that
+ * AttendanceAggregator writes on the device. The benchmark builds the summary from the
+ * generated events (1000000 by default) with 200 users over a year.
+ */
+
+#include <addons/Attendance/AttendanceAggregator.h>
+#include <chrono>
+
+static bool readFile(const char *name, std::string &out)
+{
+    FILE *fp = fopen(name, "rb");
+    if (!fp)
+        return false;
+
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+        out.append(buf, n);
+
+    fclose(fp);
+    return true;
+}
+
+static void makeEvents(size_t count, std::string &json)
+{
+    const uint32_t users = 200;
+    //2023-01-01
+    const uint32_t start = 19358 * ATTENDANCE_SECONDS_PER_DAY;
+    char buf[128];
+    char date[12];
+
+    json.reserve(count * 80);
+    json += '{';
+    for (size_t i = 0; i < count; i++)
+    {
+        //each user checks in and out in turn, the pair is a few hours apart
+        uint32_t user = (i / 2) % users;
+        uint32_t pair = (uint32_t)(i / (2 * users));
+        uint32_t time = start + pair * 3 * 3600 + user * 7 + (i % 2) * (2 * 3600 + user);
+        AttendanceSummary::dayString(time / ATTENDANCE_SECONDS_PER_DAY, date);
+        uint32_t sec = time % ATTENDANCE_SECONDS_PER_DAY;
+        snprintf(buf, sizeof(buf), "%s\"-N%018zu\":{\"uid\":\"%08X\",\"time\":\"%sT%02u:%02u:%02u\",\"status\":%d}",
+                 i > 0 ? "," : "", i, 0x1000 + user, date, sec / 3600, sec / 60 % 60, sec % 60, (int)(i % 2 == 0));
+        json += buf;
+    }
+    json += '}';
+}
+
+static int bench(size_t count)
+{
+    std::string json;
+    makeEvents(count, json);
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    AttendanceSummary summary;
+    size_t added = summary.addEvents(json.c_str(), json.length());
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    std::string out;
+    summary.toJson(out);
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+    double add = std::chrono::duration<double>(t1 - t0).count();
+    double write = std::chrono::duration<double>(t2 - t1).count();
+    printf("events %zu (%.1f MB), summaries %zu (%.1f MB)\n", added, json.length() / 1e6, summary.dirtyCount(), out.length() / 1e6);
+    printf("add_events %10.3f s %10.1f ns/event\n", add, add * 1e9 / (added > 0 ? added : 1));
+    printf("to_json    %10.3f s\n", write);
+
+    return added == count ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <backup file> [time offset] | --bench [events]\n", argv[0]);
+        return 2;
+    }
+
+    if (strcmp(argv[1], "--bench") == 0)
+        return bench(argc > 2 ? strtoul(argv[2], nullptr, 10) : 1000000);
+
+    std::string json;
+    if (!readFile(argv[1], json))
+    {
+        fprintf(stderr, "%s: can't read %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    AttendanceSummary summary;
+    if (argc > 2)
+        summary.setTimeOffset(atoi(argv[2]));
+
+    summary.addEvents(json.c_str(), json.length());
+
+    std::string out;
+    summary.toJson(out);
+    printf("%s\n", out.c_str());
+    return 0;
+}
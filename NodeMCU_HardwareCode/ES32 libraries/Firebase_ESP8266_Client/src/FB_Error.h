@@ -27,6 +27,7 @@
 #define FIREBASE_ERROR_HTTP_CODE_NO_CONTENT 204
 #define FIREBASE_ERROR_HTTP_CODE_MOVED_PERMANENTLY 301
 #define FIREBASE_ERROR_HTTP_CODE_FOUND 302
+#define FIREBASE_ERROR_HTTP_CODE_NOT_MODIFIED 304
 #define FIREBASE_ERROR_HTTP_CODE_USE_PROXY 305
 #define FIREBASE_ERROR_HTTP_CODE_TEMPORARY_REDIRECT 307
 #define FIREBASE_ERROR_HTTP_CODE_PERMANENT_REDIRECT 308
@@ -90,5 +91,7 @@
 #define FIREBASE_ERROR_FW_UPDATE_BEGIN_FAILED/*          */ (FB_ERROR_RANGE - 32)
 #define FIREBASE_ERROR_FW_UPDATE_WRITE_FAILED/*          */ (FB_ERROR_RANGE - 33)
 #define FIREBASE_ERROR_FW_UPDATE_END_FAILED/*          */ (FB_ERROR_RANGE - 34)
+#define FIREBASE_ERROR_BACKUP_CHUNK_INVALID/*          */ (FB_ERROR_RANGE - 35)
+#define FIREBASE_ERROR_SYSTEM_TIME_NOT_SET/*          */ (FB_ERROR_RANGE - 36)
 
 #endif
\ No newline at end of file
@@ -0,0 +1,223 @@
+/**
+ * FirebaseMetrics
+ *
+ * The request metrics of the Firebase Data object, enabled by ENABLE_FB_METRICS in FirebaseFS.h.
+ * 
+ * Each request is timed in phases
+ * token   - waiting for the auth token to be ready (including its refresh)
+ * connect - the TCP connection and TLS handshake
+ * send    - sending the request header and payload (the connect time is not included)
+ * wait    - waiting for the first byte of the response
+ * receive - reading and parsing the response
+ * 
+ * The counters and the latency histogram are accumulated until reset.
+ * When ENABLE_FB_METRICS is not defined, this class is not compiled and nothing is recorded.
+ *
+ * The TLS handshakes are timed by the ESP8266 client (FB_TCP_Client), they are not counted
+ * with the external client (FB_ENABLE_EXTERNAL_CLIENT).
+ *
+ * This work is an extension of the Firebase ESP Client library by K. Suwatchai (Mobizt)
+ * Copyright (c) 2026 RFID Door Lock System contributors
+ *
+ * The MIT License (MIT)
+ */
+
+#ifndef FB_Metrics_H
+#define FB_Metrics_H
+
+#include <Arduino.h>
+#include "FirebaseFS.h"
+
+#if defined(ENABLE_FB_METRICS)
+
+//request latency buckets, the bucket i counts the requests that take less than 2^(i + 3) ms,
+//the last bucket counts the rest (8192 ms and longer)
+#define FB_METRICS_HIST_BUCKETS 11
+
+enum fb_esp_metrics_phase
+{
+    fb_esp_metrics_phase_token,
+    fb_esp_metrics_phase_connect,
+    fb_esp_metrics_phase_send,
+    fb_esp_metrics_phase_wait,
+    fb_esp_metrics_phase_receive,
+    fb_esp_metrics_phase_max
+};
+
+class FirebaseMetrics
+{
+public:
+    //requests and the failed requests
+    uint32_t requests = 0;
+    uint32_t errors = 0;
+    //TLS handshakes (new connections), failed handshakes and their total time
+    uint32_t handshakes = 0;
+    uint32_t handshake_errors = 0;
+    uint32_t handshake_ms = 0;
+    //network reconnections and the send retries
+    uint32_t reconnects = 0;
+    uint32_t retries = 0;
+    //request and response bytes
+    uint32_t bytes_out = 0;
+    uint32_t bytes_in = 0;
+    //the lowest free heap that was seen after the connection and at the end of request
+    uint32_t heap_min = 0xffffffff;
+    //the phase times of the last request and their totals
+    uint32_t last_ms[fb_esp_metrics_phase_max] = {0};
+    uint32_t total_ms[fb_esp_metrics_phase_max] = {0};
+    //the last request time and the request latency histogram
+    uint32_t latency_ms = 0;
+    uint32_t latency_max_ms = 0;
+    uint16_t hist[FB_METRICS_HIST_BUCKETS] = {0};
+
+    void reset()
+    {
+        FirebaseMetrics m;
+        *this = m;
+    }
+
+    /** Get the estimated latency of the percentile from the histogram.
+     * 
+     * @param percent The percentile e.g. 50, 90 or 99.
+     * @return The upper bound in ms of the bucket that holds the percentile, 0 when no request was timed.
+    */
+    uint32_t percentile(uint8_t percent)
+    {
+        uint32_t count = 0;
+        for (int i = 0; i < FB_METRICS_HIST_BUCKETS; i++)
+            count += hist[i];
+
+        if (count == 0)
+            return 0;
+
+        uint32_t target = (count * percent + 99) / 100;
+        uint32_t sum = 0;
+        for (int i = 0; i < FB_METRICS_HIST_BUCKETS - 1; i++)
+        {
+            sum += hist[i];
+            if (sum >= target)
+                return 1UL << (i + 3);
+        }
+        return latency_max_ms;
+    }
+
+    static const char *phaseName(int phase)
+    {
+        static const char *names[fb_esp_metrics_phase_max] = {"token", "connect", "send", "wait", "receive"};
+        return phase >= 0 && phase < fb_esp_metrics_phase_max ? names[phase] : "";
+    }
+
+    /** Print the metrics as text e.g. to Serial.
+     * 
+     * @param out The Print object.
+    */
+    void printTo(Print &out)
+    {
+        typedef unsigned long ul;
+        out.printf("requests %lu, errors %lu, handshakes %lu (%lu failed, %lu ms), reconnects %lu, retries %lu\n",
+                   (ul)requests, (ul)errors, (ul)handshakes, (ul)handshake_errors, (ul)handshake_ms, (ul)reconnects, (ul)retries);
+        out.printf("bytes out %lu, in %lu, heap min %lu\n", (ul)bytes_out, (ul)bytes_in, (ul)(heap_min == 0xffffffff ? 0 : heap_min));
+        out.printf("last %lu ms (", (ul)latency_ms);
+        for (int i = 0; i < fb_esp_metrics_phase_max; i++)
+            out.printf("%s%s %lu", i > 0 ? ", " : "", phaseName(i), (ul)last_ms[i]);
+        out.printf("), p50 %lu ms, p90 %lu ms, p99 %lu ms, max %lu ms\n", (ul)percentile(50), (ul)percentile(90), (ul)percentile(99), (ul)latency_max_ms);
+    }
+
+    void beginRequest()
+    {
+        reqStart = millis();
+        active = true;
+        current = -1;
+        nested = 0;
+        nestedStart = 0;
+        //the phases that were timed before the request took the session e.g. the token check
+        memcpy(last_ms, pending, sizeof(last_ms));
+        memset(pending, 0, sizeof(pending));
+    }
+
+    void endRequest(bool success, size_t txBytes, size_t rxBytes)
+    {
+        endPhase();
+        active = false;
+        latency_ms = millis() - reqStart;
+        if (latency_ms > latency_max_ms)
+            latency_max_ms = latency_ms;
+
+        int i = 0;
+        while (i < FB_METRICS_HIST_BUCKETS - 1 && latency_ms >= (1UL << (i + 3)))
+            i++;
+        if (hist[i] < 0xffff)
+            hist[i]++;
+
+        requests++;
+        if (!success)
+            errors++;
+        bytes_out += txBytes;
+        bytes_in += rxBytes;
+        sampleHeap();
+    }
+
+    //end the current phase and start the next one
+    void beginPhase(fb_esp_metrics_phase phase)
+    {
+        endPhase();
+        current = phase;
+        phaseStart = millis();
+        nestedStart = nested;
+    }
+
+    //add the time of the current phase without the nested phases that were added in between
+    void endPhase()
+    {
+        if (current < 0)
+            return;
+        addPhase((fb_esp_metrics_phase)current, millis() - phaseStart - (nested - nestedStart));
+        current = -1;
+    }
+
+    //add the phase that was timed inside the other phase
+    void addNestedPhase(fb_esp_metrics_phase phase, uint32_t ms)
+    {
+        nested += ms;
+        addPhase(phase, ms);
+    }
+
+    void addHandshake(uint32_t ms, bool success)
+    {
+        handshakes++;
+        if (!success)
+            handshake_errors++;
+        handshake_ms += ms;
+        addNestedPhase(fb_esp_metrics_phase_connect, ms);
+        sampleHeap();
+    }
+
+    void sampleHeap()
+    {
+        uint32_t heap = ESP.getFreeHeap();
+        if (heap < heap_min)
+            heap_min = heap;
+    }
+
+private:
+    unsigned long reqStart = 0;
+    unsigned long phaseStart = 0;
+    bool active = false;
+    int current = -1;
+    uint32_t pending[fb_esp_metrics_phase_max] = {0};
+    uint32_t nested = 0;
+    uint32_t nestedStart = 0;
+
+    void addPhase(fb_esp_metrics_phase phase, uint32_t ms)
+    {
+        if (active)
+            last_ms[phase] += ms;
+        else
+            pending[phase] += ms;
+        total_ms[phase] += ms;
+    }
+};
+
+#endif
+
+#endif
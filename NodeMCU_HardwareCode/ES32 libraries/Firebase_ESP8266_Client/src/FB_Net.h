@@ -14,6 +14,17 @@ typedef enum
 
 } fb_cert_type;
 
+typedef enum
+{
+    //TLS client that verifies the server certificate (or insecure when no certificate was set)
+    fb_transport_type_secure = 0,
+    //plain TCP client e.g. to the local gateway that terminates TLS
+    fb_transport_type_plain,
+    //TLS client that verifies the server public key only, with session resumption
+    fb_transport_type_pinned_key
+
+} fb_transport_type;
+
 #if defined(ESP32)
 #include <Arduino.h>
 #include <WiFiClient.h>
@@ -484,9 +484,6 @@ bool FIREBASE_CLASS::handleFCMRequest(FirebaseData &fbdo, fb_esp_fcm_msg_type me
     if (!fbdo.reconnect())
         return false;
 
-    if (!ut->waitIdle(fbdo._ss.http_code))
-        return false;
-
     FirebaseJsonData data;
 
     FirebaseJson *json = fbdo.to<FirebaseJson *>();
@@ -531,9 +528,16 @@ bool FIREBASE_CLASS::handleFCMRequest(FirebaseData &fbdo, fb_esp_fcm_msg_type me
     json->clear();
     arr->clear();
 
+    if (!ut->beginRequest(fbdo._ss.processing, fbdo._ss.http_code))
+        return false;
+
     fbdo.fcm.fcm_begin(fbdo);
 
-    return fbdo.fcm.fcm_send(fbdo, messageType);
+    bool ret = fbdo.fcm.fcm_send(fbdo, messageType);
+
+    ut->endRequest(fbdo._ss.processing);
+
+    return ret;
 }
 
 bool FIREBASE_CLASS::sendMessage(FirebaseData &fbdo, uint16_t index)
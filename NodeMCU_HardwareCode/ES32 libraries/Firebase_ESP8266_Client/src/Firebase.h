@@ -597,6 +597,16 @@ public:
     if (Signer.getCfg())
       Signer.getCfg()->_int.fb_multiple_requests = enable;
   }
+
+  /** Set the maximum number of requests at a time when multiple requests are allowed.
+   * 
+   * @param max - The number of requests (1 - 16), default is 4.
+  */
+  void setMaxConcurrentRequests(uint8_t max)
+  {
+    if (Signer.getCfg())
+      Signer.getCfg()->_int.fb_max_requests = max < 1 ? 1 : (max > MAX_CONCURRENT_REQUESTS ? MAX_CONCURRENT_REQUESTS : max);
+  }
 #endif
 
   /** Set the timeout of Firebase.get functions.
@@ -2011,6 +2021,73 @@ public:
   */
   bool readStream(FirebaseData &fbdo) { return RTDB.readStream(&fbdo); }
 
+  /** Set the callback function to get the results of async requests e.g. setIntAsync and pushJSONAsync.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param callback The callback function that accept RTDB_AsyncStatusInfo data.
+   * 
+   * @note The responses are read by processAsync which should be called inside the loop function.
+  */
+  void setAsyncCallback(FirebaseData &fbdo, RTDB_AsyncCallback callback) { RTDB.setAsyncCallback(&fbdo, callback); }
+
+  /** Read the arrived responses of async requests and send the results to the async callback.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param wait Optional. Wait for the responses of all pending async requests.
+   * @return Boolean type status indicates the success of the operation.
+  */
+  bool processAsync(FirebaseData &fbdo, bool wait = false) { return RTDB.processAsync(&fbdo, wait); }
+
+  /** Enable the write coalescing of the set functions for int, float, double, bool and string.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param interval The flush interval in ms, 0 to disable and send the cached writes.
+   * 
+   * @note The cached values are sent as one multi-path update, call flushWrites inside the loop function.
+  */
+  void setWriteCoalescing(FirebaseData &fbdo, uint32_t interval) { RTDB.setWriteCoalescing(&fbdo, interval); }
+
+  /** Send the cached writes as one multi-path update.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param force Optional. Send now or only when the flush interval was elapsed.
+   * @return Boolean type status indicates the success of the operation.
+  */
+  bool flushWrites(FirebaseData &fbdo, bool force = true) { return RTDB.flushWrites(&fbdo, force); }
+
+  /** Enable the read cache of get functions.
+   * 
+   * @param size The number of cached paths (up to 32), 0 to disable.
+   * 
+   * @note The cached value is revalidated with its ETag and used when the server responds with 304.
+  */
+  void setReadCache(size_t size) { RTDB.setReadCache(size); }
+
+  /** Enable the push keys that were generated by the device.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param enable The boolean value to enable or disable.
+   * 
+   * @note The push functions write to the new key with PUT that can be retried without duplicate.
+   * The key is available from fbdo.pushName() also when the push was failed.
+   * The device time should be set with setSystemTime.
+  */
+  void setLocalPushID(FirebaseData &fbdo, bool enable) { RTDB.setLocalPushID(&fbdo, enable); }
+
+  /** Generate the new push key.
+   * 
+   * @return The 20 characters key or empty string when the device time was not set.
+  */
+  String newPushID() { return RTDB.newPushID(); }
+
+  /** Generate the new push key or report the error when the key can't be generated.
+   * 
+   * @param fbdo Firebase Data Object to keep the error.
+   * @param key The String to keep the 20 characters key.
+   * @return Boolean type status indicates the key was generated, false when the device time was not set.
+  */
+  bool newPushID(FirebaseData &fbdo, String &key) { return RTDB.newPushID(&fbdo, key); }
+
   /** End the stream connection at a defined path. 
    * It can be restart again by calling beginStream.
    * 
@@ -2121,6 +2198,80 @@ public:
   template <typename T1 = const char *, typename T2 = const char *>
   bool restore(FirebaseData &fbdo, uint8_t storageType, T1 nodePath, T2 fileName, RTDB_UploadProgressCallback callback = NULL) { return RTDB.restore(&fbdo, getMemStorageType(storageType), nodePath, fileName, callback); }
 
+  /** Backup (download) database at the defined database path to the chunk files split by the child key ranges.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param storageType Type of storage to save file, StorageType::FLASH or StorageType::SD.
+   * @param nodePath Database path to be backuped.
+   * @param fileName The base file name (without extension) of the chunk files and manifest.
+   * @param keysPerChunk Optional. The number of child nodes to save in each chunk.
+   * @param callback Optional. The callback function that accept RTDB_DownloadStatusInfo data.
+   * @return Boolean type status indicates the success of the operation.
+   * 
+   * @note The chunks are saved as fileName.000, fileName.001, ... and the manifest as fileName.mft.
+   * Call again to resume the interrupted backup.
+  */
+  template <typename T1 = const char *, typename T2 = const char *>
+  bool backupChunks(FirebaseData &fbdo, uint8_t storageType, T1 nodePath, T2 fileName, size_t keysPerChunk = 100, RTDB_DownloadProgressCallback callback = NULL) { return RTDB.backupChunks(&fbdo, getMemStorageType(storageType), nodePath, fileName, keysPerChunk, callback); }
+
+  /** Restore database at a defined path using the chunk files saved by backupChunks.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param storageType Type of storage to read file, StorageType::FLASH or StorageType::SD.
+   * @param nodePath Database path to  be restored.
+   * @param fileName The base file name (without extension) of the chunk files and manifest.
+   * @param callback Optional. The callback function that accept RTDB_UploadStatusInfo data.
+   * @return Boolean type status indicates the success of the operation.
+   * 
+   * @note Call again to resume the interrupted restore.
+  */
+  template <typename T1 = const char *, typename T2 = const char *>
+  bool restoreChunks(FirebaseData &fbdo, uint8_t storageType, T1 nodePath, T2 fileName, RTDB_UploadProgressCallback callback = NULL) { return RTDB.restoreChunks(&fbdo, getMemStorageType(storageType), nodePath, fileName, callback); }
+
+  /** Begin the cursor to read the child keys of the node page by page.
+   * 
+   * @param cursor The RTDB_KeyCursor data to keep the read position.
+   * @param path Database path to the parent node.
+   * @param pageSize Optional. The number of keys to read in each page.
+   * 
+   * @note The page is read with the child values, the page will be made smaller when the child values 
+   * of the page do not fit in the response payload buffer (see FirebaseData::setResponseSize).
+  */
+  template <typename T = const char *>
+  void beginKeyCursor(RTDB_KeyCursor &cursor, T path, size_t pageSize = 50) { RTDB.beginKeyCursor(&cursor, path, pageSize); }
+
+  /** Read the next page of the child keys from the cursor.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param cursor The RTDB_KeyCursor data that was set with beginKeyCursor.
+   * @param callback The callback function that accept the key and its index, return false to stop reading.
+   * @return Boolean type status indicates the success of the operation.
+   * 
+   * @note cursor.done is true when all keys were read.
+  */
+  bool readKeys(FirebaseData &fbdo, RTDB_KeyCursor &cursor, RTDB_KeyCallback callback) { return RTDB.readKeys(&fbdo, &cursor, callback); }
+
+  /** Read the next page of the child keys from the cursor into the array.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param cursor The RTDB_KeyCursor data that was set with beginKeyCursor.
+   * @param keys The String array to keep the keys.
+   * @param size The size of array.
+   * @return The number of keys that were read.
+  */
+  size_t readKeys(FirebaseData &fbdo, RTDB_KeyCursor &cursor, String *keys, size_t size) { return RTDB.readKeys(&fbdo, &cursor, keys, size); }
+
+  /** Read all child keys of the node page by page.
+   * 
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param path Database path to the parent node.
+   * @param callback The callback function that accept the key and its index, return false to stop reading.
+   * @param pageSize Optional. The number of keys to read in each request.
+   * @return Boolean type status indicates the success of the operation.
+  */
+  template <typename T = const char *>
+  bool getKeys(FirebaseData &fbdo, T path, RTDB_KeyCallback callback, size_t pageSize = 50) { return RTDB.getKeys(&fbdo, path, callback, pageSize); }
+
   /** Set maximum Firebase read/store retry operation (0 255) in case of network problems and buffer overflow.
    * @param fbdo Firebase Data Object to hold data and instance.
    * @param num The maximum retry.
@@ -46,4 +46,7 @@
 // To enable OTA updates
 #define ENABLE_OTA_FIRMWARE_UPDATE
 
+// Uncomment to collect the request metrics (phase times, counters and latency histogram), see FirebaseData::metrics()
+// #define ENABLE_FB_METRICS
+
 #endif
\ No newline at end of file
@@ -677,7 +677,7 @@ public:
         ESP.setExternalHeap();
 #endif
 
-        bool nn = ((p = (void *)malloc(newLen)) > 0);
+        bool nn = ((p = (void *)malloc(newLen)) != nullptr);
 
 #if defined(ESP8266_USE_EXTERNAL_HEAP)
         ESP.resetHeap();
@@ -171,6 +171,32 @@ public:
         return -1;
     }
 
+    //the key that the database treats as 32-bit integer (no leading zero)
+    bool isIntKey(const char *key, int64_t &value)
+    {
+        const char *p = key;
+        bool neg = *p == '-';
+        if (neg)
+            p++;
+
+        size_t len = strlen(p);
+        if (len == 0 || len > 10 || (*p == '0' && (len > 1 || neg)))
+            return false;
+
+        value = 0;
+        for (; *p; p++)
+        {
+            if (*p < '0' || *p > '9')
+                return false;
+            value = value * 10 + (*p - '0');
+        }
+
+        if (neg)
+            value = -value;
+
+        return value >= INT32_MIN && value <= INT32_MAX;
+    }
+
     int rstrpos(const char *haystack, const char *needle, int offset /* start search from this offset to the left string */)
     {
         if (!haystack || !needle)
@@ -536,16 +562,18 @@ public:
         int idx = 0;
         if (!stream)
             return idx;
+
+        //append to the current string without searching its end for every byte
+        char *p = buf + strlen(buf);
+
         while (stream->available() && idx <= bufLen)
         {
-            if (!stream)
-                break;
             res = stream->read();
             if (res > -1)
             {
                 c = (char)res;
-                strcat_c(buf, c);
-                idx++;
+                p[idx++] = c;
+                p[idx] = 0;
                 if (c == '\n')
                     return idx;
             }
@@ -562,8 +590,6 @@ public:
             return idx;
         while (stream->available())
         {
-            if (!stream)
-                break;
             res = stream->read();
             if (res > -1)
             {
@@ -577,155 +603,15 @@ public:
         return idx;
     }
 
+    //the chunk data is copied by its length, see MB_Chunked
     int readChunkedData(WiFiClient *stream, char *out, int &chunkState, int &chunkedSize, int &dataLen, int bufLen)
     {
-
-        char *tmp = nullptr;
-        char *buf = nullptr;
-        int p1 = 0;
-        int olen = 0;
-
-        if (chunkState == 0)
-        {
-            chunkState = 1;
-            chunkedSize = -1;
-            dataLen = 0;
-            buf = (char *)newP(bufLen);
-            int readLen = readLine(stream, buf, bufLen);
-            if (readLen)
-            {
-                p1 = strpos(buf, pgm2Str(fb_esp_pgm_str_79), 0);
-                if (p1 == -1)
-                {
-                    p1 = strpos(buf, pgm2Str(fb_esp_pgm_str_21), 0);
-                }
-
-                if (p1 != -1)
-                {
-                    tmp = (char *)newP(p1 + 1);
-                    memcpy(tmp, buf, p1);
-                    chunkedSize = hex2int(tmp);
-                    delP(&tmp);
-                }
-
-                //last chunk
-                if (chunkedSize < 1)
-                    olen = -1;
-            }
-            else
-                chunkState = 0;
-
-            delP(&buf);
-        }
-        else
-        {
-
-            if (chunkedSize > -1)
-            {
-                buf = (char *)newP(bufLen);
-                int readLen = readLine(stream, buf, bufLen);
-
-                if (readLen > 0)
-                {
-                    //chunk may contain trailing
-                    if (dataLen + readLen - 2 < chunkedSize)
-                    {
-                        dataLen += readLen;
-                        memcpy(out, buf, readLen);
-                        olen = readLen;
-                    }
-                    else
-                    {
-                        if (chunkedSize - dataLen > 0)
-                            memcpy(out, buf, chunkedSize - dataLen);
-                        dataLen = chunkedSize;
-                        chunkState = 0;
-                        olen = readLen;
-                    }
-                }
-                else
-                {
-                    olen = -1;
-                }
-
-                delP(&buf);
-            }
-        }
-
-        return olen;
+        return MB_Chunked::read(stream, out, chunkState, chunkedSize, dataLen, bufLen);
     }
 
     int readChunkedData(WiFiClient *stream, MB_String &out, int &chunkState, int &chunkedSize, int &dataLen)
     {
-
-        char *tmp = nullptr;
-        int p1 = 0;
-        int olen = 0;
-
-        if (chunkState == 0)
-        {
-            chunkState = 1;
-            chunkedSize = -1;
-            dataLen = 0;
-            MB_String s;
-            int readLen = readLine(stream, s);
-            if (readLen)
-            {
-                p1 = strpos(s.c_str(), pgm2Str(fb_esp_pgm_str_79), 0);
-                if (p1 == -1)
-                {
-                    p1 = strpos(s.c_str(), pgm2Str(fb_esp_pgm_str_21), 0);
-                }
-
-                if (p1 != -1)
-                {
-                    tmp = (char *)newP(p1 + 1);
-                    memcpy(tmp, s.c_str(), p1);
-                    chunkedSize = hex2int(tmp);
-                    delP(&tmp);
-                }
-
-                //last chunk
-                if (chunkedSize < 1)
-                    olen = -1;
-            }
-            else
-                chunkState = 0;
-        }
-        else
-        {
-
-            if (chunkedSize > -1)
-            {
-                MB_String s;
-                int readLen = readLine(stream, s);
-
-                if (readLen > 0)
-                {
-                    //chunk may contain trailing
-                    if (dataLen + readLen - 2 < chunkedSize)
-                    {
-                        dataLen += readLen;
-                        out += s;
-                        olen = readLen;
-                    }
-                    else
-                    {
-                        if (chunkedSize - dataLen > 0)
-                            out += s;
-                        dataLen = chunkedSize;
-                        chunkState = 0;
-                        olen = readLen;
-                    }
-                }
-                else
-                {
-                    olen = -1;
-                }
-            }
-        }
-
-        return olen;
+        return MB_Chunked::read(stream, out, chunkState, chunkedSize, dataLen);
     }
 
     char *getHeader(const char *buf, PGM_P beginH, PGM_P endH, int &beginPos, int endPos)
@@ -856,131 +742,454 @@ public:
 
         if (response.dataType == 0)
         {
-            tmp = getHeader(buf, fb_esp_pgm_str_20, fb_esp_pgm_str_3, payloadPos, 0);
-            if (tmp)
+            //the keys were not scanned while receiving
+            if (!response.scanKeys)
+                findRespKeys(buf + payloadOfs, response);
+
+            switch (buf[payloadOfs])
             {
-                response.pushName = tmp;
-                delP(&tmp);
+            case '"':
+                if (strncasecmp_P(buf + payloadOfs, fb_esp_pgm_str_92, strlen_P(fb_esp_pgm_str_92)) == 0)
+                    setBase64DataType(response, fb_esp_data_type::d_blob, strlen_P(fb_esp_pgm_str_92), getOfs);
+                else if (strncasecmp_P(buf + payloadOfs, fb_esp_pgm_str_93, strlen_P(fb_esp_pgm_str_93)) == 0)
+                    setBase64DataType(response, fb_esp_data_type::d_file, strlen_P(fb_esp_pgm_str_93), getOfs);
+                else
+                    response.dataType = fb_esp_data_type::d_string;
+                break;
+            case '{':
+                response.dataType = fb_esp_data_type::d_json;
+                break;
+            case '[':
+                response.dataType = fb_esp_data_type::d_array;
+                break;
+            case 't':
+            case 'f':
+                response.dataType = fb_esp_data_type::d_boolean;
+                response.boolData = buf[payloadOfs] == 't';
+                break;
+            case 'n':
+                response.dataType = fb_esp_data_type::d_null;
+                break;
+            default:
+                setNumDataType(buf, payloadOfs, response, false);
+                break;
             }
+        }
+    }
 
-            tmp = getHeader(buf, fb_esp_pgm_str_102, fb_esp_pgm_str_3, payloadPos, 0);
-            if (tmp)
+    void setBase64DataType(struct server_response_data_t &response, fb_esp_data_type type, size_t prefixLen, bool getOfs)
+    {
+        response.dataType = type;
+        if ((response.isEvent && response.hasEventData) || getOfs)
+        {
+            if (response.eventData.length() > 0)
+                response.payloadLen = response.eventData.length() - prefixLen - 1;
+
+            response.payloadOfs += prefixLen;
+            response.eventData.clear();
+        }
+    }
+
+    //find the top-level error and name keys in the whole payload
+    void findRespKeys(const char *buf, struct server_response_data_t &response)
+    {
+        response.fbError.clear();
+        response.pushName.clear();
+        response.scanInStr = false;
+        response.scanEsc = 0;
+        response.scanCp = 0;
+        response.scanIsKey = false;
+        response.scanLast = 0;
+        response.scanDepth = 0;
+        response.scanTarget = 0;
+        response.scanCapture = 0;
+        response.scanKeyLen = 0;
+        scanRespKeys(buf, strlen(buf), response);
+    }
+
+    //classify the (non-stream) payload from its first significant byte,
+    //returns false when more data is needed, the scanned position is kept for the next call
+    bool classifyRespPayload(const char *buf, size_t len, struct server_response_data_t &response, bool getOfs, bool complete)
+    {
+        size_t i = response.scanOfs;
+
+        while (i < len && (buf[i] == ' ' || buf[i] == '\r' || buf[i] == '\n' || buf[i] == '\t'))
+            i++;
+
+        response.scanOfs = i;
+
+        if (i >= len)
+            return false;
+
+        switch (buf[i])
+        {
+        case '"':
+        {
+            size_t blobLen = strlen_P(fb_esp_pgm_str_92), avail = len - i;
+            bool blob = strncasecmp_P(buf + i, fb_esp_pgm_str_92, avail < blobLen ? avail : blobLen) == 0;
+            bool file = strncasecmp_P(buf + i, fb_esp_pgm_str_93, avail < blobLen ? avail : blobLen) == 0;
+
+            //partial prefix
+            if ((blob || file) && avail < blobLen && !complete)
+                return false;
+
+            if ((blob || file) && avail >= blobLen)
             {
-                delP(&tmp);
-                FirebaseJson js;
-                FirebaseJsonData d;
-                js.setJsonData(buf);
-                js.get(d, pgm2Str(fb_esp_pgm_str_176));
-                if (d.success)
-                    response.fbError = d.stringValue.c_str();
+                response.dataType = blob ? fb_esp_data_type::d_blob : fb_esp_data_type::d_file;
+                if (getOfs)
+                    response.payloadOfs = i + blobLen;
+            }
+            else
+                response.dataType = fb_esp_data_type::d_string;
+            break;
+        }
+        case '{':
+            response.dataType = fb_esp_data_type::d_json;
+            break;
+        case '[':
+            response.dataType = fb_esp_data_type::d_array;
+            break;
+        case 't':
+        case 'f':
+            response.dataType = fb_esp_data_type::d_boolean;
+            response.boolData = buf[i] == 't';
+            break;
+        case 'n':
+            response.dataType = fb_esp_data_type::d_null;
+            break;
+        default:
+        {
+            //the number should be ended before it can be parsed
+            size_t p = i;
+            while (p < len && ((buf[p] >= '0' && buf[p] <= '9') || buf[p] == '-' || buf[p] == '+' || buf[p] == '.' || buf[p] == 'e' || buf[p] == 'E'))
+                p++;
+
+            if (p == len && !complete)
+                return false;
+
+            setNumDataType(buf, i, response, false);
+            break;
+        }
+        }
+
+        return true;
+    }
+
+    //generate the push key (20 characters) of the time in ms, the key of the same or earlier millisecond
+    //is the previous key plus one to keep the order, lastMs and rand (12 bytes) are kept between the calls
+    //the key is written to buf (21 bytes) without the allocation, it can be called in the critical section
+    static void makePushID(char *buf, uint64_t ms, uint64_t &lastMs, uint8_t *rand)
+    {
+        if (ms <= lastMs)
+        {
+            ms = lastMs;
+            int i = 11;
+            for (; i >= 0 && rand[i] == 63; i--)
+                rand[i] = 0;
+            if (i >= 0)
+                rand[i]++;
+        }
+        else
+        {
+            for (int i = 0; i < 12; i++)
+                rand[i] = random(64);
+        }
+
+        lastMs = ms;
+
+        for (int i = 7; i >= 0; i--)
+        {
+            buf[i] = pgm_read_byte(fb_esp_pgm_str_607 + (ms % 64));
+            ms /= 64;
+        }
+
+        for (int i = 0; i < 12; i++)
+            buf[8 + i] = pgm_read_byte(fb_esp_pgm_str_607 + rand[i]);
+
+        buf[20] = 0;
+    }
+
+    //decode the JSON string escapes of the streamed string character, state and cp are kept between the calls
+    //returns the number of the decoded UTF-8 bytes (up to 4) written to out
+    int decodeJsonChar(char c, uint8_t &state, uint32_t &cp, char *out)
+    {
+        if (state == 0)
+        {
+            if (c == '\\')
+            {
+                state = 1;
+                return 0;
             }
+            //the high surrogate without the low surrogate is dropped
+            cp = 0;
+            out[0] = c;
+            return 1;
+        }
 
-            if (stringCompare(buf, payloadOfs, fb_esp_pgm_str_92, true))
+        if (state == 1)
+        {
+            state = 0;
+            switch (c)
             {
-                response.dataType = fb_esp_data_type::d_blob;
-                if ((response.isEvent && response.hasEventData) || getOfs)
+            case 'b':
+                out[0] = '\b';
+                break;
+            case 'f':
+                out[0] = '\f';
+                break;
+            case 'n':
+                out[0] = '\n';
+                break;
+            case 'r':
+                out[0] = '\r';
+                break;
+            case 't':
+                out[0] = '\t';
+                break;
+            case 'u':
+                state = 2;
+                cp &= 0xffff0000;
+                return 0;
+            default:
+                out[0] = c;
+                break;
+            }
+            cp = 0;
+            return 1;
+        }
+
+        int v = c >= '0' && c <= '9' ? c - '0' : (c >= 'a' && c <= 'f' ? c - 'a' + 10 : (c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1));
+        if (v < 0)
+        {
+            state = 0;
+            cp = 0;
+            out[0] = c;
+            return 1;
+        }
+
+        cp = (cp & 0xffff0000) | (((cp & 0xffff) << 4) | v);
+
+        if (++state < 6)
+            return 0;
+
+        state = 0;
+        uint32_t u = cp & 0xffff, hi = cp >> 16;
+
+        //wait for the low surrogate
+        if (u >= 0xd800 && u <= 0xdbff)
+        {
+            cp = u << 16;
+            return 0;
+        }
+
+        cp = 0;
+
+        if (u >= 0xdc00 && u <= 0xdfff)
+        {
+            if (hi == 0)
+                return 0;
+            u = 0x10000 + ((hi - 0xd800) << 10) + (u - 0xdc00);
+        }
+
+        if (u < 0x80)
+        {
+            out[0] = u;
+            return 1;
+        }
+        else if (u < 0x800)
+        {
+            out[0] = 0xc0 | (u >> 6);
+            out[1] = 0x80 | (u & 0x3f);
+            return 2;
+        }
+        else if (u < 0x10000)
+        {
+            out[0] = 0xe0 | (u >> 12);
+            out[1] = 0x80 | ((u >> 6) & 0x3f);
+            out[2] = 0x80 | (u & 0x3f);
+            return 3;
+        }
+
+        out[0] = 0xf0 | (u >> 18);
+        out[1] = 0x80 | ((u >> 12) & 0x3f);
+        out[2] = 0x80 | ((u >> 6) & 0x3f);
+        out[3] = 0x80 | (u & 0x3f);
+        return 4;
+    }
+
+    //scan the new payload data for the top-level error and name (push) keys
+    void scanRespKeys(const char *buf, size_t len, struct server_response_data_t &response)
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            char c = buf[i];
+
+            if (response.scanInStr)
+            {
+                if (response.scanEsc == 0 && c == '"')
                 {
-                    if (response.eventData.length() > 0)
+                    response.scanInStr = false;
+                    if (response.scanIsKey)
                     {
-                        int dlen = response.eventData.length() - strlen_P(fb_esp_pgm_str_92) - 1;
-                        response.payloadLen = dlen;
+                        response.scanKey[response.scanKeyLen < sizeof(response.scanKey) ? response.scanKeyLen : 0] = 0;
+                        if (response.scanKeyLen < sizeof(response.scanKey) && strcmp_P(response.scanKey, fb_esp_pgm_str_176) == 0)
+                            response.scanTarget = 1;
+                        else if (response.scanKeyLen < sizeof(response.scanKey) && strcmp_P(response.scanKey, fb_esp_pgm_str_605) == 0)
+                            response.scanTarget = 2;
+                        else
+                            response.scanTarget = 0;
                     }
-                    response.payloadOfs += strlen_P(fb_esp_pgm_str_92);
-                    response.eventData.clear();
+                    response.scanCapture = 0;
+                    continue;
                 }
-            }
-            else if (stringCompare(buf, payloadOfs, fb_esp_pgm_str_93, true))
-            {
-                response.dataType = fb_esp_data_type::d_file;
-                if ((response.isEvent && response.hasEventData) || getOfs)
+
+                //the escape sequences are decoded to the UTF-8 bytes
+                char out[4];
+                int n = decodeJsonChar(c, response.scanEsc, response.scanCp, out);
+
+                if (response.scanIsKey)
                 {
-                    if (response.eventData.length() > 0)
+                    for (int j = 0; j < n; j++)
                     {
-                        int dlen = response.eventData.length() - strlen_P(fb_esp_pgm_str_93) - 1;
-                        response.payloadLen = dlen;
+                        if (response.scanKeyLen < sizeof(response.scanKey) - 1)
+                            response.scanKey[response.scanKeyLen++] = out[j];
+                        else
+                            response.scanKeyLen = sizeof(response.scanKey);
                     }
-
-                    response.payloadOfs += strlen_P(fb_esp_pgm_str_93);
-                    response.eventData.clear();
                 }
+                else if (response.scanCapture == 1)
+                    response.fbError.appendN(out, n);
+                else if (response.scanCapture == 2)
+                    response.pushName.appendN(out, n);
+
+                continue;
             }
-            else if (stringCompare(buf, payloadOfs, fb_esp_pgm_str_3))
-            {
-                response.dataType = fb_esp_data_type::d_string;
-            }
-            else if (stringCompare(buf, payloadOfs, fb_esp_pgm_str_163))
-            {
-                response.dataType = fb_esp_data_type::d_json;
-            }
-            else if (stringCompare(buf, payloadOfs, fb_esp_pgm_str_182))
-            {
-                response.dataType = fb_esp_data_type::d_array;
-            }
-            else if (stringCompare(buf, payloadOfs, fb_esp_pgm_str_106) || stringCompare(buf, payloadOfs, fb_esp_pgm_str_107))
-            {
-                response.dataType = fb_esp_data_type::d_boolean;
-                response.boolData = stringCompare(buf, payloadOfs, fb_esp_pgm_str_107);
-            }
-            else if (stringCompare(buf, payloadOfs, fb_esp_pgm_str_19))
-            {
-                response.dataType = fb_esp_data_type::d_null;
-            }
-            else
+
+            switch (c)
             {
-                int p1 = strpos(buf, pgm2Str(fb_esp_pgm_str_4), payloadOfs);
-                setNumDataType(buf, payloadOfs, response, p1 != -1);
+            case '{':
+            case '[':
+                response.scanDepth++;
+                response.scanLast = c;
+                break;
+            case '}':
+            case ']':
+                response.scanDepth--;
+                response.scanLast = c;
+                break;
+            case ',':
+                response.scanTarget = 0;
+                response.scanLast = c;
+                break;
+            case ':':
+                response.scanLast = c;
+                break;
+            case '"':
+                response.scanInStr = true;
+                response.scanEsc = 0;
+                response.scanCp = 0;
+                response.scanIsKey = response.scanDepth == 1 && (response.scanLast == '{' || response.scanLast == ',');
+                response.scanKeyLen = 0;
+                response.scanCapture = !response.scanIsKey && response.scanDepth == 1 && response.scanLast == ':' ? response.scanTarget : 0;
+                break;
+            default:
+                break;
             }
         }
     }
 
+    //append the received data to the payload of known length and scan the new data only
+    void appendRespPayload(MB_String &payload, size_t &payloadLen, const char *data, size_t len, struct server_response_data_t &response)
+    {
+        payload.appendN(data, len, payloadLen);
+        payloadLen += len;
+
+        if (response.scanKeys)
+            scanRespKeys(data, len, response);
+    }
+
+    //parse the number token at ofs in place, dec forces the floating point type
     void setNumDataType(const char *buf, int ofs, struct server_response_data_t &response, bool dec)
     {
 
         if (!buf || ofs < 0)
             return;
 
-        if (ofs >= (int)strlen(buf))
+        const char *s = buf + ofs;
+        const char *p = s;
+        bool neg = *p == '-';
+        bool exp = false;
+
+        if (neg || *p == '+')
+            p++;
+
+        //integer fast path, at most 18 digits can not overflow
+        int64_t v = 0;
+        int digits = 0;
+        while (*p >= '0' && *p <= '9')
+        {
+            if (digits < 18)
+                v = v * 10 + (*p - '0');
+            digits++;
+            p++;
+        }
+
+        if (*p == '.')
+            dec = true;
+
+        if (*p == 'e' || *p == 'E')
+            exp = true;
+
+        if (digits == 0 && !dec)
             return;
 
-        if (response.payloadLen > 0 && response.payloadLen <= (int)strlen(buf) && ofs < (int)strlen(buf) && ofs + response.payloadLen <= (int)strlen(buf))
+        if (!dec && !exp && digits <= 18)
         {
-            char *tmp = (char *)newP(response.payloadLen + 1);
+            if (neg)
+                v = -v;
 
-            if (!tmp)
-                return;
+            if (v > 0x7fffffff || v < -0x7fffffff - 1)
+            {
+                response.doubleData = (double)v;
+                response.dataType = fb_esp_data_type::d_double;
+            }
+            else
+            {
+                response.intData = (int)v;
+                response.dataType = fb_esp_data_type::d_integer;
+            }
+            return;
+        }
 
-            memcpy(tmp, &buf[ofs], response.payloadLen);
-            tmp[response.payloadLen] = 0;
-            double d = atof(tmp);
-            delP(&tmp);
+        //strtod stops at the end of number token, no copy is needed
+        char *end = nullptr;
+        double d = strtod(s, &end);
+        if (end == s)
+            return;
 
-            if (dec)
+        if (dec)
+        {
+            if (end - s <= 7)
             {
-                if (response.payloadLen <= 7)
-                {
-                    response.floatData = d;
-                    response.dataType = fb_esp_data_type::d_float;
-                }
-                else
-                {
-                    response.doubleData = d;
-                    response.dataType = fb_esp_data_type::d_double;
-                }
+                response.floatData = d;
+                response.dataType = fb_esp_data_type::d_float;
             }
             else
             {
-                if (d > 0x7fffffff)
-                {
-                    response.doubleData = d;
-                    response.dataType = fb_esp_data_type::d_double;
-                }
-                else
-                {
-                    response.intData = (int)d;
-                    response.dataType = fb_esp_data_type::d_integer;
-                }
+                response.doubleData = d;
+                response.dataType = fb_esp_data_type::d_double;
             }
         }
+        else if (d > 0x7fffffff || d < -2147483648.0)
+        {
+            response.doubleData = d;
+            response.dataType = fb_esp_data_type::d_double;
+        }
+        else
+        {
+            response.intData = (int)d;
+            response.dataType = fb_esp_data_type::d_integer;
+        }
     }
 
     void createDirs(MB_String dirs, fb_esp_mem_storage_type storageType)
@@ -1174,6 +1383,37 @@ public:
         return false;
     }
 
+    //decode the base64 data that can end inside a quad, the rest of the quad is kept in tail and decoded with the next data
+    bool decodeBase64Stream(MB_String &tail, const char *src, size_t len, fb_esp_mem_storage_type type)
+    {
+        tail.appendN(src, len);
+
+        const char *buf = tail.c_str();
+        size_t size = tail.length(), count = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            if (isBase64Char(buf[i]))
+                count++;
+        }
+
+        size_t rest = count % 4, end = size;
+        while (rest > 0 && end > 0)
+        {
+            end--;
+            if (isBase64Char(buf[end]))
+                rest--;
+        }
+
+        bool ret = end == 0 || decodeBase64Stream(buf, end, type);
+        tail.erase(0, end);
+        return ret;
+    }
+
+    bool isBase64Char(char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '+' || c == '/' || c == '=';
+    }
+
     //trim double quotes and return pad length
     int trimLastChunkBase64(MB_String &s, int len)
     {
@@ -1214,122 +1454,140 @@ public:
 #endif
     }
 
-    bool addBuffer(uint8_t *buf, uint8_t value, int &index, int chunkSize, int &code)
+#if defined(OTA_UPDATE_ENABLED)
+    int base64Value(uint8_t c)
+    {
+        if (c >= 'A' && c <= 'Z')
+            return c - 'A';
+        if (c >= 'a' && c <= 'z')
+            return c - 'a' + 26;
+        if (c >= '0' && c <= '9')
+            return c - '0' + 52;
+        if (c == '+')
+            return 62;
+        if (c == '/')
+            return 63;
+        return -1;
+    }
+
+    //start decoding the base64 image of the given decoded size (pad bytes included)
+    bool beginOTA(struct fb_esp_ota_info_t &ota, size_t size, int &code)
     {
-        if (index < chunkSize)
-        {
-            buf[index] = value;
-            index++;
-        }
-        else
+        clearOTA(ota);
+
+        //the extra bytes hold the tail of the last quad that crosses the sector end
+        ota.buf = (uint8_t *)newP(OTA_WRITE_BUFFER_SIZE + 3);
+        if (!ota.buf)
         {
-            index = 0;
-            if (!writeOTA(buf, chunkSize, code))
-                return false;
-            memset(buf, 0, chunkSize);
-            buf[index] = value;
-            index++;
+            code = FIREBASE_ERROR_FW_UPDATE_BEGIN_FAILED;
+            return false;
         }
 
+        ota.pad_len = 0;
+        ota.size = size;
+        ota.committed = 0;
+        FastCRC32 crc32;
+        crc32.crc32_begin(ota.crc);
         return true;
     }
 
-    bool decodeBase64OTA(const char *src, size_t len, int &code)
+    //write the buffered sector to flash and keep the bytes that belong to the next one
+    bool commitOTA(struct fb_esp_ota_info_t &ota, size_t len, int &code)
     {
+        if (!writeOTA(ota.buf, len, code))
+            return false;
 
-        unsigned char *dtable = (unsigned char *)newP(256);
-        memset(dtable, 0x80, 256);
-        for (size_t i = 0; i < sizeof(fb_esp_base64_table) - 1; i++)
-            dtable[fb_esp_base64_table[i]] = (unsigned char)i;
-        dtable['='] = 0;
-
-        unsigned char *block = (unsigned char *)newP(4);
-        unsigned char tmp;
-        size_t i, count;
-        int pad = 0;
-        size_t extra_pad;
-
-        int chunkSize = 1024;
-        uint8_t *buf = (uint8_t *)newP(chunkSize);
-        int index = 0;
-
-        count = 0;
+        FastCRC32 crc32;
+        crc32.update(ota.crc, ota.buf, len);
+        ota.committed += len;
+        ota.buf_len -= len;
 
-        for (i = 0; i < len; i++)
-        {
-            if (dtable[(uint8_t)src[i]] != 0x80)
-                count++;
-        }
+        if (ota.buf_len > 0)
+            memmove(ota.buf, ota.buf + len, ota.buf_len);
 
-        if (count == 0)
-            goto exit;
+        return true;
+    }
 
-        extra_pad = (4 - count % 4) % 4;
+    //decode the base64 chunk, the chunk does not need to end at the quad boundary
+    bool decodeBase64OTA(struct fb_esp_ota_info_t &ota, const char *src, size_t len, int &code)
+    {
+        if (!ota.buf)
+            return false;
 
-        count = 0;
-        for (i = 0; i < len + extra_pad; i++)
+        for (size_t i = 0; i < len; i++)
         {
-            unsigned char val;
+            if (src[i] == '=')
+            {
+                ota.pad_len++;
+                continue;
+            }
 
-            if (i >= len)
-                val = '=';
-            else
-                val = src[i];
-            tmp = dtable[val];
-            if (tmp == 0x80)
+            int val = base64Value(src[i]);
+            if (val < 0 || ota.pad_len > 0)
                 continue;
 
-            if (val == '=')
-                pad++;
+            ota.quad[ota.quad_len++] = val;
 
-            block[count] = tmp;
-            count++;
-            if (count == 4)
+            if (ota.quad_len == 4)
             {
-                if (!addBuffer(buf, (block[0] << 2) | (block[1] >> 4), index, chunkSize, code))
-                    break;
+                uint8_t *p = ota.buf + ota.buf_len;
+                p[0] = (ota.quad[0] << 2) | (ota.quad[1] >> 4);
+                p[1] = (ota.quad[1] << 4) | (ota.quad[2] >> 2);
+                p[2] = (ota.quad[2] << 6) | ota.quad[3];
+                ota.buf_len += 3;
+                ota.quad_len = 0;
 
-                count = 0;
-                if (pad)
-                {
-                    if (pad == 1)
-                    {
-                        if (!addBuffer(buf, (block[1] << 4) | (block[2] >> 2), index, chunkSize, code))
-                            break;
-                    }
-                    else if (pad > 2)
-                        goto exit;
-
-                    break;
-                }
-                else
-                {
-                    if (!addBuffer(buf, (block[1] << 4) | (block[2] >> 2), index, chunkSize, code))
-                        break;
-
-                    if (!addBuffer(buf, (block[2] << 6) | block[3], index, chunkSize, code))
-                        break;
-                }
+                if (ota.buf_len >= OTA_WRITE_BUFFER_SIZE && !commitOTA(ota, OTA_WRITE_BUFFER_SIZE, code))
+                    return false;
             }
         }
 
-        if (index > 0)
-            writeOTA(buf, index, code);
+        return true;
+    }
 
-        delP(&block);
-        delP(&dtable);
-        delP(&buf);
+    //decode the padded quad and write the rest of the image, return true when the whole image was written
+    bool endOTA(struct fb_esp_ota_info_t &ota, int &code)
+    {
+        if (!ota.buf)
+            return false;
 
-        return true;
+        if (ota.quad_len > 1)
+        {
+            ota.buf[ota.buf_len++] = (ota.quad[0] << 2) | (ota.quad[1] >> 4);
+            if (ota.quad_len > 2)
+                ota.buf[ota.buf_len++] = (ota.quad[1] << 4) | (ota.quad[2] >> 2);
+        }
+        ota.quad_len = 0;
 
-    exit:
+        bool ret = ota.buf_len == 0 || commitOTA(ota, ota.buf_len, code);
 
-        delP(&block);
-        delP(&dtable);
-        delP(&buf);
+        delP(&ota.buf);
+        ota.buf_len = 0;
 
-        return false;
+        return ret && ota.committed + ota.pad_len == ota.size;
+    }
+
+    //release the decode buffer, the written size and CRC are kept
+    void clearOTA(struct fb_esp_ota_info_t &ota)
+    {
+        if (ota.buf)
+            delP(&ota.buf);
+        ota.buf_len = 0;
+        ota.quad_len = 0;
+    }
+
+    //discard the incomplete update so that the next download can begin
+    void abortUpdate()
+    {
+#if defined(ESP32)
+        Update.abort();
+#elif defined(ESP8266)
+        //ending the unfinished update resets the updater
+        if (Update.isRunning())
+            Update.end();
+#endif
     }
+#endif
 
     bool stringCompare(const char *buf, int ofs, PGM_P beginH, bool caseInSensitive = false)
     {
@@ -1418,97 +1676,124 @@ public:
         delP(&b64enc);
     }
 
-    bool sendBase64(size_t bufSize, uint8_t *data, size_t len, bool flashMem, WiFiClient *client)
+    //input bytes of the block which encodes to at most bufSize base64 characters,
+    //the large block is kept a multiple of 512 bytes (and 3) to read whole file system sectors
+    size_t base64BlockSize(size_t bufSize)
     {
-        bool ret = false;
-        const unsigned char *end, *in;
+        size_t size = bufSize / 4 * 3;
+        if (size >= 1536)
+            return size / 1536 * 1536;
+        return size < 3 ? 3 : size;
+    }
 
-        end = data + len;
-        in = data;
+    //encode the len bytes (multiple of 3) at the end of the buf (buf + len / 3) in place to the start of buf,
+    //the reads stay ahead of the writes so no extra buffer is needed
+    size_t encodeBase64Block(uint8_t *buf, size_t len)
+    {
+        size_t groups = len / 3;
+        const uint8_t *in = buf + groups;
+        uint8_t *out = buf;
 
-        size_t chunkSize = bufSize;
-        size_t byteAdded = 0;
-        size_t byteSent = 0;
+        while (groups >= 4)
+        {
+            uint32_t v0 = (in[0] << 16) | (in[1] << 8) | in[2];
+            uint32_t v1 = (in[3] << 16) | (in[4] << 8) | in[5];
+            uint32_t v2 = (in[6] << 16) | (in[7] << 8) | in[8];
+            uint32_t v3 = (in[9] << 16) | (in[10] << 8) | in[11];
+            out[0] = fb_esp_base64_table[v0 >> 18];
+            out[1] = fb_esp_base64_table[(v0 >> 12) & 0x3f];
+            out[2] = fb_esp_base64_table[(v0 >> 6) & 0x3f];
+            out[3] = fb_esp_base64_table[v0 & 0x3f];
+            out[4] = fb_esp_base64_table[v1 >> 18];
+            out[5] = fb_esp_base64_table[(v1 >> 12) & 0x3f];
+            out[6] = fb_esp_base64_table[(v1 >> 6) & 0x3f];
+            out[7] = fb_esp_base64_table[v1 & 0x3f];
+            out[8] = fb_esp_base64_table[v2 >> 18];
+            out[9] = fb_esp_base64_table[(v2 >> 12) & 0x3f];
+            out[10] = fb_esp_base64_table[(v2 >> 6) & 0x3f];
+            out[11] = fb_esp_base64_table[v2 & 0x3f];
+            out[12] = fb_esp_base64_table[v3 >> 18];
+            out[13] = fb_esp_base64_table[(v3 >> 12) & 0x3f];
+            out[14] = fb_esp_base64_table[(v3 >> 6) & 0x3f];
+            out[15] = fb_esp_base64_table[v3 & 0x3f];
+            in += 12;
+            out += 16;
+            groups -= 4;
+        }
 
-        unsigned char *buf = (unsigned char *)newP(chunkSize);
-        memset(buf, 0, chunkSize);
+        while (groups > 0)
+        {
+            uint32_t v = (in[0] << 16) | (in[1] << 8) | in[2];
+            out[0] = fb_esp_base64_table[v >> 18];
+            out[1] = fb_esp_base64_table[(v >> 12) & 0x3f];
+            out[2] = fb_esp_base64_table[(v >> 6) & 0x3f];
+            out[3] = fb_esp_base64_table[v & 0x3f];
+            in += 3;
+            out += 4;
+            groups--;
+        }
 
-        unsigned char *tmp = (unsigned char *)newP(3);
+        return out - buf;
+    }
 
-        while (end - in >= 3)
-        {
-            memset(tmp, 0, 3);
-            if (flashMem)
-                memcpy_P(tmp, in, 3);
-            else
-                memcpy(tmp, in, 3);
+    //encode the last 1 or 2 bytes with padding
+    size_t encodeBase64Tail(const uint8_t *in, size_t len, uint8_t *out)
+    {
+        if (len == 0)
+            return 0;
 
-            buf[byteAdded++] = fb_esp_base64_table[tmp[0] >> 2];
-            buf[byteAdded++] = fb_esp_base64_table[((tmp[0] & 0x03) << 4) | (tmp[1] >> 4)];
-            buf[byteAdded++] = fb_esp_base64_table[((tmp[1] & 0x0f) << 2) | (tmp[2] >> 6)];
-            buf[byteAdded++] = fb_esp_base64_table[tmp[2] & 0x3f];
+        uint32_t v = in[0] << 16;
+        if (len > 1)
+            v |= in[1] << 8;
 
-            if (byteAdded >= chunkSize - 4)
-            {
-                byteSent += byteAdded;
+        out[0] = fb_esp_base64_table[v >> 18];
+        out[1] = fb_esp_base64_table[(v >> 12) & 0x3f];
+        out[2] = len > 1 ? fb_esp_base64_table[(v >> 6) & 0x3f] : '=';
+        out[3] = '=';
+        return 4;
+    }
 
-                if (client->write((const char *)buf) != strlen((const char *)buf))
-                    goto ex;
-                memset(buf, 0, chunkSize);
-                byteAdded = 0;
-            }
+    bool sendBase64(size_t bufSize, uint8_t *data, size_t len, bool flashMem, WiFiClient *client)
+    {
+        size_t blockSize = base64BlockSize(bufSize);
+        size_t groups = blockSize / 3;
+        uint8_t *buf = (uint8_t *)newP(blockSize + groups);
+        if (!buf)
+            return false;
 
-            in += 3;
-        }
+        bool ret = true;
+        const uint8_t *in = data;
 
-        if (byteAdded > 0)
+        while (len > 0 && ret)
         {
-            if (client->write((const char *)buf) != strlen((const char *)buf))
-                goto ex;
-        }
+            size_t n = len < blockSize ? len : blockSize;
+            size_t whole = n / 3 * 3;
+            size_t olen = 0;
 
-        if (end - in)
-        {
-            memset(buf, 0, chunkSize);
-            byteAdded = 0;
-            memset(tmp, 0, 3);
-            if (flashMem)
-            {
-                if (end - in == 1)
-                    memcpy_P(tmp, in, 1);
-                else
-                    memcpy_P(tmp, in, 2);
-            }
-            else
+            if (whole > 0)
             {
-                if (end - in == 1)
-                    memcpy(tmp, in, 1);
+                if (flashMem)
+                    memcpy_P(buf + whole / 3, in, whole);
                 else
-                    memcpy(tmp, in, 2);
+                    memcpy(buf + whole / 3, in, whole);
+                olen = encodeBase64Block(buf, whole);
             }
 
-            buf[byteAdded++] = fb_esp_base64_table[tmp[0] >> 2];
-            if (end - in == 1)
+            if (whole < n)
             {
-                buf[byteAdded++] = fb_esp_base64_table[(tmp[0] & 0x03) << 4];
-                buf[byteAdded++] = '=';
-            }
-            else
-            {
-                buf[byteAdded++] = fb_esp_base64_table[((tmp[0] & 0x03) << 4) | (tmp[1] >> 4)];
-                buf[byteAdded++] = fb_esp_base64_table[(tmp[1] & 0x0f) << 2];
+                uint8_t tail[2];
+                if (flashMem)
+                    memcpy_P(tail, in + whole, n - whole);
+                else
+                    memcpy(tail, in + whole, n - whole);
+                olen += encodeBase64Tail(tail, n - whole, buf + olen);
             }
-            buf[byteAdded++] = '=';
 
-            if (client->write((const char *)buf) != strlen((const char *)buf))
-                goto ex;
-            memset(buf, 0, chunkSize);
+            ret = client->write(buf, olen) == olen;
+            in += n;
+            len -= n;
         }
 
-        ret = true;
-    ex:
-
-        delP(&tmp);
         delP(&buf);
         return ret;
     }
@@ -1648,6 +1933,74 @@ public:
         return true;
     }
 
+    //take the request slot of session, the concurrent requests are limited by the pool size
+    //when multiple requests are allowed, otherwise the requests are serialized
+    bool beginRequest(bool &processing, int &httpCode, bool wait = true)
+    {
+        if (!config)
+            return true;
+
+#if defined(ESP32)
+        unsigned long wTime = millis();
+        while (true)
+        {
+            bool ready = false;
+            portENTER_CRITICAL(&config->_int.fb_mux);
+            uint8_t max = config->_int.fb_multiple_requests ? config->_int.fb_max_requests : 1;
+            if (!processing && !config->_int.fb_processing && config->_int.fb_active_requests < max)
+            {
+                processing = true;
+                config->_int.fb_active_requests++;
+                ready = true;
+            }
+            portEXIT_CRITICAL(&config->_int.fb_mux);
+
+            if (ready)
+                return true;
+
+            if (!wait)
+                return false;
+
+            if (millis() - wTime > 3000)
+            {
+                httpCode = FIREBASE_ERROR_TCP_ERROR_CONNECTION_INUSED;
+                return false;
+            }
+            delay(0);
+        }
+#elif defined(ESP8266)
+        if (!processing)
+        {
+            processing = true;
+            config->_int.fb_active_requests++;
+        }
+        return true;
+#endif
+    }
+
+    //release the request slot of session
+    void endRequest(bool &processing)
+    {
+        if (!config)
+        {
+            processing = false;
+            return;
+        }
+
+#if defined(ESP32)
+        portENTER_CRITICAL(&config->_int.fb_mux);
+#endif
+        if (processing)
+        {
+            processing = false;
+            if (config->_int.fb_active_requests > 0)
+                config->_int.fb_active_requests--;
+        }
+#if defined(ESP32)
+        portEXIT_CRITICAL(&config->_int.fb_mux);
+#endif
+    }
+
     void splitTk(const MB_String &str, std::vector<MB_String> &tk, const char *delim)
     {
         std::size_t current, previous = 0;
@@ -0,0 +1,733 @@
+/**
+ * AttendanceAggregator
+ *
+ * The incremental per user and per day attendance summary for the RFID attendance events
+ * (the objects with uid, time and status that were pushed to the attendence node).
+ *
+ * The AttendanceSummary class is plain C++ and can be used on the host to build the summary
+ * from the backup file of the attendence node (the file that was saved by Firebase.backup).
+ *
+ * The AttendanceAggregator class is for ESP8266 and ESP32 that updates the summary from each
+ * event and writes only the changed summary nodes with a single multi-path update.
+ *
+ * The summary is kept as <path>/<yyyy-mm-dd>/<uid> with these children
+ * sec  - the total checked in duration in seconds of that day
+ * in   - the number of check ins
+ * out  - the number of check outs
+ * open - the check in time (epoch seconds) of the session that is still open, 0 when checked out
+ *
+ * The session that spans midnight is split into the days it covers.
+ *
+ * This work is an extension of the Firebase ESP Client library by K. Suwatchai (Mobizt)
+ * Copyright (c) 2026 RFID Door Lock System contributors
+ *
+ * The MIT License (MIT)
+*/
+
+#ifndef AttendanceAggregator_H
+#define AttendanceAggregator_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#define ATTENDANCE_SECONDS_PER_DAY 86400UL
+
+class AttendanceSummary
+{
+public:
+    struct day_summary_t
+    {
+        uint32_t seconds = 0;
+        uint32_t checkIns = 0;
+        uint32_t checkOuts = 0;
+        uint32_t open = 0;
+        bool dirty = false;
+        //the summary was created after its day was pruned or before the loaded days,
+        //the counters are added to the stored summary and open replaces it only when set
+        bool merge = false;
+        bool openSet = false;
+    };
+
+    struct event_t
+    {
+        uint32_t time = 0;
+        uint32_t user = 0;
+        uint8_t status = 0;
+    };
+
+    AttendanceSummary(){};
+    ~AttendanceSummary(){};
+
+    /** Set the time offset in seconds that is added to the event time to get the local day.
+     * 
+     * @param offset The offset in seconds e.g. 19800 for UTC+5:30.
+     * 
+     * @note Use 0 when the event time is already the local time e.g. the epoch time of 
+     * NTPClient with setTimeOffset or the time that was parsed from its formatted date.
+    */
+    void setTimeOffset(int32_t offset) { tzOffset = offset; }
+
+    /** Add the check in (status 1) or check out (status 0) event.
+     * 
+     * @param uid The user id.
+     * @param time The event time in epoch seconds.
+     * @param status The event status, 1 for check in and 0 for check out.
+     * 
+     * @note The events of each user should be added in time order, the late event only updates the counters.
+    */
+    void addEvent(const char *uid, uint32_t time, int status)
+    {
+        addUserEvent(userIndex(uid), time, status);
+    }
+
+    /** Add the events from the JSON (e.g. the backup file of the attendence node).
+     * 
+     * @param json The JSON string.
+     * @param len The length of string.
+     * @return The number of events that were added.
+     * 
+     * @note The events are sorted by time for each user before they were added.
+    */
+    size_t addEvents(const char *json, size_t len)
+    {
+        std::vector<event_t> events;
+        parseEvents(json, len, events);
+
+        std::stable_sort(events.begin(), events.end(), [](const event_t &a, const event_t &b)
+                         { return a.user != b.user ? a.user < b.user : a.time < b.time; });
+
+        for (size_t i = 0; i < events.size(); i++)
+            addUserEvent(events[i].user, events[i].time, events[i].status);
+
+        return events.size();
+    }
+
+    /** Set the summary that was read from the database e.g. to resume the open session after restart.
+     * 
+     * @param uid The user id.
+     * @param day The day number (days since 1970-01-01).
+     * @param data The summary data.
+    */
+    void setSummary(const char *uid, uint32_t day, const day_summary_t &data)
+    {
+        uint32_t user = userIndex(uid);
+        summaries[key(day, user)] = data;
+
+        if (data.open > 0 && data.open >= users[user].lastTime)
+        {
+            users[user].in = true;
+            users[user].since = data.open;
+            users[user].lastTime = data.open;
+        }
+    }
+
+    /** Get the summary of user at the day.
+     * 
+     * @param uid The user id.
+     * @param day The day number (days since 1970-01-01).
+     * @return The pointer to summary data or nullptr when not found.
+    */
+    const day_summary_t *getSummary(const char *uid, uint32_t day)
+    {
+        std::map<std::string, uint32_t>::iterator u = userMap.find(uid);
+        if (u == userMap.end())
+            return nullptr;
+
+        std::map<uint64_t, day_summary_t>::iterator it = summaries.find(key(day, u->second));
+        return it != summaries.end() ? &it->second : nullptr;
+    }
+
+    /** Call the function for each summary, in day order.
+     * 
+     * @param dirtyOnly Set to true to visit only the summaries that were changed since clearDirty.
+     * @param func The function that accept the day number, user id and summary data.
+    */
+    template <typename F>
+    void forEach(bool dirtyOnly, F func)
+    {
+        for (std::map<uint64_t, day_summary_t>::iterator it = summaries.begin(); it != summaries.end(); ++it)
+        {
+            if (!dirtyOnly || it->second.dirty)
+                func((uint32_t)(it->first >> 32), users[(uint32_t)it->first].uid.c_str(), it->second);
+        }
+    }
+
+    /** Get the number of changed summaries. */
+    size_t dirtyCount()
+    {
+        size_t n = 0;
+        forEach(true, [&n](uint32_t, const char *, const day_summary_t &)
+                { n++; });
+        return n;
+    }
+
+    /** Mark all summaries as written. */
+    void clearDirty()
+    {
+        for (std::map<uint64_t, day_summary_t>::iterator it = summaries.begin(); it != summaries.end(); ++it)
+            it->second.dirty = false;
+    }
+
+    /** Remove the written summaries of the days before the day to limit the memory usage.
+     * 
+     * @param day The first day to keep.
+     * 
+     * @note The summary of the removed day that is changed later is marked to merge.
+    */
+    void prune(uint32_t day)
+    {
+        if (day > firstDay)
+            firstDay = day;
+
+        std::map<uint64_t, day_summary_t>::iterator it = summaries.begin();
+        while (it != summaries.end() && (uint32_t)(it->first >> 32) < day)
+        {
+            if (it->second.dirty)
+                ++it;
+            else
+                it = summaries.erase(it);
+        }
+    }
+
+    /** Write all summaries or only the changed summaries as JSON object.
+     * 
+     * @param out The string to append the JSON.
+     * @param dirtyOnly Set to true for the changed summaries only.
+    */
+    void toJson(std::string &out, bool dirtyOnly = false)
+    {
+        char buf[64];
+        uint32_t curDay = 0xffffffff;
+        out += '{';
+        forEach(dirtyOnly, [&](uint32_t day, const char *uid, const day_summary_t &s)
+                {
+                    if (day != curDay)
+                    {
+                        if (curDay != 0xffffffff)
+                            out += "},";
+                        dayString(day, buf);
+                        out += '"';
+                        out += buf;
+                        out += "\":{";
+                        curDay = day;
+                    }
+                    else
+                        out += ',';
+
+                    out += '"';
+                    out += uid;
+                    snprintf(buf, sizeof(buf), "\":{\"sec\":%u,\"in\":%u,\"out\":%u,\"open\":%u}", (unsigned)s.seconds, (unsigned)s.checkIns, (unsigned)s.checkOuts, (unsigned)s.open);
+                    out += buf;
+                });
+        if (curDay != 0xffffffff)
+            out += '}';
+        out += '}';
+    }
+
+    /** Get the day number (days since 1970-01-01) of the event time. */
+    uint32_t dayOf(uint32_t time) { return (uint32_t)(((int64_t)time + tzOffset) / ATTENDANCE_SECONDS_PER_DAY); }
+
+    /** Get the day string (yyyy-mm-dd) of the day number.
+     * 
+     * @param day The day number.
+     * @param buf The buffer with at least 11 bytes.
+    */
+    static void dayString(uint32_t day, char *buf)
+    {
+        //civil date from the days since epoch
+        int32_t z = (int32_t)day + 719468;
+        int32_t era = z / 146097;
+        uint32_t doe = (uint32_t)(z - era * 146097);
+        uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        int32_t y = (int32_t)yoe + era * 400;
+        uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        uint32_t mp = (5 * doy + 2) / 153;
+        uint32_t d = doy - (153 * mp + 2) / 5 + 1;
+        uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+        if (m <= 2)
+            y++;
+        uint32_t v[3] = {(uint32_t)y, m, d};
+        int pos = 0;
+        for (int i = 0; i < 3; i++)
+        {
+            for (uint32_t div = i == 0 ? 1000 : 10; div > 0; div /= 10)
+                buf[pos++] = '0' + (v[i] / div) % 10;
+            buf[pos++] = i < 2 ? '-' : 0;
+        }
+    }
+
+    /** Parse the date time string e.g. 2022-03-05T10:20:30Z to epoch seconds.
+     * 
+     * @param s The date time string (yyyy-mm-ddThh:mm:ss).
+     * @param len The length of string.
+     * @return The epoch seconds or 0 when the string is invalid.
+    */
+    static uint32_t parseTime(const char *s, size_t len)
+    {
+        int v[6] = {0};
+        int n = 0;
+        size_t i = 0;
+
+        while (n < 6 && i < len)
+        {
+            if (s[i] < '0' || s[i] > '9')
+                return 0;
+
+            while (i < len && s[i] >= '0' && s[i] <= '9')
+                v[n] = v[n] * 10 + (s[i++] - '0');
+
+            n++;
+            //skip the separator
+            i++;
+        }
+
+        if (n < 6 || v[1] < 1 || v[1] > 12 || v[2] < 1 || v[2] > 31)
+            return 0;
+
+        //days since epoch from the civil date
+        int32_t y = v[1] <= 2 ? v[0] - 1 : v[0];
+        int32_t era = y / 400;
+        uint32_t yoe = (uint32_t)(y - era * 400);
+        uint32_t doy = (153 * (v[1] > 2 ? v[1] - 3 : v[1] + 9) + 2) / 5 + v[2] - 1;
+        uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        int32_t days = era * 146097 + (int32_t)doe - 719468;
+
+        if (days < 0)
+            return 0;
+
+        return (uint32_t)days * ATTENDANCE_SECONDS_PER_DAY + v[3] * 3600 + v[4] * 60 + v[5];
+    }
+
+protected:
+    struct user_state_t
+    {
+        std::string uid;
+        uint32_t since = 0;
+        uint32_t lastTime = 0;
+        bool in = false;
+    };
+
+    std::vector<user_state_t> users;
+    std::map<std::string, uint32_t> userMap;
+    std::map<uint64_t, day_summary_t> summaries;
+    int32_t tzOffset = 0;
+    //the days before it are not completely held in memory
+    uint32_t firstDay = 0;
+
+    uint64_t key(uint32_t day, uint32_t user) { return ((uint64_t)day << 32) | user; }
+
+    day_summary_t &summary(uint32_t day, uint32_t user)
+    {
+        std::pair<std::map<uint64_t, day_summary_t>::iterator, bool> it = summaries.insert(std::make_pair(key(day, user), day_summary_t()));
+        day_summary_t &s = it.first->second;
+        if (it.second)
+            s.merge = day < firstDay;
+        s.dirty = true;
+        return s;
+    }
+
+    void setOpen(uint32_t day, uint32_t user, uint32_t time)
+    {
+        day_summary_t &s = summary(day, user);
+        s.open = time;
+        s.openSet = true;
+    }
+
+    uint32_t userIndex(const char *uid)
+    {
+        std::map<std::string, uint32_t>::iterator it = userMap.find(uid);
+        if (it != userMap.end())
+            return it->second;
+
+        user_state_t user;
+        user.uid = uid;
+        users.push_back(user);
+        userMap[user.uid] = users.size() - 1;
+        return users.size() - 1;
+    }
+
+    void addUserEvent(uint32_t user, uint32_t time, int status)
+    {
+        user_state_t &u = users[user];
+        uint32_t day = dayOf(time);
+
+        if (status)
+            summary(day, user).checkIns++;
+        else
+            summary(day, user).checkOuts++;
+
+        //the late event can't be paired with the session
+        if (time < u.lastTime)
+            return;
+
+        u.lastTime = time;
+
+        if (status)
+        {
+            //the previous check in without check out was not counted
+            if (u.in)
+                setOpen(dayOf(u.since), user, 0);
+
+            u.in = true;
+            u.since = time;
+            setOpen(day, user, time);
+        }
+        else if (u.in)
+        {
+            u.in = false;
+            setOpen(dayOf(u.since), user, 0);
+            addDuration(user, u.since, time);
+        }
+    }
+
+    void addDuration(uint32_t user, uint32_t from, uint32_t to)
+    {
+        //split the session at each midnight
+        while (from < to)
+        {
+            uint32_t day = dayOf(from);
+            int64_t end = (int64_t)(day + 1) * ATTENDANCE_SECONDS_PER_DAY - tzOffset;
+            uint32_t next = end < (int64_t)to ? (uint32_t)end : to;
+            summary(day, user).seconds += next - from;
+            from = next;
+        }
+    }
+
+    void parseEvents(const char *json, size_t len, std::vector<event_t> &events)
+    {
+        //the event object is the object that has uid, time and status
+        bool inStr = false, esc = false, isKey = true;
+        const char *start = nullptr, *uid = nullptr, *time = nullptr;
+        size_t uidLen = 0, timeLen = 0;
+        int field = 0, status = -1;
+        std::string id;
+
+        for (size_t i = 0; i < len; i++)
+        {
+            char c = json[i];
+
+            if (inStr)
+            {
+                if (esc)
+                    esc = false;
+                else if (c == '\\')
+                    esc = true;
+                else if (c == '"')
+                {
+                    inStr = false;
+                    size_t n = json + i - start;
+
+                    if (isKey)
+                    {
+                        field = 0;
+                        if (n == 3 && memcmp(start, "uid", 3) == 0)
+                            field = 1;
+                        else if (n == 4 && memcmp(start, "time", 4) == 0)
+                            field = 2;
+                        else if (n == 6 && memcmp(start, "status", 6) == 0)
+                            field = 3;
+                    }
+                    else if (field == 1)
+                    {
+                        uid = start;
+                        uidLen = n;
+                    }
+                    else if (field == 2)
+                    {
+                        time = start;
+                        timeLen = n;
+                    }
+                }
+                continue;
+            }
+
+            switch (c)
+            {
+            case '"':
+                inStr = true;
+                start = json + i + 1;
+                break;
+            case '{':
+                uid = time = nullptr;
+                status = -1;
+                isKey = true;
+                break;
+            case ',':
+                isKey = true;
+                break;
+            case ':':
+                isKey = false;
+                //the status is number
+                if (field == 3)
+                {
+                    size_t j = i + 1;
+                    while (j < len && (json[j] == ' ' || json[j] == '"'))
+                        j++;
+                    if (j < len && (json[j] == '0' || json[j] == '1'))
+                        status = json[j] - '0';
+                    field = 0;
+                }
+                break;
+            case '}':
+                if (uid && time && status >= 0)
+                {
+                    event_t event;
+                    event.time = parseTime(time, timeLen);
+                    event.status = status;
+                    if (event.time > 0)
+                    {
+                        id.assign(uid, uidLen);
+                        event.user = userIndex(id.c_str());
+                        events.push_back(event);
+                    }
+                }
+                uid = time = nullptr;
+                status = -1;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+};
+
+#if defined(ESP8266) || defined(ESP32)
+
+#include "FirebaseFS.h"
+
+#ifdef ENABLE_RTDB
+
+#include <Arduino.h>
+
+#if defined(ESP32)
+#if defined(FIREBASE_ESP32_CLIENT)
+#include <FirebaseESP32.h>
+#endif
+#elif defined(ESP8266)
+#if defined(FIREBASE_ESP8266_CLIENT)
+#include <FirebaseESP8266.h>
+#endif
+#endif
+
+#if defined(FIREBASE_ESP_CLIENT)
+#include <Firebase_ESP_Client.h>
+#endif
+
+class AttendanceAggregator : public AttendanceSummary
+{
+public:
+    AttendanceAggregator(){};
+    ~AttendanceAggregator(){};
+
+    /** Read the summary of the day and the day before from the database to continue the counters
+     * and open sessions.
+     * 
+     * @param fbdo Firebase Data Object to hold data and instance.
+     * @param path The path to the summary node.
+     * @param time The time (epoch seconds) in the day to read.
+     * @return Boolean type status indicates the success of the operation.
+     * 
+     * @note The summary of the day that does not exist is not an error.
+     * The session that was opened the day before is resumed, the summaries of the earlier days
+     * are merged with the stored summaries when they are written.
+    */
+    bool load(FirebaseData &fbdo, const char *path, uint32_t time)
+    {
+        uint32_t day = dayOf(time);
+        if (day > 0 && day - 1 > firstDay)
+            firstDay = day - 1;
+
+        return (day == 0 || loadDay(fbdo, path, day - 1)) && loadDay(fbdo, path, day);
+    }
+
+    /** Write the changed summaries to the database with a single multi-path update.
+     * 
+     * @param fbdo Firebase Data Object to hold data and instance.
+     * @param path The path to the summary node.
+     * @return Boolean type status indicates the success of the operation.
+     * 
+     * @note The written summaries of the previous days are removed from memory.
+     * The summary of the day that is no longer in memory is read and added to first.
+    */
+    bool update(FirebaseData &fbdo, const char *path)
+    {
+        if (dirtyCount() == 0)
+            return true;
+
+        if (!mergeStored(fbdo, path))
+            return false;
+
+        // the keys are the multi-path "<day>/<uid>" which FirebaseJson::set would expand
+        // to the nested objects and the update would replace the whole day node
+        MB_String raw = "{";
+        char buf[12];
+        uint32_t lastDay = 0;
+
+        forEach(true, [&](uint32_t day, const char *uid, const day_summary_t &s)
+                {
+                    dayString(day, buf);
+                    if (raw.length() > 1)
+                        raw += ',';
+                    raw += '"';
+                    raw += buf;
+                    raw += '/';
+                    raw += uid;
+                    raw += "\":{";
+                    addValue(raw, "sec", s.seconds, false);
+                    addValue(raw, "in", s.checkIns, true);
+                    addValue(raw, "out", s.checkOuts, true);
+                    addValue(raw, "open", s.open, true);
+                    raw += '}';
+                    if (day > lastDay)
+                        lastDay = day;
+                });
+        raw += '}';
+
+        FirebaseJson json;
+        json.setJsonData(raw.c_str());
+
+#if defined(FIREBASE_ESP_CLIENT)
+        if (!Firebase.RTDB.updateNodeSilent(&fbdo, path, &json))
+#else
+        if (!Firebase.updateNodeSilent(fbdo, path, json))
+#endif
+            return false;
+
+        clearDirty();
+        prune(lastDay);
+        return true;
+    }
+
+private:
+    bool getNode(FirebaseData &fbdo, const char *path, uint32_t day, const char *uid, bool &found)
+    {
+        MB_String node = path;
+        char buf[12];
+        dayString(day, buf);
+        node += '/';
+        node += buf;
+        if (uid)
+        {
+            node += '/';
+            node += uid;
+        }
+
+#if defined(FIREBASE_ESP_CLIENT)
+        found = Firebase.RTDB.getJSON(&fbdo, node.c_str());
+#else
+        found = Firebase.getJSON(fbdo, node.c_str());
+#endif
+        if (!found)
+            return fbdo.httpCode() == FIREBASE_ERROR_PATH_NOT_EXIST;
+
+        found = fbdo.dataTypeEnum() == fb_esp_rtdb_data_type_json;
+        return true;
+    }
+
+    bool loadDay(FirebaseData &fbdo, const char *path, uint32_t day)
+    {
+        bool found = false;
+        if (!getNode(fbdo, path, day, nullptr, found))
+            return false;
+
+        if (!found)
+            return true;
+
+        FirebaseJson *json = fbdo.to<FirebaseJson *>();
+        FirebaseJsonData data;
+        size_t len = json->iteratorBegin();
+        FirebaseJson::IteratorValue value;
+        std::vector<MB_String> uids;
+
+        for (size_t i = 0; i < len; i++)
+        {
+            value = json->valueAt(i);
+            if (value.depth == 0)
+                uids.push_back(value.key.c_str());
+        }
+        json->iteratorEnd();
+
+        for (size_t i = 0; i < uids.size(); i++)
+        {
+            day_summary_t s;
+            readSummary(json, data, uids[i], s);
+            setSummary(uids[i].c_str(), day, s);
+        }
+
+        json->clear();
+        return true;
+    }
+
+    bool mergeStored(FirebaseData &fbdo, const char *path)
+    {
+        for (std::map<uint64_t, day_summary_t>::iterator it = summaries.begin(); it != summaries.end(); ++it)
+        {
+            day_summary_t &s = it->second;
+            if (!s.dirty || !s.merge)
+                continue;
+
+            bool found = false;
+            if (!getNode(fbdo, path, (uint32_t)(it->first >> 32), users[(uint32_t)it->first].uid.c_str(), found))
+                return false;
+
+            if (found)
+            {
+                FirebaseJson *json = fbdo.to<FirebaseJson *>();
+                FirebaseJsonData data;
+                day_summary_t stored;
+                readSummary(json, data, "", stored);
+                json->clear();
+
+                s.seconds += stored.seconds;
+                s.checkIns += stored.checkIns;
+                s.checkOuts += stored.checkOuts;
+                if (!s.openSet)
+                    s.open = stored.open;
+            }
+
+            //the summary now holds the whole day, the retry writes it as is
+            s.merge = false;
+        }
+        return true;
+    }
+
+    void readSummary(FirebaseJson *json, FirebaseJsonData &data, const MB_String &uid, day_summary_t &s)
+    {
+        s.seconds = getValue(json, data, uid, "sec");
+        s.checkIns = getValue(json, data, uid, "in");
+        s.checkOuts = getValue(json, data, uid, "out");
+        s.open = getValue(json, data, uid, "open");
+    }
+
+    void addValue(MB_String &raw, const char *name, uint32_t value, bool sep)
+    {
+        if (sep)
+            raw += ',';
+        raw += '"';
+        raw += name;
+        raw += "\":";
+        raw += value;
+    }
+
+    uint32_t getValue(FirebaseJson *json, FirebaseJsonData &data, const MB_String &uid, const char *name)
+    {
+        MB_String node = uid;
+        if (node.length() > 0)
+            node += '/';
+        node += name;
+        json->get(data, node.c_str());
+        return data.success ? data.to<uint32_t>() : 0;
+    }
+};
+
+#endif
+
+#endif
+
+#endif
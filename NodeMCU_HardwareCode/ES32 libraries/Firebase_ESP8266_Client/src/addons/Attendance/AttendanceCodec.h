@@ -0,0 +1,465 @@
+/**
+ * AttendanceCodec
+ *
+ * The compact binary encoding of the RFID attendance events.
+ *
+ * Each event is the 10 bytes record, time (epoch seconds, 4 bytes), card UID (4 bytes), 
+ * device index (1 byte) and status (1 byte), all integers are little endian.
+ * The records of the same time bucket are uploaded together as the base64 string
+ * to <path>/<bucket start time>/<push key>, that is about 14 bytes per event instead of
+ * about 150 bytes of the JSON object with time, id, uid and status.
+ *
+ * The AttendanceCodec and AttendanceEventBuffer classes are plain C++ and can be used on
+ * the host to decode the uploaded blobs (or the backup file of the events node).
+ *
+ * The AttendanceEventLog class is for ESP8266 and ESP32 that buffers and uploads the records.
+ *
+ * This work is an extension of the Firebase ESP Client library by K. Suwatchai (Mobizt)
+ * Copyright (c) 2026 RFID Door Lock System contributors
+ *
+ * The MIT License (MIT)
+*/
+
+#ifndef AttendanceCodec_H
+#define AttendanceCodec_H
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define ATTENDANCE_RECORD_SIZE 10
+#define ATTENDANCE_UID_SIZE 4
+#define DEFAULT_ATTENDANCE_BUCKET_SECONDS 3600
+#define DEFAULT_ATTENDANCE_MAX_RECORDS 256
+#define DEFAULT_ATTENDANCE_QUEUED_BUCKETS 2
+#define ATTENDANCE_PUSH_KEY_LENGTH 20
+
+class AttendanceCodec
+{
+public:
+    struct record_t
+    {
+        uint32_t time = 0;
+        uint8_t uid[ATTENDANCE_UID_SIZE] = {0};
+        uint8_t device = 0;
+        uint8_t status = 0;
+    };
+
+    static void encode(const record_t &rec, uint8_t *out)
+    {
+        for (int i = 0; i < 4; i++)
+            out[i] = (rec.time >> (8 * i)) & 0xff;
+        memcpy(out + 4, rec.uid, ATTENDANCE_UID_SIZE);
+        out[8] = rec.device;
+        out[9] = rec.status;
+    }
+
+    static void decode(const uint8_t *in, record_t &rec)
+    {
+        rec.time = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+        memcpy(rec.uid, in + 4, ATTENDANCE_UID_SIZE);
+        rec.device = in[8];
+        rec.status = in[9];
+    }
+
+    /** Get the UID string in the same format as the door unit sketch (the decimal value of each nibble).
+     * 
+     * @param uid The UID bytes.
+     * @param buf The buffer with at least 17 bytes.
+    */
+    static void uidString(const uint8_t *uid, char *buf)
+    {
+        int pos = 0;
+        for (int i = 0; i < ATTENDANCE_UID_SIZE; i++)
+        {
+            for (int s = 4; s >= 0; s -= 4)
+            {
+                uint8_t n = (uid[i] >> s) & 0x0f;
+                if (n > 9)
+                    buf[pos++] = '1';
+                buf[pos++] = '0' + n % 10;
+            }
+        }
+        buf[pos] = 0;
+    }
+
+    /** Get the base64 encoded length of data. */
+    static size_t encodedLength(size_t len) { return ((len + 2) / 3) * 4; }
+
+    /** Base64 encode the data.
+     * 
+     * @param in The data to encode.
+     * @param len The length of data.
+     * @param out The output string.
+    */
+    static void encodeBase64(const uint8_t *in, size_t len, std::string &out)
+    {
+        static const char tbl[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        size_t pos = out.length();
+        out.resize(pos + encodedLength(len));
+
+        size_t i = 0;
+        for (; i + 2 < len; i += 3)
+        {
+            uint32_t v = ((uint32_t)in[i] << 16) | ((uint32_t)in[i + 1] << 8) | in[i + 2];
+            out[pos++] = tbl[v >> 18];
+            out[pos++] = tbl[(v >> 12) & 0x3f];
+            out[pos++] = tbl[(v >> 6) & 0x3f];
+            out[pos++] = tbl[v & 0x3f];
+        }
+
+        if (i < len)
+        {
+            uint32_t v = (uint32_t)in[i] << 16;
+            if (i + 1 < len)
+                v |= (uint32_t)in[i + 1] << 8;
+            out[pos++] = tbl[v >> 18];
+            out[pos++] = tbl[(v >> 12) & 0x3f];
+            out[pos++] = i + 1 < len ? tbl[(v >> 6) & 0x3f] : '=';
+            out[pos++] = '=';
+        }
+    }
+
+    /** Decode the records from the base64 string.
+     * 
+     * @param b64 The base64 string.
+     * @param len The length of string.
+     * @param func The function that accept the const record_t reference.
+     * @return The number of records that were decoded or -1 when the string is not valid base64.
+     * 
+     * @note The records are decoded on the fly without the decoded data buffer.
+    */
+    template <typename F>
+    static int decodeRecords(const char *b64, size_t len, F func)
+    {
+        uint8_t buf[ATTENDANCE_RECORD_SIZE];
+        size_t n = 0;
+        int count = 0;
+        uint32_t v = 0;
+        int bits = 0;
+
+        for (size_t i = 0; i < len && b64[i] != '='; i++)
+        {
+            int d = value(b64[i]);
+            if (d < 0)
+                return -1;
+
+            v = (v << 6) | d;
+            bits += 6;
+
+            if (bits >= 8)
+            {
+                bits -= 8;
+                buf[n++] = (v >> bits) & 0xff;
+
+                if (n == ATTENDANCE_RECORD_SIZE)
+                {
+                    record_t rec;
+                    decode(buf, rec);
+                    func(rec);
+                    count++;
+                    n = 0;
+                }
+            }
+        }
+
+        return count;
+    }
+
+    /** Decode the records of the uploaded blobs in the JSON (e.g. the backup file of the events node).
+     * 
+     * @param json The JSON string.
+     * @param len The length of string.
+     * @param func The function that accept the const record_t reference.
+     * @return The number of records that were decoded.
+     * 
+     * @note Only the string values of the push keys that are the whole records in base64 are decoded,
+     * the other strings in the JSON are skipped.
+    */
+    template <typename F>
+    static size_t decodeJson(const char *json, size_t len, F func)
+    {
+        bool inStr = false, esc = false, isKey = true, pushKey = false;
+        const char *start = nullptr;
+        size_t count = 0;
+
+        for (size_t i = 0; i < len; i++)
+        {
+            char c = json[i];
+
+            if (inStr)
+            {
+                if (esc)
+                    esc = false;
+                else if (c == '\\')
+                    esc = true;
+                else if (c == '"')
+                {
+                    inStr = false;
+                    if (isKey)
+                        pushKey = isPushKey(start, json + i - start);
+                    else if (pushKey && isRecords(start, json + i - start))
+                        count += decodeRecords(start, json + i - start, func);
+                }
+                continue;
+            }
+
+            if (c == '"')
+            {
+                inStr = true;
+                start = json + i + 1;
+            }
+            else if (c == '{' || c == ',')
+            {
+                isKey = true;
+                pushKey = false;
+            }
+            else if (c == ':')
+                isKey = false;
+        }
+
+        return count;
+    }
+
+    /** Check the key is the push key (20 characters of the push key alphabet that starts with '-'). */
+    static bool isPushKey(const char *key, size_t len)
+    {
+        if (len != ATTENDANCE_PUSH_KEY_LENGTH || key[0] != '-')
+            return false;
+
+        for (size_t i = 0; i < len; i++)
+        {
+            char c = key[i];
+            if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-' || c == '_'))
+                return false;
+        }
+
+        return true;
+    }
+
+    /** Check the string is base64 of the whole records. */
+    static bool isRecords(const char *b64, size_t len)
+    {
+        if (len == 0 || len % 4 > 0)
+            return false;
+
+        size_t pad = 0;
+        while (pad < 2 && b64[len - 1 - pad] == '=')
+            pad++;
+
+        for (size_t i = 0; i < len - pad; i++)
+        {
+            if (value(b64[i]) < 0)
+                return false;
+        }
+
+        return (len / 4 * 3 - pad) % ATTENDANCE_RECORD_SIZE == 0;
+    }
+
+private:
+    static int value(char c)
+    {
+        if (c >= 'A' && c <= 'Z')
+            return c - 'A';
+        if (c >= 'a' && c <= 'z')
+            return c - 'a' + 26;
+        if (c >= '0' && c <= '9')
+            return c - '0' + 52;
+        if (c == '+' || c == '-')
+            return 62;
+        if (c == '/' || c == '_')
+            return 63;
+        return -1;
+    }
+};
+
+class AttendanceEventBuffer
+{
+public:
+    AttendanceEventBuffer(){};
+    ~AttendanceEventBuffer(){};
+
+    /** Set the bucket duration and the maximum number of records in each upload.
+     * 
+     * @param bucketSeconds The bucket duration in seconds.
+     * @param maxRecords The maximum number of records to keep before upload.
+    */
+    void setBucket(uint32_t bucketSeconds, size_t maxRecords = DEFAULT_ATTENDANCE_MAX_RECORDS)
+    {
+        this->bucketSeconds = bucketSeconds > 0 ? bucketSeconds : 1;
+        this->maxRecords = maxRecords > 0 ? maxRecords : 1;
+    }
+
+    /** Add the record to the buffer.
+     * 
+     * @param rec The record to add.
+     * @return Boolean type status indicates the record was added, false when the buffer 
+     * should be uploaded first (full or the record is in the other bucket).
+    */
+    bool add(const AttendanceCodec::record_t &rec)
+    {
+        if (size() > 0 && (size() >= maxRecords || bucketOf(rec.time) != bucketStart))
+            return false;
+
+        if (size() == 0)
+            bucketStart = bucketOf(rec.time);
+
+        size_t pos = data.size();
+        data.resize(pos + ATTENDANCE_RECORD_SIZE);
+        AttendanceCodec::encode(rec, data.data() + pos);
+        return true;
+    }
+
+    /** Get the number of records in the buffer. */
+    size_t size() { return data.size() / ATTENDANCE_RECORD_SIZE; }
+
+    /** Get the bucket start time of the records in the buffer. */
+    uint32_t bucket() { return bucketStart; }
+
+    /** Get the base64 string of the records in the buffer. */
+    void toBase64(std::string &out)
+    {
+        out.clear();
+        AttendanceCodec::encodeBase64(data.data(), data.size(), out);
+    }
+
+    void clear() { data.clear(); }
+
+protected:
+    std::vector<uint8_t> data;
+    uint32_t bucketSeconds = DEFAULT_ATTENDANCE_BUCKET_SECONDS;
+    size_t maxRecords = DEFAULT_ATTENDANCE_MAX_RECORDS;
+    uint32_t bucketStart = 0;
+
+    uint32_t bucketOf(uint32_t time) { return time - time % bucketSeconds; }
+};
+
+#if defined(ESP8266) || defined(ESP32)
+
+#include "FirebaseFS.h"
+
+#ifdef ENABLE_RTDB
+
+#include <Arduino.h>
+
+#if defined(ESP32)
+#if defined(FIREBASE_ESP32_CLIENT)
+#include <FirebaseESP32.h>
+#endif
+#elif defined(ESP8266)
+#if defined(FIREBASE_ESP8266_CLIENT)
+#include <FirebaseESP8266.h>
+#endif
+#endif
+
+#if defined(FIREBASE_ESP_CLIENT)
+#include <Firebase_ESP_Client.h>
+#endif
+
+class AttendanceEventLog : public AttendanceEventBuffer
+{
+public:
+    AttendanceEventLog(){};
+    ~AttendanceEventLog(){};
+
+    /** Set the number of the full or closed buckets to keep while they can't be uploaded.
+     * 
+     * @param size The number of buckets (at least 1).
+    */
+    void setQueueSize(size_t size) { queueSize = size > 0 ? size : 1; }
+
+    /** Add the event and upload the buffered records when the buffer is full or the bucket was changed.
+     * 
+     * @param fbdo Firebase Data Object to hold data and instance.
+     * @param path The path to the events node.
+     * @param rec The event record.
+     * @return Boolean type status indicates the record was kept, false when the record was rejected.
+     * 
+     * @note The full or closed bucket is queued and the records are kept until they were uploaded.
+     * When the queue is full and can't be uploaded, the new record is rejected and counted in lostCount.
+    */
+    bool log(FirebaseData &fbdo, const char *path, const AttendanceCodec::record_t &rec)
+    {
+        if (add(rec))
+            return true;
+
+        if (queue.size() >= queueSize)
+            flushQueue(fbdo, path);
+
+        if (queue.size() >= queueSize)
+        {
+            lost++;
+            return false;
+        }
+
+        queue.push_back(*this);
+        clear();
+        add(rec);
+
+        flushQueue(fbdo, path);
+        return true;
+    }
+
+    /** Upload the queued buckets and the buffered records, each bucket as a single base64 string.
+     * 
+     * @param fbdo Firebase Data Object to hold data and instance.
+     * @param path The path to the events node.
+     * @return Boolean type status indicates the success of the operation.
+    */
+    bool flush(FirebaseData &fbdo, const char *path)
+    {
+        if (!flushQueue(fbdo, path))
+            return false;
+
+        if (size() == 0)
+            return true;
+
+        if (!upload(fbdo, path, *this))
+            return false;
+
+        clear();
+        return true;
+    }
+
+    /** Get the number of the records that were rejected. */
+    size_t lostCount() { return lost; }
+
+private:
+    std::vector<AttendanceEventBuffer> queue;
+    size_t queueSize = DEFAULT_ATTENDANCE_QUEUED_BUCKETS;
+    size_t lost = 0;
+
+    bool flushQueue(FirebaseData &fbdo, const char *path)
+    {
+        while (queue.size() > 0)
+        {
+            if (!upload(fbdo, path, queue[0]))
+                return false;
+            queue.erase(queue.begin());
+        }
+        return true;
+    }
+
+    bool upload(FirebaseData &fbdo, const char *path, AttendanceEventBuffer &buf)
+    {
+        std::string b64;
+        buf.toBase64(b64);
+
+        MB_String node = path;
+        node += '/';
+        node += MB_String(buf.bucket());
+
+#if defined(FIREBASE_ESP_CLIENT)
+        return Firebase.RTDB.pushString(&fbdo, node.c_str(), b64.c_str());
+#else
+        return Firebase.pushString(fbdo, node.c_str(), b64.c_str());
+#endif
+    }
+};
+
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,1330 @@
+/**
+ * EdgeGateway
+ *
+ * The gateway that aggregates many door readers into one upstream Firebase session.
+ *
+ * The readers send the compact frames to the gateway over the local UDP instead of
+ * running their own Firebase.begin, token refresh, TLS sessions and stream.
+ * The gateway removes the duplicate frames, batches the attendance records per time bucket
+ * and the state values (latest wins) and writes them upstream with the multi-path updates,
+ * one for the attendance records and one for the state values.
+ * The stream events of the subscribed node (e.g. the allowlist) are sent back to all readers.
+ *
+ * All integers in the frames are little endian, every frame begins with the 5 bytes header,
+ * magic (0xAD), type, device, sequence number (2 bytes) and ends with the 8 bytes tag.
+ *
+ * The tag is the SipHash-2-4 of the session (4 bytes) and the frame with the 16 bytes key of
+ * the reader (setReaderKey). The gateway only serves the readers with the key, the frames without
+ * the valid tag are dropped before the reader is known.
+ * The start hello and its ack are signed with the session 0, the ack carries the new session that
+ * signs all other frames of the reader in both directions. The frames of the old session (e.g. the
+ * replayed ones or after the gateway was restarted) get the session ack that is also signed with
+ * the session 0, the reader should then send the start hello again.
+ *
+ * reader to gateway
+ * attendance, the 10 bytes AttendanceCodec records (one or more).
+ * state, name length (1 byte), name (the child of the state node, without '/') and the scalar
+ * JSON value e.g. 1, true, "open" or null.
+ * hello, flags (1 byte, optional), sent on start and the gateway replies with the snapshot
+ * of the subscribed node, or with flags 1 as the heartbeat of the idle reader.
+ *
+ * gateway to reader
+ * ack, status (1 byte) of the frame with the same sequence number, the reader should keep
+ * and resend the frame (with the same sequence number) until the ok or invalid ack was received.
+ * The ack of the start hello also has the new session (4 bytes).
+ * downlink, operation (0 put, 1 patch), path length (1 byte), path (relative to the subscribed
+ * node) and the JSON data, the data that does not fit in the frame is sent as the puts of
+ * its child nodes. The reader should only apply the downlink with the sequence number that is
+ * greater than the last one of the session, the older ones could be replayed.
+ *
+ * The device index of the received records is set to the device of the frame.
+ * The attendance records are written to <path>/<events>/<bucket start time>/<push key> as the
+ * base64 string as AttendanceEventLog does, the state values to <path>/<state>/<state name>.
+ *
+ * The EdgeGatewayCore class is plain C++ and can be used on the host with any transport,
+ * the EdgeGateway class is for ESP8266 and ESP32 that serves the readers over WiFiUDP.
+ *
+ * This work is an extension of the Firebase ESP Client library by K. Suwatchai (Mobizt)
+ * Copyright (c) 2026 RFID Door Lock System contributors
+ *
+ * The MIT License (MIT)
+*/
+
+#ifndef EdgeGateway_H
+#define EdgeGateway_H
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "../Attendance/AttendanceCodec.h"
+
+#define EDGE_GATEWAY_MAGIC 0xAD
+#define EDGE_GATEWAY_HEADER_SIZE 5
+#define EDGE_GATEWAY_TAG_SIZE 8
+#define EDGE_GATEWAY_KEY_SIZE 16
+#define EDGE_GATEWAY_MAX_FRAME 512
+#define EDGE_GATEWAY_MAX_PATH 64
+#define EDGE_GATEWAY_SEQ_WINDOW 64
+#define EDGE_GATEWAY_BROADCAST 0xff
+#define DEFAULT_EDGE_GATEWAY_PORT 4210
+#define DEFAULT_EDGE_GATEWAY_MAX_RECORDS 1024
+#define DEFAULT_EDGE_GATEWAY_MAX_STATES 256
+#define DEFAULT_EDGE_GATEWAY_BATCH_RECORDS 64
+#define DEFAULT_EDGE_GATEWAY_INTERVAL 2000
+#define DEFAULT_EDGE_GATEWAY_MAX_BODY 8192
+#define DEFAULT_EDGE_GATEWAY_READER_TIMEOUT 300000
+
+class EdgeGatewayCore
+{
+public:
+    enum frame_type_t
+    {
+        frame_attendance = 1,
+        frame_state = 2,
+        frame_hello = 3,
+        frame_ack = 0x81,
+        frame_downlink = 0x82
+    };
+
+    enum ack_status_t
+    {
+        ack_ok = 0,
+        ack_busy = 1,
+        ack_invalid = 2,
+        ack_session = 3
+    };
+
+    enum hello_flag_t
+    {
+        hello_start = 0,
+        hello_heartbeat = 1
+    };
+
+    enum downlink_op_t
+    {
+        op_put = 0,
+        op_patch = 1
+    };
+
+    struct endpoint_t
+    {
+        uint32_t ip = 0;
+        uint16_t port = 0;
+    };
+
+    struct reader_t
+    {
+        uint8_t device = 0;
+        endpoint_t endpoint;
+        uint32_t lastSeen = 0;
+        uint16_t lastSeq = 0;
+        uint64_t window = 0;
+        uint32_t session = 0;
+        bool seqValid = false;
+        bool snapshot = false;
+    };
+
+    struct stats_t
+    {
+        uint32_t frames = 0;
+        uint32_t records = 0;
+        uint32_t states = 0;
+        uint32_t duplicates = 0;
+        uint32_t busy = 0;
+        uint32_t invalid = 0;
+        uint32_t unauthorized = 0;
+        uint32_t flushes = 0;
+        uint32_t flushErrors = 0;
+        uint32_t downlinks = 0;
+        uint32_t dropped = 0;
+    };
+
+    EdgeGatewayCore(){};
+    ~EdgeGatewayCore(){};
+
+    /** Set the nodes (relative to the update path) of the attendance events and the state values.
+     *
+     * @param events The events node e.g. "events".
+     * @param state The state node e.g. "users" or "" for the update path itself.
+     *
+     * @note The state value that is named as the events node is rejected when the state node is "".
+    */
+    void setNodes(const char *events, const char *state)
+    {
+        eventsNode = events ? events : "";
+        stateNode = state ? state : "";
+    }
+
+    /** Set the bucket duration of the attendance records.
+     *
+     * @param bucketSeconds The bucket duration in seconds.
+    */
+    void setBucket(uint32_t bucketSeconds) { this->bucketSeconds = bucketSeconds > 0 ? bucketSeconds : 1; }
+
+    /** Set the batch limits.
+     *
+     * @param batchRecords The number of pending records that the update should be sent immediately.
+     * @param interval The maximum time in ms that the pending data waits for the update.
+     * @param maxRecords The maximum number of pending records, the readers get the busy ack when it was reached.
+     * @param maxStates The maximum number of pending state values.
+     * @param maxBody The maximum length of the update body, the rest is sent with the next update.
+    */
+    void setBatch(size_t batchRecords, uint32_t interval, size_t maxRecords = DEFAULT_EDGE_GATEWAY_MAX_RECORDS,
+                  size_t maxStates = DEFAULT_EDGE_GATEWAY_MAX_STATES, size_t maxBody = DEFAULT_EDGE_GATEWAY_MAX_BODY)
+    {
+        this->batchRecords = batchRecords > 0 ? batchRecords : 1;
+        this->interval = interval;
+        this->maxRecords = maxRecords > 0 ? maxRecords : 1;
+        this->maxStates = maxStates > 0 ? maxStates : 1;
+        this->maxBody = maxBody;
+    }
+
+    /** Set the time in ms that the reader without any frame is removed from the downlink. */
+    void setReaderTimeout(uint32_t timeout) { readerTimeout = timeout; }
+
+    /** Set the shared key of the reader, the readers without the key are not served.
+     *
+     * @param device The device index of reader.
+     * @param key The 16 bytes key, or nullptr to remove the reader.
+    */
+    void setReaderKey(uint8_t device, const uint8_t *key)
+    {
+        if (key)
+        {
+            keys[device].assign(key, key + EDGE_GATEWAY_KEY_SIZE);
+            return;
+        }
+
+        keys.erase(device);
+        for (size_t i = 0; i < readers.size(); i++)
+        {
+            if (readers[i].device == device)
+            {
+                readers.erase(readers.begin() + i);
+                break;
+            }
+        }
+    }
+
+    /** Set the seed of the reader sessions e.g. the random number on start.
+     *
+     * @note The sessions after the gateway was restarted should not repeat the earlier ones.
+    */
+    void setSessionSeed(uint32_t seed) { sessionSeed = seed; }
+
+    /** Handle the frame from the reader.
+     *
+     * @param buf The frame data.
+     * @param len The length of frame.
+     * @param from The address of the reader.
+     * @param now The current time in ms.
+     * @param reply The ack frame to send back to the reader.
+     * @return Boolean type status indicates the reply should be sent.
+    */
+    bool handleFrame(const uint8_t *buf, size_t len, const endpoint_t &from, uint32_t now, std::vector<uint8_t> &reply)
+    {
+        if (len < EDGE_GATEWAY_HEADER_SIZE + EDGE_GATEWAY_TAG_SIZE || len > EDGE_GATEWAY_MAX_FRAME || buf[0] != EDGE_GATEWAY_MAGIC)
+        {
+            stat.invalid++;
+            return false;
+        }
+
+        uint8_t type = buf[1];
+        uint8_t device = buf[2];
+        uint16_t seq = buf[3] | (buf[4] << 8);
+        len -= EDGE_GATEWAY_TAG_SIZE;
+        const uint8_t *payload = buf + EDGE_GATEWAY_HEADER_SIZE;
+        size_t plen = len - EDGE_GATEWAY_HEADER_SIZE;
+
+        if (device == EDGE_GATEWAY_BROADCAST || (type != frame_attendance && type != frame_state && type != frame_hello))
+        {
+            stat.invalid++;
+            return false;
+        }
+
+        std::map<uint8_t, std::vector<uint8_t>>::iterator k = keys.find(device);
+        if (k == keys.end())
+        {
+            stat.unauthorized++;
+            return false;
+        }
+
+        const uint8_t *key = k->second.data();
+        bool start = type == frame_hello && (plen == 0 || payload[0] != hello_heartbeat);
+        reader_t *r = find(device);
+
+        //the other frames than the start hello need the session of the known reader
+        if ((!start && !r) || !checkTag(buf, len, key, start ? 0 : r->session))
+        {
+            stat.unauthorized++;
+            //the reader of the old session should send the start hello again
+            return !start && makeAck(reply, key, 0, device, seq, ack_session);
+        }
+
+        stat.frames++;
+
+        r = reader(device, from, now);
+
+        if (type == frame_hello)
+        {
+            if (!start)
+                return makeAck(reply, key, r->session, device, seq, ack_ok);
+
+            //the reader was restarted, its sequence number starts again
+            r->seqValid = false;
+            r->snapshot = true;
+            r->session = newSession();
+
+            header(reply, frame_ack, device, seq);
+            reply.push_back(ack_ok);
+            for (int i = 0; i < 4; i++)
+                reply.push_back((r->session >> (8 * i)) & 0xff);
+            sign(reply, key, 0);
+            return true;
+        }
+
+        const char *path = nullptr, *value = nullptr;
+        size_t pathLen = 0, valueLen = 0;
+
+        if (type == frame_attendance ? (plen == 0 || plen % ATTENDANCE_RECORD_SIZE > 0) : !parseState(payload, plen, path, pathLen, value, valueLen))
+        {
+            stat.invalid++;
+            return makeAck(reply, key, r->session, device, seq, ack_invalid);
+        }
+
+        if (isDuplicate(*r, seq))
+        {
+            stat.duplicates++;
+            return makeAck(reply, key, r->session, device, seq, ack_ok);
+        }
+
+        if (type == frame_attendance)
+        {
+            if (pendingRecords + plen / ATTENDANCE_RECORD_SIZE > maxRecords)
+            {
+                stat.busy++;
+                return makeAck(reply, key, r->session, device, seq, ack_busy);
+            }
+
+            for (size_t i = 0; i < plen; i += ATTENDANCE_RECORD_SIZE)
+            {
+                AttendanceCodec::record_t rec;
+                AttendanceCodec::decode(payload + i, rec);
+                rec.device = device;
+                addRecord(rec);
+            }
+        }
+        else
+        {
+            std::string name(path, pathLen);
+            if (states.size() >= maxStates && states.find(name) == states.end())
+            {
+                stat.busy++;
+                return makeAck(reply, key, r->session, device, seq, ack_busy);
+            }
+
+            states[name].assign(value, valueLen);
+            stat.states++;
+        }
+
+        markSeq(*r, seq);
+        return makeAck(reply, key, r->session, device, seq, ack_ok);
+    }
+
+    /** Check whether the pending data should be sent.
+     *
+     * @param now The current time in ms.
+     * @return Boolean type status indicates the update should be sent.
+    */
+    bool ready(uint32_t now)
+    {
+        if (!hasPending())
+            return false;
+        //the failed update is retried after the interval
+        return (pendingRecords >= batchRecords && !failed) || now - lastFlush >= interval;
+    }
+
+    /** Build the multi-path update body of the pending attendance records.
+     *
+     * @param body The JSON object string e.g. {"events/1650000000/<key>":"base64"}.
+     * @param newKey The function that returns the new push key (std::string) of the attendance batch,
+     * or the empty string when the key can't be generated.
+     * @return Boolean type status indicates there is the data to send.
+     *
+     * @note The batch keeps its push key until it was written, the retry of the failed update
+     * writes the same nodes. The batch without the key is kept and not sent.
+     * Call commit with the result of the update.
+    */
+    template <typename F>
+    bool buildUpdate(std::string &body, F newKey)
+    {
+        body = "{";
+        size_t count = 0;
+        std::string b64;
+
+        for (size_t i = 0; i < batches.size(); i++)
+        {
+            batch_t &b = batches[i];
+            if (b.inflight)
+                continue;
+
+            size_t len = b.key.length() > 0 ? b.key.length() : 20;
+            if (count > 0 && body.length() + eventsNode.length() + len + AttendanceCodec::encodedLength(b.data.size()) + 20 > maxBody)
+                break;
+
+            if (b.key.length() == 0)
+                b.key = newKey();
+
+            //the batches are sent in order when their keys can be generated
+            if (b.key.length() == 0)
+                break;
+
+            b64.clear();
+            AttendanceCodec::encodeBase64(b.data.data(), b.data.size(), b64);
+
+            addKey(body, count, eventsNode);
+            body += std::to_string(b.bucket);
+            body += '/';
+            body += b.key;
+            body += "\":\"";
+            body += b64;
+            body += '"';
+            b.inflight = true;
+        }
+
+        body += '}';
+        return count > 0;
+    }
+
+    /** Build the multi-path update body of the pending state values.
+     *
+     * @param body The JSON object string e.g. {"users/12345678":1}.
+     * @return Boolean type status indicates there is the data to send.
+     *
+     * @note The state values are sent apart from the attendance records, the state update that
+     * fails does not hold the records back. Call commit with the result of the update.
+    */
+    bool buildStateUpdate(std::string &body)
+    {
+        body = "{";
+        size_t count = 0;
+
+        for (std::map<std::string, std::string>::iterator it = states.begin(); it != states.end();)
+        {
+            if (count > 0 && body.length() + stateNode.length() + it->first.length() + it->second.length() + 6 > maxBody)
+                break;
+
+            addKey(body, count, stateNode);
+            body += it->first;
+            body += "\":";
+            body += it->second;
+            inflightStates[it->first] = it->second;
+            states.erase(it++);
+        }
+
+        body += '}';
+        return count > 0;
+    }
+
+    /** Apply the result of the update that was built by buildUpdate or buildStateUpdate.
+     *
+     * @param success The update was successful.
+     * @param now The current time in ms.
+    */
+    void commit(bool success, uint32_t now)
+    {
+        lastFlush = now;
+        failed = !success;
+
+        if (success)
+        {
+            stat.flushes++;
+            for (size_t i = 0; i < batches.size();)
+            {
+                if (batches[i].inflight)
+                {
+                    pendingRecords -= batches[i].data.size() / ATTENDANCE_RECORD_SIZE;
+                    batches.erase(batches.begin() + i);
+                }
+                else
+                    i++;
+            }
+        }
+        else
+        {
+            stat.flushErrors++;
+            for (size_t i = 0; i < batches.size(); i++)
+                batches[i].inflight = false;
+            //the newer values that were received during the update win
+            states.insert(inflightStates.begin(), inflightStates.end());
+        }
+
+        inflightStates.clear();
+    }
+
+    /** Build the downlink frames of the stream event.
+     *
+     * @param op The operation, op_put or op_patch.
+     * @param path The path relative to the subscribed node, without the leading slash.
+     * @param json The JSON data.
+     * @param len The length of data.
+     * @param send The function that accepts the frame data (const uint8_t *) and its length (size_t).
+     * @return The number of frames.
+     *
+     * @note The frames are not signed, sign them for each reader with signFrame.
+    */
+    template <typename F>
+    size_t makeDownlink(uint8_t op, const char *path, const char *json, size_t len, F send)
+    {
+        size_t pathLen = strlen(path);
+        if (pathLen > EDGE_GATEWAY_MAX_PATH * 2)
+        {
+            stat.dropped++;
+            return 0;
+        }
+
+        if (EDGE_GATEWAY_HEADER_SIZE + 2 + pathLen + len + EDGE_GATEWAY_TAG_SIZE <= EDGE_GATEWAY_MAX_FRAME)
+        {
+            std::vector<uint8_t> frame;
+            header(frame, frame_downlink, EDGE_GATEWAY_BROADCAST, downlinkSeq++);
+            frame.push_back(op);
+            frame.push_back((uint8_t)pathLen);
+            frame.insert(frame.end(), path, path + pathLen);
+            frame.insert(frame.end(), json, json + len);
+            send((const uint8_t *)frame.data(), frame.size());
+            stat.downlinks++;
+            return 1;
+        }
+
+        size_t i = skipSpace(json, 0, len);
+        if (i == len || json[i] != '{')
+        {
+            stat.dropped++;
+            return 0;
+        }
+
+        //the put replaces the node, remove it before the puts of its child nodes
+        size_t count = op == op_put ? makeDownlink(op_put, path, "null", 4, send) : 0;
+        std::string child;
+
+        i = skipSpace(json, i + 1, len);
+        while (i < len && json[i] == '"')
+        {
+            size_t keyEnd = valueEnd(json, i, len);
+            size_t v = skipSpace(json, keyEnd, len);
+            if (v >= len || json[v] != ':')
+                break;
+            v = skipSpace(json, v + 1, len);
+            size_t vEnd = valueEnd(json, v, len);
+            if (vEnd == v)
+                break;
+
+            child = path;
+            if (pathLen > 0)
+                child += '/';
+            child.append(json + i + 1, keyEnd - i - 2);
+            count += makeDownlink(op_put, child.c_str(), json + v, vEnd - v, send);
+
+            i = skipSpace(json, vEnd, len);
+            if (i < len && json[i] == ',')
+                i = skipSpace(json, i + 1, len);
+        }
+
+        return count;
+    }
+
+    /** Sign the downlink frame for the reader.
+     *
+     * @param r The reader.
+     * @param frame The frame from makeDownlink.
+     * @param len The length of frame.
+     * @param out The frame with the tag of the reader session.
+     * @return Boolean type status indicates the reader has the key.
+    */
+    bool signFrame(const reader_t &r, const uint8_t *frame, size_t len, std::vector<uint8_t> &out)
+    {
+        std::map<uint8_t, std::vector<uint8_t>>::iterator k = keys.find(r.device);
+        if (k == keys.end())
+            return false;
+
+        out.assign(frame, frame + len);
+        sign(out, k->second.data(), r.session);
+        return true;
+    }
+
+    /** Call the function for each reader.
+     *
+     * @param func The function that accepts the reader_t reference.
+    */
+    template <typename F>
+    void forEachReader(F func)
+    {
+        for (size_t i = 0; i < readers.size(); i++)
+            func(readers[i]);
+    }
+
+    /** Remove the readers that were not seen within the reader timeout.
+     *
+     * @param now The current time in ms.
+    */
+    void expire(uint32_t now)
+    {
+        for (size_t i = 0; i < readers.size();)
+        {
+            if (now - readers[i].lastSeen > readerTimeout)
+                readers.erase(readers.begin() + i);
+            else
+                i++;
+        }
+    }
+
+    /** Get the number of pending (and in flight) attendance records. */
+    size_t pendingRecordCount() { return pendingRecords; }
+
+    /** Get the number of pending state values. */
+    size_t pendingStateCount() { return states.size(); }
+
+    /** Get the number of known readers. */
+    size_t readerCount() { return readers.size(); }
+
+    /** Get the statistics. */
+    const stats_t &stats() { return stat; }
+
+    /** Build the attendance frame (on the reader).
+     *
+     * @param frame The output frame.
+     * @param device The device index of reader.
+     * @param seq The sequence number.
+     * @param recs The records.
+     * @param count The number of records, up to 50.
+    */
+    static void attendanceFrame(std::vector<uint8_t> &frame, uint8_t device, uint16_t seq, const AttendanceCodec::record_t *recs, size_t count)
+    {
+        header(frame, frame_attendance, device, seq);
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t pos = frame.size();
+            frame.resize(pos + ATTENDANCE_RECORD_SIZE);
+            AttendanceCodec::encode(recs[i], frame.data() + pos);
+        }
+    }
+
+    /** Build the state frame (on the reader).
+     *
+     * @param frame The output frame.
+     * @param device The device index of reader.
+     * @param seq The sequence number.
+     * @param name The child name of the state node e.g. "12345678", without '/'.
+     * @param value The scalar JSON value e.g. "1" or "\"open\"".
+    */
+    static void stateFrame(std::vector<uint8_t> &frame, uint8_t device, uint16_t seq, const char *name, const char *value)
+    {
+        header(frame, frame_state, device, seq);
+        size_t len = strlen(name);
+        frame.push_back((uint8_t)len);
+        frame.insert(frame.end(), name, name + len);
+        frame.insert(frame.end(), value, value + strlen(value));
+    }
+
+    /** Build the hello frame (on the reader).
+     *
+     * @param frame The output frame.
+     * @param device The device index of reader.
+     * @param seq The sequence number.
+     * @param heartbeat Set to true for the heartbeat of the idle reader, false for the start.
+    */
+    static void helloFrame(std::vector<uint8_t> &frame, uint8_t device, uint16_t seq, bool heartbeat = false)
+    {
+        header(frame, frame_hello, device, seq);
+        frame.push_back(heartbeat ? hello_heartbeat : hello_start);
+    }
+
+    /** Append the tag to the frame (on the reader).
+     *
+     * @param frame The frame from attendanceFrame, stateFrame or helloFrame.
+     * @param key The 16 bytes key of reader.
+     * @param session The session from the ack of the start hello, or 0 for the start hello.
+    */
+    static void sign(std::vector<uint8_t> &frame, const uint8_t *key, uint32_t session)
+    {
+        uint64_t t = tag(key, session, frame.data(), frame.size());
+        for (int i = 0; i < EDGE_GATEWAY_TAG_SIZE; i++)
+            frame.push_back((t >> (8 * i)) & 0xff);
+    }
+
+    /** Check the tag of the frame from the gateway (on the reader).
+     *
+     * @param buf The frame data.
+     * @param len The length of frame, it is set to the length without the tag.
+     * @param key The 16 bytes key of reader.
+     * @param session The session of reader, or 0 for the ack of the start hello and the session ack.
+     * @return Boolean type status indicates the tag is valid.
+    */
+    static bool verify(const uint8_t *buf, size_t &len, const uint8_t *key, uint32_t session)
+    {
+        if (len < EDGE_GATEWAY_HEADER_SIZE + EDGE_GATEWAY_TAG_SIZE || !checkTag(buf, len - EDGE_GATEWAY_TAG_SIZE, key, session))
+            return false;
+        len -= EDGE_GATEWAY_TAG_SIZE;
+        return true;
+    }
+
+    /** Get the SipHash-2-4 of the session and the data.
+     *
+     * @param key The 16 bytes key.
+     * @param session The session that is hashed as the first 4 bytes.
+     * @param data The data.
+     * @param len The length of data.
+     * @return The 64 bits hash.
+    */
+    static uint64_t tag(const uint8_t *key, uint32_t session, const uint8_t *data, size_t len)
+    {
+        uint64_t k0 = 0, k1 = 0;
+        for (int i = 7; i >= 0; i--)
+        {
+            k0 = (k0 << 8) | key[i];
+            k1 = (k1 << 8) | key[8 + i];
+        }
+
+        uint64_t v[4] = {k0 ^ 0x736f6d6570736575ULL, k1 ^ 0x646f72616e646f6dULL, k0 ^ 0x6c7967656e657261ULL, k1 ^ 0x7465646279746573ULL};
+        uint64_t m = 0;
+        size_t total = len + 4;
+
+        for (size_t i = 0; i < total; i++)
+        {
+            uint8_t b = i < 4 ? (session >> (8 * i)) & 0xff : data[i - 4];
+            m |= (uint64_t)b << (8 * (i & 7));
+            if ((i & 7) == 7)
+            {
+                sipCompress(v, m);
+                m = 0;
+            }
+        }
+
+        sipCompress(v, m | ((uint64_t)(total & 0xff) << 56));
+        v[2] ^= 0xff;
+        for (int i = 0; i < 4; i++)
+            sipRound(v);
+        return v[0] ^ v[1] ^ v[2] ^ v[3];
+    }
+
+    /** Parse the ack frame (on the reader).
+     *
+     * @param buf The frame data without the tag.
+     * @param len The length of frame.
+     * @param seq The sequence number of acknowledged frame.
+     * @param status The ack_status_t value.
+     * @param session The new session from the ack of the start hello, unchanged for the other acks.
+     * @return Boolean type status indicates the frame is the valid ack.
+    */
+    static bool parseAck(const uint8_t *buf, size_t len, uint16_t &seq, uint8_t &status, uint32_t *session = nullptr)
+    {
+        if ((len != EDGE_GATEWAY_HEADER_SIZE + 1 && len != EDGE_GATEWAY_HEADER_SIZE + 5) || buf[0] != EDGE_GATEWAY_MAGIC || buf[1] != frame_ack)
+            return false;
+        seq = buf[3] | (buf[4] << 8);
+        status = buf[5];
+        if (session && len == EDGE_GATEWAY_HEADER_SIZE + 5)
+            *session = buf[6] | (buf[7] << 8) | ((uint32_t)buf[8] << 16) | ((uint32_t)buf[9] << 24);
+        return true;
+    }
+
+    /** Parse the downlink frame (on the reader).
+     *
+     * @param buf The frame data without the tag.
+     * @param len The length of frame.
+     * @param op The downlink_op_t value.
+     * @param path The path relative to the subscribed node.
+     * @param json The JSON data.
+     * @param seq The sequence number of downlink.
+     * @return Boolean type status indicates the frame is the valid downlink.
+    */
+    static bool parseDownlink(const uint8_t *buf, size_t len, uint8_t &op, std::string &path, std::string &json, uint16_t *seq = nullptr)
+    {
+        if (len < EDGE_GATEWAY_HEADER_SIZE + 2 || buf[0] != EDGE_GATEWAY_MAGIC || buf[1] != frame_downlink)
+            return false;
+
+        size_t pathLen = buf[EDGE_GATEWAY_HEADER_SIZE + 1];
+        size_t pos = EDGE_GATEWAY_HEADER_SIZE + 2;
+        if (pos + pathLen > len)
+            return false;
+
+        op = buf[EDGE_GATEWAY_HEADER_SIZE];
+        if (seq)
+            *seq = buf[3] | (buf[4] << 8);
+        path.assign((const char *)buf + pos, pathLen);
+        json.assign((const char *)buf + pos + pathLen, len - pos - pathLen);
+        return true;
+    }
+
+protected:
+    struct batch_t
+    {
+        uint32_t bucket = 0;
+        std::string key;
+        std::vector<uint8_t> data;
+        bool inflight = false;
+    };
+
+    std::vector<reader_t> readers;
+    std::map<uint8_t, std::vector<uint8_t>> keys;
+    std::vector<batch_t> batches;
+    std::map<std::string, std::string> states;
+    std::map<std::string, std::string> inflightStates;
+    std::string eventsNode = "events";
+    std::string stateNode = "users";
+    uint32_t bucketSeconds = DEFAULT_ATTENDANCE_BUCKET_SECONDS;
+    size_t batchRecords = DEFAULT_EDGE_GATEWAY_BATCH_RECORDS;
+    uint32_t interval = DEFAULT_EDGE_GATEWAY_INTERVAL;
+    size_t maxRecords = DEFAULT_EDGE_GATEWAY_MAX_RECORDS;
+    size_t maxStates = DEFAULT_EDGE_GATEWAY_MAX_STATES;
+    size_t maxBody = DEFAULT_EDGE_GATEWAY_MAX_BODY;
+    uint32_t readerTimeout = DEFAULT_EDGE_GATEWAY_READER_TIMEOUT;
+    size_t pendingRecords = 0;
+    uint32_t lastFlush = 0;
+    uint16_t downlinkSeq = 0;
+    uint32_t sessionSeed = 0;
+    bool failed = false;
+    stats_t stat;
+
+    bool hasPending() { return states.size() > 0 || hasPendingRecords(); }
+
+    bool hasPendingRecords()
+    {
+        for (size_t i = 0; i < batches.size(); i++)
+        {
+            if (!batches[i].inflight)
+                return true;
+        }
+        return false;
+    }
+
+    reader_t *find(uint8_t device)
+    {
+        for (size_t i = 0; i < readers.size(); i++)
+        {
+            if (readers[i].device == device)
+                return &readers[i];
+        }
+        return nullptr;
+    }
+
+    reader_t *reader(uint8_t device, const endpoint_t &from, uint32_t now)
+    {
+        reader_t *r = find(device);
+
+        if (!r)
+        {
+            readers.push_back(reader_t());
+            r = &readers.back();
+            r->device = device;
+        }
+
+        r->endpoint = from;
+        r->lastSeen = now;
+        return r;
+    }
+
+    uint32_t newSession()
+    {
+        //the session 0 is for the start hello
+        do
+            sessionSeed = sessionSeed * 1664525 + 1013904223;
+        while (sessionSeed == 0);
+        return sessionSeed;
+    }
+
+    bool isDuplicate(const reader_t &r, uint16_t seq)
+    {
+        if (!r.seqValid)
+            return false;
+
+        int d = (int16_t)(seq - r.lastSeq);
+        if (d > 0)
+            return false;
+        if (-d >= EDGE_GATEWAY_SEQ_WINDOW)
+            return true;
+        return (r.window >> -d) & 1;
+    }
+
+    void markSeq(reader_t &r, uint16_t seq)
+    {
+        int d = (int16_t)(seq - r.lastSeq);
+
+        if (!r.seqValid || d > 0)
+        {
+            r.window = !r.seqValid || d >= EDGE_GATEWAY_SEQ_WINDOW ? 1 : (r.window << d) | 1;
+            r.lastSeq = seq;
+            r.seqValid = true;
+        }
+        else
+            r.window |= (uint64_t)1 << -d;
+    }
+
+    void addRecord(const AttendanceCodec::record_t &rec)
+    {
+        uint32_t bucket = rec.time - rec.time % bucketSeconds;
+        uint8_t buf[ATTENDANCE_RECORD_SIZE];
+        AttendanceCodec::encode(rec, buf);
+
+        batch_t *b = nullptr;
+        for (size_t i = 0; i < batches.size(); i++)
+        {
+            batch_t &c = batches[i];
+            if (c.bucket != bucket)
+                continue;
+
+            //the same tap that was sent again by the restarted reader
+            for (size_t j = 0; j < c.data.size(); j += ATTENDANCE_RECORD_SIZE)
+            {
+                if (memcmp(c.data.data() + j, buf, ATTENDANCE_RECORD_SIZE) == 0)
+                {
+                    stat.duplicates++;
+                    return;
+                }
+            }
+
+            if (!b && !c.inflight && c.data.size() < DEFAULT_ATTENDANCE_MAX_RECORDS * ATTENDANCE_RECORD_SIZE)
+                b = &c;
+        }
+
+        if (!b)
+        {
+            batches.push_back(batch_t());
+            b = &batches.back();
+            b->bucket = bucket;
+        }
+
+        b->data.insert(b->data.end(), buf, buf + ATTENDANCE_RECORD_SIZE);
+        pendingRecords++;
+        stat.records++;
+    }
+
+    bool parseState(const uint8_t *payload, size_t plen, const char *&path, size_t &pathLen, const char *&value, size_t &valueLen)
+    {
+        if (plen < 2)
+            return false;
+
+        pathLen = payload[0];
+        if (pathLen == 0 || pathLen > EDGE_GATEWAY_MAX_PATH || 1 + pathLen >= plen)
+            return false;
+
+        path = (const char *)payload + 1;
+        value = path + pathLen;
+        valueLen = plen - 1 - pathLen;
+
+        //the single child name, the values of the nested names could overlap in the update
+        for (size_t i = 0; i < pathLen; i++)
+        {
+            char c = path[i];
+            if (c <= ' ' || c > '~' || strchr("./#$[]\"\\", c))
+                return false;
+        }
+
+        //the state value at the update path must not replace the events node
+        if (stateNode.length() == 0 && eventsNode.compare(0, eventsNode.find('/'), path, pathLen) == 0)
+            return false;
+
+        return isScalar(value, valueLen);
+    }
+
+    //the value must be valid to not fail the whole update
+    static bool isScalar(const char *s, size_t len)
+    {
+        if ((len == 4 && (memcmp(s, "null", 4) == 0 || memcmp(s, "true", 4) == 0)) || (len == 5 && memcmp(s, "false", 5) == 0))
+            return true;
+
+        if (len >= 2 && s[0] == '"')
+            return valueEnd(s, 0, len) == len;
+
+        size_t i = 0;
+        if (i < len && s[i] == '-')
+            i++;
+        size_t start = i;
+        while (i < len && s[i] >= '0' && s[i] <= '9')
+            i++;
+        if (i == start || (s[start] == '0' && i - start > 1))
+            return false;
+        if (i < len && s[i] == '.')
+        {
+            start = ++i;
+            while (i < len && s[i] >= '0' && s[i] <= '9')
+                i++;
+            if (i == start)
+                return false;
+        }
+        if (i < len && (s[i] == 'e' || s[i] == 'E'))
+        {
+            i++;
+            if (i < len && (s[i] == '+' || s[i] == '-'))
+                i++;
+            start = i;
+            while (i < len && s[i] >= '0' && s[i] <= '9')
+                i++;
+            if (i == start)
+                return false;
+        }
+        return i == len;
+    }
+
+    static size_t skipSpace(const char *s, size_t i, size_t len)
+    {
+        while (i < len && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n'))
+            i++;
+        return i;
+    }
+
+    //get the end position of the JSON value that begins at i, or i when it is not valid
+    static size_t valueEnd(const char *s, size_t i, size_t len)
+    {
+        if (i >= len)
+            return i;
+
+        if (s[i] == '"')
+        {
+            for (size_t j = i + 1; j < len; j++)
+            {
+                if ((uint8_t)s[j] < 0x20)
+                    return i;
+                if (s[j] == '\\')
+                    j++;
+                else if (s[j] == '"')
+                    return j + 1;
+            }
+            return i;
+        }
+
+        if (s[i] == '{' || s[i] == '[')
+        {
+            int depth = 0;
+            for (size_t j = i; j < len; j++)
+            {
+                if (s[j] == '"')
+                {
+                    size_t e = valueEnd(s, j, len);
+                    if (e == j)
+                        return i;
+                    j = e - 1;
+                }
+                else if (s[j] == '{' || s[j] == '[')
+                    depth++;
+                else if ((s[j] == '}' || s[j] == ']') && --depth == 0)
+                    return j + 1;
+            }
+            return i;
+        }
+
+        size_t j = i;
+        while (j < len && s[j] != ',' && s[j] != '}' && s[j] != ']' && s[j] != ' ' && s[j] != '\t' && s[j] != '\r' && s[j] != '\n')
+            j++;
+        return j;
+    }
+
+    void addKey(std::string &body, size_t &count, const std::string &node)
+    {
+        if (count++ > 0)
+            body += ',';
+        body += '"';
+        if (node.length() > 0)
+        {
+            body += node;
+            body += '/';
+        }
+    }
+
+    static void header(std::vector<uint8_t> &frame, uint8_t type, uint8_t device, uint16_t seq)
+    {
+        frame.clear();
+        frame.push_back(EDGE_GATEWAY_MAGIC);
+        frame.push_back(type);
+        frame.push_back(device);
+        frame.push_back(seq & 0xff);
+        frame.push_back(seq >> 8);
+    }
+
+    static bool makeAck(std::vector<uint8_t> &reply, const uint8_t *key, uint32_t session, uint8_t device, uint16_t seq, uint8_t status)
+    {
+        header(reply, frame_ack, device, seq);
+        reply.push_back(status);
+        sign(reply, key, session);
+        return true;
+    }
+
+    static bool checkTag(const uint8_t *buf, size_t len, const uint8_t *key, uint32_t session)
+    {
+        uint64_t t = tag(key, session, buf, len), u = 0;
+        for (int i = EDGE_GATEWAY_TAG_SIZE - 1; i >= 0; i--)
+            u = (u << 8) | buf[len + i];
+        return (t ^ u) == 0;
+    }
+
+    static uint64_t rotl(uint64_t x, int b) { return (x << b) | (x >> (64 - b)); }
+
+    static void sipRound(uint64_t *v)
+    {
+        v[0] += v[1];
+        v[1] = rotl(v[1], 13) ^ v[0];
+        v[0] = rotl(v[0], 32);
+        v[2] += v[3];
+        v[3] = rotl(v[3], 16) ^ v[2];
+        v[0] += v[3];
+        v[3] = rotl(v[3], 21) ^ v[0];
+        v[2] += v[1];
+        v[1] = rotl(v[1], 17) ^ v[2];
+        v[2] = rotl(v[2], 32);
+    }
+
+    static void sipCompress(uint64_t *v, uint64_t m)
+    {
+        v[3] ^= m;
+        sipRound(v);
+        sipRound(v);
+        v[0] ^= m;
+    }
+};
+
+#if defined(ESP8266) || defined(ESP32)
+
+#include "FirebaseFS.h"
+
+#ifdef ENABLE_RTDB
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+
+#if defined(ESP32)
+#if defined(FIREBASE_ESP32_CLIENT)
+#include <FirebaseESP32.h>
+#endif
+#elif defined(ESP8266)
+#if defined(FIREBASE_ESP8266_CLIENT)
+#include <FirebaseESP8266.h>
+#endif
+#endif
+
+#if defined(FIREBASE_ESP_CLIENT)
+#include <Firebase_ESP_Client.h>
+#endif
+
+class EdgeGateway : public EdgeGatewayCore
+{
+public:
+    EdgeGateway(){};
+    ~EdgeGateway(){};
+
+    /** Start listening for the reader frames.
+     *
+     * @param fbdo Firebase Data Object to hold data and instance for the updates.
+     * @param path The path of the update e.g. "/" for the events and users nodes at the root.
+     * @param port The UDP port to listen.
+     * @return Boolean type status indicates the success of the operation.
+     *
+     * @note Set the key of each reader with setReaderKey.
+    */
+    bool begin(FirebaseData &fbdo, const char *path, uint16_t port = DEFAULT_EDGE_GATEWAY_PORT)
+    {
+        this->fbdo = &fbdo;
+        this->path = path;
+        lastFlush = millis();
+        //the hardware random number, the sessions of the earlier start are not accepted
+        sessionSeed ^= (uint32_t)random(0x7fffffff) ^ micros();
+        return udp.begin(port) == 1;
+    }
+
+    /** Send the stream events of the node to all readers.
+     *
+     * @param stream Firebase Data Object for the stream, separated from the one for the updates.
+     * @param snapshot Firebase Data Object to read the node for the started readers, separated from
+     * the ones for the updates and the stream.
+     * @param path The path of the node e.g. "/allowlist".
+     * @return Boolean type status indicates the success of the operation.
+     *
+     * @note The failed snapshot read is retried after the batch interval.
+    */
+    bool subscribe(FirebaseData &stream, FirebaseData &snapshot, const char *path)
+    {
+        this->stream = &stream;
+        this->snapshot = &snapshot;
+        streamPath = path;
+#if defined(FIREBASE_ESP_CLIENT)
+        return Firebase.RTDB.beginStream(&stream, path);
+#else
+        return Firebase.beginStream(stream, path);
+#endif
+    }
+
+    /** Receive the reader frames, send the stream events and the update, call this in the loop. */
+    void loop()
+    {
+        uint32_t now = millis();
+
+        receive(now);
+
+        if (stream)
+        {
+            readStream();
+            sendSnapshots(now);
+        }
+
+        expire(now);
+
+        if (fbdo && ready(now))
+            flush();
+    }
+
+    /** Write the pending data now.
+     *
+     * @return Boolean type status indicates the success of the operation.
+     *
+     * @note The attendance records and the state values are written with the separate updates.
+    */
+    bool flush()
+    {
+        std::string body;
+        bool ret = true;
+
+        if (buildUpdate(body, [this]() {
+                String key;
+#if defined(FIREBASE_ESP_CLIENT)
+                Firebase.RTDB.newPushID(fbdo, key);
+#else
+                Firebase.newPushID(*fbdo, key);
+#endif
+                return std::string(key.c_str());
+            }))
+            ret = update(body);
+        else if (hasPendingRecords())
+            ret = false; //the push key error is in fbdo
+
+        if (buildStateUpdate(body))
+        {
+            bool records = ret;
+            ret = update(body) && ret;
+            //the failed records update is still retried after the interval
+            failed |= !records;
+        }
+
+        return ret;
+    }
+
+private:
+    WiFiUDP udp;
+    FirebaseData *fbdo = nullptr;
+    FirebaseData *stream = nullptr;
+    FirebaseData *snapshot = nullptr;
+    MB_String path;
+    MB_String streamPath;
+    std::vector<uint8_t> reply;
+    uint32_t snapshotMillis = 0;
+    bool snapshotFailed = false;
+
+    bool update(const std::string &body)
+    {
+        FirebaseJson json;
+        bool ret = json.setJsonData(body.c_str());
+
+#if defined(FIREBASE_ESP_CLIENT)
+        ret = ret && Firebase.RTDB.updateNodeSilent(fbdo, path.c_str(), &json);
+#else
+        ret = ret && Firebase.updateNodeSilent(*fbdo, path.c_str(), json);
+#endif
+        commit(ret, millis());
+        return ret;
+    }
+
+    void receive(uint32_t now)
+    {
+        uint8_t buf[EDGE_GATEWAY_MAX_FRAME];
+
+        //limit the frames per loop to keep the stream and the update going
+        for (int i = 0; i < 32; i++)
+        {
+            int len = udp.parsePacket();
+            if (len <= 0)
+                break;
+
+            if (len > EDGE_GATEWAY_MAX_FRAME)
+            {
+                stat.invalid++;
+                continue;
+            }
+
+            endpoint_t ep;
+            ep.ip = (uint32_t)udp.remoteIP();
+            ep.port = udp.remotePort();
+
+            if (handleFrame(buf, udp.read(buf, len), ep, now, reply))
+                send(ep, reply.data(), reply.size());
+        }
+    }
+
+    void readStream()
+    {
+#if defined(FIREBASE_ESP_CLIENT)
+        if (!Firebase.RTDB.readStream(stream) || !stream->streamAvailable())
+#else
+        if (!Firebase.readStream(*stream) || !stream->streamAvailable())
+#endif
+            return;
+
+        String type = stream->eventType();
+        String dataPath = stream->dataPath();
+        String data = stream->payload();
+        const char *p = dataPath.c_str();
+        while (*p == '/')
+            p++;
+
+        makeDownlink(type == "patch" ? op_patch : op_put, p, data.c_str(), data.length(), [&](const uint8_t *frame, size_t len)
+                     { forEachReader([&](reader_t &r)
+                                     { sendFrame(r, frame, len); }); });
+    }
+
+    void sendSnapshots(uint32_t now)
+    {
+        bool pending = false;
+        forEachReader([&](reader_t &r)
+                      { pending |= r.snapshot; });
+
+        if (!pending || !snapshot || (snapshotFailed && now - snapshotMillis < interval))
+            return;
+
+        //one read for all readers that were started
+#if defined(FIREBASE_ESP_CLIENT)
+        snapshotFailed = !Firebase.RTDB.get(snapshot, streamPath.c_str());
+#else
+        snapshotFailed = !Firebase.get(*snapshot, streamPath.c_str());
+#endif
+        snapshotMillis = now;
+        if (snapshotFailed)
+            return;
+
+        String data = snapshot->payload();
+        forEachReader([&](reader_t &r)
+                      {
+                          if (!r.snapshot)
+                              return;
+                          r.snapshot = false;
+                          makeDownlink(op_put, "", data.c_str(), data.length(), [&](const uint8_t *frame, size_t len)
+                                       { sendFrame(r, frame, len); });
+                      });
+    }
+
+    void send(const endpoint_t &ep, const uint8_t *data, size_t len)
+    {
+        udp.beginPacket(IPAddress(ep.ip), ep.port);
+        udp.write(data, len);
+        udp.endPacket();
+    }
+
+    void sendFrame(const reader_t &r, const uint8_t *frame, size_t len)
+    {
+        if (signFrame(r, frame, len, reply))
+            send(r.endpoint, reply.data(), reply.size());
+    }
+};
+
+#endif
+
+#endif
+
+#endif
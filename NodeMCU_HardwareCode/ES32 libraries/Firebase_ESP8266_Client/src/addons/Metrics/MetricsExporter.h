@@ -0,0 +1,175 @@
+/**
+ * MetricsExporter
+ *
+ * The periodic exporter of the request metrics of the Firebase Data object to Serial (or other Print)
+ * or to the database node.
+ *
+ * The metrics are collected only when ENABLE_FB_METRICS was defined in FirebaseFS.h.
+ *
+ * Use the separate Firebase Data object as the target of the database export, the export request
+ * is then not counted in the metrics of the source object.
+ *
+ * The exported node is
+ * requests, errors, handshakes, handshakeErrors, handshakeMs, reconnects, retries, bytesOut, bytesIn,
+ * heapMin, latencyMs, p50, p90, p99, max, last/<phase> and total/<phase> (ms) of the phases
+ * token, connect, send, wait and receive.
+ *
+ * This work is an extension of the Firebase ESP Client library by K. Suwatchai (Mobizt)
+ * Copyright (c) 2026 RFID Door Lock System contributors
+ *
+ * The MIT License (MIT)
+*/
+
+#ifndef MetricsExporter_H
+#define MetricsExporter_H
+
+#if defined(ESP8266) || defined(ESP32)
+
+#include "FirebaseFS.h"
+
+#if defined(ENABLE_RTDB) && defined(ENABLE_FB_METRICS)
+
+#include <Arduino.h>
+
+#if defined(ESP32)
+#if defined(FIREBASE_ESP32_CLIENT)
+#include <FirebaseESP32.h>
+#endif
+#elif defined(ESP8266)
+#if defined(FIREBASE_ESP8266_CLIENT)
+#include <FirebaseESP8266.h>
+#endif
+#endif
+
+#if defined(FIREBASE_ESP_CLIENT)
+#include <Firebase_ESP_Client.h>
+#endif
+
+class FirebaseMetricsExporter
+{
+public:
+    FirebaseMetricsExporter(){};
+    ~FirebaseMetricsExporter(){};
+
+    /** Print the metrics of the Firebase Data object periodically.
+     *
+     * @param source The Firebase Data object which its metrics to export.
+     * @param out The Print object e.g. Serial.
+     * @param interval The export interval in ms.
+    */
+    void begin(FirebaseData &source, Print &out, uint32_t interval)
+    {
+        this->source = &source;
+        this->out = &out;
+        this->target = nullptr;
+        this->interval = interval;
+        lastMillis = millis();
+    }
+
+    /** Write the metrics of the Firebase Data object to the database node periodically.
+     *
+     * @param source The Firebase Data object which its metrics to export.
+     * @param target The Firebase Data object to write the metrics.
+     * @param path The path to the node to write.
+     * @param interval The export interval in ms.
+    */
+    void begin(FirebaseData &source, FirebaseData &target, const char *path, uint32_t interval)
+    {
+        this->source = &source;
+        this->out = nullptr;
+        this->target = &target;
+        this->path = path;
+        this->interval = interval;
+        lastMillis = millis();
+    }
+
+    /** Export the metrics when the interval was passed, call this in the loop.
+     *
+     * @return Boolean type status indicates the metrics were exported.
+    */
+    bool loop()
+    {
+        if (!source || millis() - lastMillis < interval)
+            return false;
+
+        lastMillis = millis();
+        return exportNow();
+    }
+
+    /** Export the metrics now.
+     *
+     * @return Boolean type status indicates the success of the operation.
+    */
+    bool exportNow()
+    {
+        if (!source)
+            return false;
+
+        if (out)
+        {
+            source->metrics().printTo(*out);
+            return true;
+        }
+
+        if (!target)
+            return false;
+
+        FirebaseJson json;
+        toJson(source->metrics(), json);
+
+#if defined(FIREBASE_ESP_CLIENT)
+        return Firebase.RTDB.updateNodeSilent(target, path.c_str(), &json);
+#else
+        return Firebase.updateNodeSilent(*target, path.c_str(), json);
+#endif
+    }
+
+    /** Add the metrics to the FirebaseJson object.
+     *
+     * @param m The FirebaseMetrics object.
+     * @param json The FirebaseJson object.
+    */
+    static void toJson(FirebaseMetrics &m, FirebaseJson &json)
+    {
+        json.set("requests", (int)m.requests);
+        json.set("errors", (int)m.errors);
+        json.set("handshakes", (int)m.handshakes);
+        json.set("handshakeErrors", (int)m.handshake_errors);
+        json.set("handshakeMs", (int)m.handshake_ms);
+        json.set("reconnects", (int)m.reconnects);
+        json.set("retries", (int)m.retries);
+        json.set("bytesOut", (int)m.bytes_out);
+        json.set("bytesIn", (int)m.bytes_in);
+        json.set("heapMin", (int)(m.heap_min == 0xffffffff ? 0 : m.heap_min));
+        json.set("latencyMs", (int)m.latency_ms);
+        json.set("p50", (int)m.percentile(50));
+        json.set("p90", (int)m.percentile(90));
+        json.set("p99", (int)m.percentile(99));
+        json.set("max", (int)m.latency_max_ms);
+
+        MB_String node;
+        for (int i = 0; i < fb_esp_metrics_phase_max; i++)
+        {
+            node = "last/";
+            node += FirebaseMetrics::phaseName(i);
+            json.set(node.c_str(), (int)m.last_ms[i]);
+            node = "total/";
+            node += FirebaseMetrics::phaseName(i);
+            json.set(node.c_str(), (int)m.total_ms[i]);
+        }
+    }
+
+private:
+    FirebaseData *source = nullptr;
+    FirebaseData *target = nullptr;
+    Print *out = nullptr;
+    MB_String path;
+    uint32_t interval = 60000;
+    unsigned long lastMillis = 0;
+};
+
+#endif
+
+#endif
+
+#endif
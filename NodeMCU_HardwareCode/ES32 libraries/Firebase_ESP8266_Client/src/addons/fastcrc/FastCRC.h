@@ -42,10 +42,14 @@
 // Set this to 0 for smaller 32BIT-CRC-Tables:
 #define CRC_BIGTABLES 1
 
+// Set this to 0 to use slicing-by-4 only (saves 8KB of 32BIT-CRC-Tables, requires CRC_BIGTABLES):
+#define CRC_SLICING8 1
+
 
 #if !defined(FastCRC_h)
 #define FastCRC_h
 #include "inttypes.h"
+#include <stddef.h>
 
 
 // ================= DEFINES ===================
@@ -132,23 +136,38 @@ private:
 
 // ================= 32-BIT CRC ===================
 
+#if CRC_SW
+// Running state of one 32-Bit CRC, many of them can be calculated at the same time
+struct FastCRC32_Context
+{
+  uint32_t crc;       // Running CRC value (before final XOR)
+  size_t length;      // Number of bytes processed
+  bool cksum;         // CRC-32/POSIX when true, CRC-32 otherwise
+};
+#endif
+
 class FastCRC32
 {
 public:
   FastCRC32();
-  uint32_t crc32(const uint8_t *data, const uint16_t datalen);		// Alias CRC-32/ADCCP, PKZIP, Ethernet, 802.3
-  uint32_t cksum(const uint8_t *data, const uint16_t datalen);		// Alias CRC-32/POSIX
+  uint32_t crc32(const uint8_t *data, const size_t datalen);		// Alias CRC-32/ADCCP, PKZIP, Ethernet, 802.3
+  uint32_t cksum(const uint8_t *data, const size_t datalen);		// Alias CRC-32/POSIX
 
-  uint32_t crc32_upd(const uint8_t *data, uint16_t len);			// Call for subsequent calculations with previous seed
-  uint32_t cksum_upd(const uint8_t *data, uint16_t len);			// Call for subsequent calculations with previous seed
-#if !CRC_SW
-  uint32_t generic(const uint32_t polyom, const uint32_t seed, const uint32_t flags, const uint8_t *data, const uint16_t datalen); //Not available in non-hw-variant (not T3.x)
+  uint32_t crc32_upd(const uint8_t *data, size_t len);			// Call for subsequent calculations with previous seed
+  uint32_t cksum_upd(const uint8_t *data, size_t len);			// Call for subsequent calculations with previous seed
+#if CRC_SW
+  void crc32_begin(FastCRC32_Context &ctx);					// Start a CRC-32 stream
+  void cksum_begin(FastCRC32_Context &ctx);					// Start a CRC-32/POSIX stream
+  void update(FastCRC32_Context &ctx, const uint8_t *data, size_t len);	// Add the data to the stream
+  uint32_t result(const FastCRC32_Context &ctx);				// CRC value of the data streamed so far
+#else
+  uint32_t generic(const uint32_t polyom, const uint32_t seed, const uint32_t flags, const uint8_t *data, const size_t datalen); //Not available in non-hw-variant (not T3.x)
 #endif
 private:
 #if CRC_SW
   uint32_t seed;
 #else
-  uint32_t update(const uint8_t *data, const uint16_t datalen);
+  uint32_t update(const uint8_t *data, const size_t datalen);
 #endif
 };
 
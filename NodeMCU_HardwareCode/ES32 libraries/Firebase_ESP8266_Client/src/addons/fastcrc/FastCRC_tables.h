@@ -1579,4 +1579,524 @@ const uint32_t crc_table_cksum_big[1024] PROGMEM = {
 	0x105ee293, 0xa7c48f4f, 0xc976f82f, 0x7eec95f3,
 	0x151217ef, 0xa2887a33, 0xcc3a0d53, 0x7ba0608f
 };
+
+// Slices 4 to 7 of crc_table_crc32_big, used for slicing-by-8
+const uint32_t crc_table_crc32_big8[1024] PROGMEM = {
+	0x00000000, 0x3d6029b0, 0x7ac05360, 0x47a07ad0,
+	0xf580a6c0, 0xc8e08f70, 0x8f40f5a0, 0xb220dc10,
+	0x30704bc1, 0x0d106271, 0x4ab018a1, 0x77d03111,
+	0xc5f0ed01, 0xf890c4b1, 0xbf30be61, 0x825097d1,
+	0x60e09782, 0x5d80be32, 0x1a20c4e2, 0x2740ed52,
+	0x95603142, 0xa80018f2, 0xefa06222, 0xd2c04b92,
+	0x5090dc43, 0x6df0f5f3, 0x2a508f23, 0x1730a693,
+	0xa5107a83, 0x98705333, 0xdfd029e3, 0xe2b00053,
+	0xc1c12f04, 0xfca106b4, 0xbb017c64, 0x866155d4,
+	0x344189c4, 0x0921a074, 0x4e81daa4, 0x73e1f314,
+	0xf1b164c5, 0xccd14d75, 0x8b7137a5, 0xb6111e15,
+	0x0431c205, 0x3951ebb5, 0x7ef19165, 0x4391b8d5,
+	0xa121b886, 0x9c419136, 0xdbe1ebe6, 0xe681c256,
+	0x54a11e46, 0x69c137f6, 0x2e614d26, 0x13016496,
+	0x9151f347, 0xac31daf7, 0xeb91a027, 0xd6f18997,
+	0x64d15587, 0x59b17c37, 0x1e1106e7, 0x23712f57,
+	0x58f35849, 0x659371f9, 0x22330b29, 0x1f532299,
+	0xad73fe89, 0x9013d739, 0xd7b3ade9, 0xead38459,
+	0x68831388, 0x55e33a38, 0x124340e8, 0x2f236958,
+	0x9d03b548, 0xa0639cf8, 0xe7c3e628, 0xdaa3cf98,
+	0x3813cfcb, 0x0573e67b, 0x42d39cab, 0x7fb3b51b,
+	0xcd93690b, 0xf0f340bb, 0xb7533a6b, 0x8a3313db,
+	0x0863840a, 0x3503adba, 0x72a3d76a, 0x4fc3feda,
+	0xfde322ca, 0xc0830b7a, 0x872371aa, 0xba43581a,
+	0x9932774d, 0xa4525efd, 0xe3f2242d, 0xde920d9d,
+	0x6cb2d18d, 0x51d2f83d, 0x167282ed, 0x2b12ab5d,
+	0xa9423c8c, 0x9422153c, 0xd3826fec, 0xeee2465c,
+	0x5cc29a4c, 0x61a2b3fc, 0x2602c92c, 0x1b62e09c,
+	0xf9d2e0cf, 0xc4b2c97f, 0x8312b3af, 0xbe729a1f,
+	0x0c52460f, 0x31326fbf, 0x7692156f, 0x4bf23cdf,
+	0xc9a2ab0e, 0xf4c282be, 0xb362f86e, 0x8e02d1de,
+	0x3c220dce, 0x0142247e, 0x46e25eae, 0x7b82771e,
+	0xb1e6b092, 0x8c869922, 0xcb26e3f2, 0xf646ca42,
+	0x44661652, 0x79063fe2, 0x3ea64532, 0x03c66c82,
+	0x8196fb53, 0xbcf6d2e3, 0xfb56a833, 0xc6368183,
+	0x74165d93, 0x49767423, 0x0ed60ef3, 0x33b62743,
+	0xd1062710, 0xec660ea0, 0xabc67470, 0x96a65dc0,
+	0x248681d0, 0x19e6a860, 0x5e46d2b0, 0x6326fb00,
+	0xe1766cd1, 0xdc164561, 0x9bb63fb1, 0xa6d61601,
+	0x14f6ca11, 0x2996e3a1, 0x6e369971, 0x5356b0c1,
+	0x70279f96, 0x4d47b626, 0x0ae7ccf6, 0x3787e546,
+	0x85a73956, 0xb8c710e6, 0xff676a36, 0xc2074386,
+	0x4057d457, 0x7d37fde7, 0x3a978737, 0x07f7ae87,
+	0xb5d77297, 0x88b75b27, 0xcf1721f7, 0xf2770847,
+	0x10c70814, 0x2da721a4, 0x6a075b74, 0x576772c4,
+	0xe547aed4, 0xd8278764, 0x9f87fdb4, 0xa2e7d404,
+	0x20b743d5, 0x1dd76a65, 0x5a7710b5, 0x67173905,
+	0xd537e515, 0xe857cca5, 0xaff7b675, 0x92979fc5,
+	0xe915e8db, 0xd475c16b, 0x93d5bbbb, 0xaeb5920b,
+	0x1c954e1b, 0x21f567ab, 0x66551d7b, 0x5b3534cb,
+	0xd965a31a, 0xe4058aaa, 0xa3a5f07a, 0x9ec5d9ca,
+	0x2ce505da, 0x11852c6a, 0x562556ba, 0x6b457f0a,
+	0x89f57f59, 0xb49556e9, 0xf3352c39, 0xce550589,
+	0x7c75d999, 0x4115f029, 0x06b58af9, 0x3bd5a349,
+	0xb9853498, 0x84e51d28, 0xc34567f8, 0xfe254e48,
+	0x4c059258, 0x7165bbe8, 0x36c5c138, 0x0ba5e888,
+	0x28d4c7df, 0x15b4ee6f, 0x521494bf, 0x6f74bd0f,
+	0xdd54611f, 0xe03448af, 0xa794327f, 0x9af41bcf,
+	0x18a48c1e, 0x25c4a5ae, 0x6264df7e, 0x5f04f6ce,
+	0xed242ade, 0xd044036e, 0x97e479be, 0xaa84500e,
+	0x4834505d, 0x755479ed, 0x32f4033d, 0x0f942a8d,
+	0xbdb4f69d, 0x80d4df2d, 0xc774a5fd, 0xfa148c4d,
+	0x78441b9c, 0x4524322c, 0x028448fc, 0x3fe4614c,
+	0x8dc4bd5c, 0xb0a494ec, 0xf704ee3c, 0xca64c78c,
+	0x00000000, 0xcb5cd3a5, 0x4dc8a10b, 0x869472ae,
+	0x9b914216, 0x50cd91b3, 0xd659e31d, 0x1d0530b8,
+	0xec53826d, 0x270f51c8, 0xa19b2366, 0x6ac7f0c3,
+	0x77c2c07b, 0xbc9e13de, 0x3a0a6170, 0xf156b2d5,
+	0x03d6029b, 0xc88ad13e, 0x4e1ea390, 0x85427035,
+	0x9847408d, 0x531b9328, 0xd58fe186, 0x1ed33223,
+	0xef8580f6, 0x24d95353, 0xa24d21fd, 0x6911f258,
+	0x7414c2e0, 0xbf481145, 0x39dc63eb, 0xf280b04e,
+	0x07ac0536, 0xccf0d693, 0x4a64a43d, 0x81387798,
+	0x9c3d4720, 0x57619485, 0xd1f5e62b, 0x1aa9358e,
+	0xebff875b, 0x20a354fe, 0xa6372650, 0x6d6bf5f5,
+	0x706ec54d, 0xbb3216e8, 0x3da66446, 0xf6fab7e3,
+	0x047a07ad, 0xcf26d408, 0x49b2a6a6, 0x82ee7503,
+	0x9feb45bb, 0x54b7961e, 0xd223e4b0, 0x197f3715,
+	0xe82985c0, 0x23755665, 0xa5e124cb, 0x6ebdf76e,
+	0x73b8c7d6, 0xb8e41473, 0x3e7066dd, 0xf52cb578,
+	0x0f580a6c, 0xc404d9c9, 0x4290ab67, 0x89cc78c2,
+	0x94c9487a, 0x5f959bdf, 0xd901e971, 0x125d3ad4,
+	0xe30b8801, 0x28575ba4, 0xaec3290a, 0x659ffaaf,
+	0x789aca17, 0xb3c619b2, 0x35526b1c, 0xfe0eb8b9,
+	0x0c8e08f7, 0xc7d2db52, 0x4146a9fc, 0x8a1a7a59,
+	0x971f4ae1, 0x5c439944, 0xdad7ebea, 0x118b384f,
+	0xe0dd8a9a, 0x2b81593f, 0xad152b91, 0x6649f834,
+	0x7b4cc88c, 0xb0101b29, 0x36846987, 0xfdd8ba22,
+	0x08f40f5a, 0xc3a8dcff, 0x453cae51, 0x8e607df4,
+	0x93654d4c, 0x58399ee9, 0xdeadec47, 0x15f13fe2,
+	0xe4a78d37, 0x2ffb5e92, 0xa96f2c3c, 0x6233ff99,
+	0x7f36cf21, 0xb46a1c84, 0x32fe6e2a, 0xf9a2bd8f,
+	0x0b220dc1, 0xc07ede64, 0x46eaacca, 0x8db67f6f,
+	0x90b34fd7, 0x5bef9c72, 0xdd7beedc, 0x16273d79,
+	0xe7718fac, 0x2c2d5c09, 0xaab92ea7, 0x61e5fd02,
+	0x7ce0cdba, 0xb7bc1e1f, 0x31286cb1, 0xfa74bf14,
+	0x1eb014d8, 0xd5ecc77d, 0x5378b5d3, 0x98246676,
+	0x852156ce, 0x4e7d856b, 0xc8e9f7c5, 0x03b52460,
+	0xf2e396b5, 0x39bf4510, 0xbf2b37be, 0x7477e41b,
+	0x6972d4a3, 0xa22e0706, 0x24ba75a8, 0xefe6a60d,
+	0x1d661643, 0xd63ac5e6, 0x50aeb748, 0x9bf264ed,
+	0x86f75455, 0x4dab87f0, 0xcb3ff55e, 0x006326fb,
+	0xf135942e, 0x3a69478b, 0xbcfd3525, 0x77a1e680,
+	0x6aa4d638, 0xa1f8059d, 0x276c7733, 0xec30a496,
+	0x191c11ee, 0xd240c24b, 0x54d4b0e5, 0x9f886340,
+	0x828d53f8, 0x49d1805d, 0xcf45f2f3, 0x04192156,
+	0xf54f9383, 0x3e134026, 0xb8873288, 0x73dbe12d,
+	0x6eded195, 0xa5820230, 0x2316709e, 0xe84aa33b,
+	0x1aca1375, 0xd196c0d0, 0x5702b27e, 0x9c5e61db,
+	0x815b5163, 0x4a0782c6, 0xcc93f068, 0x07cf23cd,
+	0xf6999118, 0x3dc542bd, 0xbb513013, 0x700de3b6,
+	0x6d08d30e, 0xa65400ab, 0x20c07205, 0xeb9ca1a0,
+	0x11e81eb4, 0xdab4cd11, 0x5c20bfbf, 0x977c6c1a,
+	0x8a795ca2, 0x41258f07, 0xc7b1fda9, 0x0ced2e0c,
+	0xfdbb9cd9, 0x36e74f7c, 0xb0733dd2, 0x7b2fee77,
+	0x662adecf, 0xad760d6a, 0x2be27fc4, 0xe0beac61,
+	0x123e1c2f, 0xd962cf8a, 0x5ff6bd24, 0x94aa6e81,
+	0x89af5e39, 0x42f38d9c, 0xc467ff32, 0x0f3b2c97,
+	0xfe6d9e42, 0x35314de7, 0xb3a53f49, 0x78f9ecec,
+	0x65fcdc54, 0xaea00ff1, 0x28347d5f, 0xe368aefa,
+	0x16441b82, 0xdd18c827, 0x5b8cba89, 0x90d0692c,
+	0x8dd55994, 0x46898a31, 0xc01df89f, 0x0b412b3a,
+	0xfa1799ef, 0x314b4a4a, 0xb7df38e4, 0x7c83eb41,
+	0x6186dbf9, 0xaada085c, 0x2c4e7af2, 0xe712a957,
+	0x15921919, 0xdececabc, 0x585ab812, 0x93066bb7,
+	0x8e035b0f, 0x455f88aa, 0xc3cbfa04, 0x089729a1,
+	0xf9c19b74, 0x329d48d1, 0xb4093a7f, 0x7f55e9da,
+	0x6250d962, 0xa90c0ac7, 0x2f987869, 0xe4c4abcc,
+	0x00000000, 0xa6770bb4, 0x979f1129, 0x31e81a9d,
+	0xf44f2413, 0x52382fa7, 0x63d0353a, 0xc5a73e8e,
+	0x33ef4e67, 0x959845d3, 0xa4705f4e, 0x020754fa,
+	0xc7a06a74, 0x61d761c0, 0x503f7b5d, 0xf64870e9,
+	0x67de9cce, 0xc1a9977a, 0xf0418de7, 0x56368653,
+	0x9391b8dd, 0x35e6b369, 0x040ea9f4, 0xa279a240,
+	0x5431d2a9, 0xf246d91d, 0xc3aec380, 0x65d9c834,
+	0xa07ef6ba, 0x0609fd0e, 0x37e1e793, 0x9196ec27,
+	0xcfbd399c, 0x69ca3228, 0x582228b5, 0xfe552301,
+	0x3bf21d8f, 0x9d85163b, 0xac6d0ca6, 0x0a1a0712,
+	0xfc5277fb, 0x5a257c4f, 0x6bcd66d2, 0xcdba6d66,
+	0x081d53e8, 0xae6a585c, 0x9f8242c1, 0x39f54975,
+	0xa863a552, 0x0e14aee6, 0x3ffcb47b, 0x998bbfcf,
+	0x5c2c8141, 0xfa5b8af5, 0xcbb39068, 0x6dc49bdc,
+	0x9b8ceb35, 0x3dfbe081, 0x0c13fa1c, 0xaa64f1a8,
+	0x6fc3cf26, 0xc9b4c492, 0xf85cde0f, 0x5e2bd5bb,
+	0x440b7579, 0xe27c7ecd, 0xd3946450, 0x75e36fe4,
+	0xb044516a, 0x16335ade, 0x27db4043, 0x81ac4bf7,
+	0x77e43b1e, 0xd19330aa, 0xe07b2a37, 0x460c2183,
+	0x83ab1f0d, 0x25dc14b9, 0x14340e24, 0xb2430590,
+	0x23d5e9b7, 0x85a2e203, 0xb44af89e, 0x123df32a,
+	0xd79acda4, 0x71edc610, 0x4005dc8d, 0xe672d739,
+	0x103aa7d0, 0xb64dac64, 0x87a5b6f9, 0x21d2bd4d,
+	0xe47583c3, 0x42028877, 0x73ea92ea, 0xd59d995e,
+	0x8bb64ce5, 0x2dc14751, 0x1c295dcc, 0xba5e5678,
+	0x7ff968f6, 0xd98e6342, 0xe86679df, 0x4e11726b,
+	0xb8590282, 0x1e2e0936, 0x2fc613ab, 0x89b1181f,
+	0x4c162691, 0xea612d25, 0xdb8937b8, 0x7dfe3c0c,
+	0xec68d02b, 0x4a1fdb9f, 0x7bf7c102, 0xdd80cab6,
+	0x1827f438, 0xbe50ff8c, 0x8fb8e511, 0x29cfeea5,
+	0xdf879e4c, 0x79f095f8, 0x48188f65, 0xee6f84d1,
+	0x2bc8ba5f, 0x8dbfb1eb, 0xbc57ab76, 0x1a20a0c2,
+	0x8816eaf2, 0x2e61e146, 0x1f89fbdb, 0xb9fef06f,
+	0x7c59cee1, 0xda2ec555, 0xebc6dfc8, 0x4db1d47c,
+	0xbbf9a495, 0x1d8eaf21, 0x2c66b5bc, 0x8a11be08,
+	0x4fb68086, 0xe9c18b32, 0xd82991af, 0x7e5e9a1b,
+	0xefc8763c, 0x49bf7d88, 0x78576715, 0xde206ca1,
+	0x1b87522f, 0xbdf0599b, 0x8c184306, 0x2a6f48b2,
+	0xdc27385b, 0x7a5033ef, 0x4bb82972, 0xedcf22c6,
+	0x28681c48, 0x8e1f17fc, 0xbff70d61, 0x198006d5,
+	0x47abd36e, 0xe1dcd8da, 0xd034c247, 0x7643c9f3,
+	0xb3e4f77d, 0x1593fcc9, 0x247be654, 0x820cede0,
+	0x74449d09, 0xd23396bd, 0xe3db8c20, 0x45ac8794,
+	0x800bb91a, 0x267cb2ae, 0x1794a833, 0xb1e3a387,
+	0x20754fa0, 0x86024414, 0xb7ea5e89, 0x119d553d,
+	0xd43a6bb3, 0x724d6007, 0x43a57a9a, 0xe5d2712e,
+	0x139a01c7, 0xb5ed0a73, 0x840510ee, 0x22721b5a,
+	0xe7d525d4, 0x41a22e60, 0x704a34fd, 0xd63d3f49,
+	0xcc1d9f8b, 0x6a6a943f, 0x5b828ea2, 0xfdf58516,
+	0x3852bb98, 0x9e25b02c, 0xafcdaab1, 0x09baa105,
+	0xfff2d1ec, 0x5985da58, 0x686dc0c5, 0xce1acb71,
+	0x0bbdf5ff, 0xadcafe4b, 0x9c22e4d6, 0x3a55ef62,
+	0xabc30345, 0x0db408f1, 0x3c5c126c, 0x9a2b19d8,
+	0x5f8c2756, 0xf9fb2ce2, 0xc813367f, 0x6e643dcb,
+	0x982c4d22, 0x3e5b4696, 0x0fb35c0b, 0xa9c457bf,
+	0x6c636931, 0xca146285, 0xfbfc7818, 0x5d8b73ac,
+	0x03a0a617, 0xa5d7ada3, 0x943fb73e, 0x3248bc8a,
+	0xf7ef8204, 0x519889b0, 0x6070932d, 0xc6079899,
+	0x304fe870, 0x9638e3c4, 0xa7d0f959, 0x01a7f2ed,
+	0xc400cc63, 0x6277c7d7, 0x539fdd4a, 0xf5e8d6fe,
+	0x647e3ad9, 0xc209316d, 0xf3e12bf0, 0x55962044,
+	0x90311eca, 0x3646157e, 0x07ae0fe3, 0xa1d90457,
+	0x579174be, 0xf1e67f0a, 0xc00e6597, 0x66796e23,
+	0xa3de50ad, 0x05a95b19, 0x34414184, 0x92364a30,
+	0x00000000, 0xccaa009e, 0x4225077d, 0x8e8f07e3,
+	0x844a0efa, 0x48e00e64, 0xc66f0987, 0x0ac50919,
+	0xd3e51bb5, 0x1f4f1b2b, 0x91c01cc8, 0x5d6a1c56,
+	0x57af154f, 0x9b0515d1, 0x158a1232, 0xd92012ac,
+	0x7cbb312b, 0xb01131b5, 0x3e9e3656, 0xf23436c8,
+	0xf8f13fd1, 0x345b3f4f, 0xbad438ac, 0x767e3832,
+	0xaf5e2a9e, 0x63f42a00, 0xed7b2de3, 0x21d12d7d,
+	0x2b142464, 0xe7be24fa, 0x69312319, 0xa59b2387,
+	0xf9766256, 0x35dc62c8, 0xbb53652b, 0x77f965b5,
+	0x7d3c6cac, 0xb1966c32, 0x3f196bd1, 0xf3b36b4f,
+	0x2a9379e3, 0xe639797d, 0x68b67e9e, 0xa41c7e00,
+	0xaed97719, 0x62737787, 0xecfc7064, 0x205670fa,
+	0x85cd537d, 0x496753e3, 0xc7e85400, 0x0b42549e,
+	0x01875d87, 0xcd2d5d19, 0x43a25afa, 0x8f085a64,
+	0x562848c8, 0x9a824856, 0x140d4fb5, 0xd8a74f2b,
+	0xd2624632, 0x1ec846ac, 0x9047414f, 0x5ced41d1,
+	0x299dc2ed, 0xe537c273, 0x6bb8c590, 0xa712c50e,
+	0xadd7cc17, 0x617dcc89, 0xeff2cb6a, 0x2358cbf4,
+	0xfa78d958, 0x36d2d9c6, 0xb85dde25, 0x74f7debb,
+	0x7e32d7a2, 0xb298d73c, 0x3c17d0df, 0xf0bdd041,
+	0x5526f3c6, 0x998cf358, 0x1703f4bb, 0xdba9f425,
+	0xd16cfd3c, 0x1dc6fda2, 0x9349fa41, 0x5fe3fadf,
+	0x86c3e873, 0x4a69e8ed, 0xc4e6ef0e, 0x084cef90,
+	0x0289e689, 0xce23e617, 0x40ace1f4, 0x8c06e16a,
+	0xd0eba0bb, 0x1c41a025, 0x92cea7c6, 0x5e64a758,
+	0x54a1ae41, 0x980baedf, 0x1684a93c, 0xda2ea9a2,
+	0x030ebb0e, 0xcfa4bb90, 0x412bbc73, 0x8d81bced,
+	0x8744b5f4, 0x4beeb56a, 0xc561b289, 0x09cbb217,
+	0xac509190, 0x60fa910e, 0xee7596ed, 0x22df9673,
+	0x281a9f6a, 0xe4b09ff4, 0x6a3f9817, 0xa6959889,
+	0x7fb58a25, 0xb31f8abb, 0x3d908d58, 0xf13a8dc6,
+	0xfbff84df, 0x37558441, 0xb9da83a2, 0x7570833c,
+	0x533b85da, 0x9f918544, 0x111e82a7, 0xddb48239,
+	0xd7718b20, 0x1bdb8bbe, 0x95548c5d, 0x59fe8cc3,
+	0x80de9e6f, 0x4c749ef1, 0xc2fb9912, 0x0e51998c,
+	0x04949095, 0xc83e900b, 0x46b197e8, 0x8a1b9776,
+	0x2f80b4f1, 0xe32ab46f, 0x6da5b38c, 0xa10fb312,
+	0xabcaba0b, 0x6760ba95, 0xe9efbd76, 0x2545bde8,
+	0xfc65af44, 0x30cfafda, 0xbe40a839, 0x72eaa8a7,
+	0x782fa1be, 0xb485a120, 0x3a0aa6c3, 0xf6a0a65d,
+	0xaa4de78c, 0x66e7e712, 0xe868e0f1, 0x24c2e06f,
+	0x2e07e976, 0xe2ade9e8, 0x6c22ee0b, 0xa088ee95,
+	0x79a8fc39, 0xb502fca7, 0x3b8dfb44, 0xf727fbda,
+	0xfde2f2c3, 0x3148f25d, 0xbfc7f5be, 0x736df520,
+	0xd6f6d6a7, 0x1a5cd639, 0x94d3d1da, 0x5879d144,
+	0x52bcd85d, 0x9e16d8c3, 0x1099df20, 0xdc33dfbe,
+	0x0513cd12, 0xc9b9cd8c, 0x4736ca6f, 0x8b9ccaf1,
+	0x8159c3e8, 0x4df3c376, 0xc37cc495, 0x0fd6c40b,
+	0x7aa64737, 0xb60c47a9, 0x3883404a, 0xf42940d4,
+	0xfeec49cd, 0x32464953, 0xbcc94eb0, 0x70634e2e,
+	0xa9435c82, 0x65e95c1c, 0xeb665bff, 0x27cc5b61,
+	0x2d095278, 0xe1a352e6, 0x6f2c5505, 0xa386559b,
+	0x061d761c, 0xcab77682, 0x44387161, 0x889271ff,
+	0x825778e6, 0x4efd7878, 0xc0727f9b, 0x0cd87f05,
+	0xd5f86da9, 0x19526d37, 0x97dd6ad4, 0x5b776a4a,
+	0x51b26353, 0x9d1863cd, 0x1397642e, 0xdf3d64b0,
+	0x83d02561, 0x4f7a25ff, 0xc1f5221c, 0x0d5f2282,
+	0x079a2b9b, 0xcb302b05, 0x45bf2ce6, 0x89152c78,
+	0x50353ed4, 0x9c9f3e4a, 0x121039a9, 0xdeba3937,
+	0xd47f302e, 0x18d530b0, 0x965a3753, 0x5af037cd,
+	0xff6b144a, 0x33c114d4, 0xbd4e1337, 0x71e413a9,
+	0x7b211ab0, 0xb78b1a2e, 0x39041dcd, 0xf5ae1d53,
+	0x2c8e0fff, 0xe0240f61, 0x6eab0882, 0xa201081c,
+	0xa8c40105, 0x646e019b, 0xeae10678, 0x264b06e6
+};
+
+// Slices 4 to 7 of crc_table_cksum_big, used for slicing-by-8
+const uint32_t crc_table_cksum_big8[1024] PROGMEM = {
+	0x00000000, 0x8d670d49, 0x1acf1a92, 0x97a817db,
+	0x8383f420, 0x0ee4f969, 0x994ceeb2, 0x142be3fb,
+	0x0607e941, 0x8b60e408, 0x1cc8f3d3, 0x91affe9a,
+	0x85841d61, 0x08e31028, 0x9f4b07f3, 0x122c0aba,
+	0x0c0ed283, 0x8169dfca, 0x16c1c811, 0x9ba6c558,
+	0x8f8d26a3, 0x02ea2bea, 0x95423c31, 0x18253178,
+	0x0a093bc2, 0x876e368b, 0x10c62150, 0x9da12c19,
+	0x898acfe2, 0x04edc2ab, 0x9345d570, 0x1e22d839,
+	0xaf016503, 0x2266684a, 0xb5ce7f91, 0x38a972d8,
+	0x2c829123, 0xa1e59c6a, 0x364d8bb1, 0xbb2a86f8,
+	0xa9068c42, 0x2461810b, 0xb3c996d0, 0x3eae9b99,
+	0x2a857862, 0xa7e2752b, 0x304a62f0, 0xbd2d6fb9,
+	0xa30fb780, 0x2e68bac9, 0xb9c0ad12, 0x34a7a05b,
+	0x208c43a0, 0xadeb4ee9, 0x3a435932, 0xb724547b,
+	0xa5085ec1, 0x286f5388, 0xbfc74453, 0x32a0491a,
+	0x268baae1, 0xabeca7a8, 0x3c44b073, 0xb123bd3a,
+	0x5e03ca06, 0xd364c74f, 0x44ccd094, 0xc9abdddd,
+	0xdd803e26, 0x50e7336f, 0xc74f24b4, 0x4a2829fd,
+	0x58042347, 0xd5632e0e, 0x42cb39d5, 0xcfac349c,
+	0xdb87d767, 0x56e0da2e, 0xc148cdf5, 0x4c2fc0bc,
+	0x520d1885, 0xdf6a15cc, 0x48c20217, 0xc5a50f5e,
+	0xd18eeca5, 0x5ce9e1ec, 0xcb41f637, 0x4626fb7e,
+	0x540af1c4, 0xd96dfc8d, 0x4ec5eb56, 0xc3a2e61f,
+	0xd78905e4, 0x5aee08ad, 0xcd461f76, 0x4021123f,
+	0xf102af05, 0x7c65a24c, 0xebcdb597, 0x66aab8de,
+	0x72815b25, 0xffe6566c, 0x684e41b7, 0xe5294cfe,
+	0xf7054644, 0x7a624b0d, 0xedca5cd6, 0x60ad519f,
+	0x7486b264, 0xf9e1bf2d, 0x6e49a8f6, 0xe32ea5bf,
+	0xfd0c7d86, 0x706b70cf, 0xe7c36714, 0x6aa46a5d,
+	0x7e8f89a6, 0xf3e884ef, 0x64409334, 0xe9279e7d,
+	0xfb0b94c7, 0x766c998e, 0xe1c48e55, 0x6ca3831c,
+	0x788860e7, 0xf5ef6dae, 0x62477a75, 0xef20773c,
+	0xbc06940d, 0x31619944, 0xa6c98e9f, 0x2bae83d6,
+	0x3f85602d, 0xb2e26d64, 0x254a7abf, 0xa82d77f6,
+	0xba017d4c, 0x37667005, 0xa0ce67de, 0x2da96a97,
+	0x3982896c, 0xb4e58425, 0x234d93fe, 0xae2a9eb7,
+	0xb008468e, 0x3d6f4bc7, 0xaac75c1c, 0x27a05155,
+	0x338bb2ae, 0xbeecbfe7, 0x2944a83c, 0xa423a575,
+	0xb60fafcf, 0x3b68a286, 0xacc0b55d, 0x21a7b814,
+	0x358c5bef, 0xb8eb56a6, 0x2f43417d, 0xa2244c34,
+	0x1307f10e, 0x9e60fc47, 0x09c8eb9c, 0x84afe6d5,
+	0x9084052e, 0x1de30867, 0x8a4b1fbc, 0x072c12f5,
+	0x1500184f, 0x98671506, 0x0fcf02dd, 0x82a80f94,
+	0x9683ec6f, 0x1be4e126, 0x8c4cf6fd, 0x012bfbb4,
+	0x1f09238d, 0x926e2ec4, 0x05c6391f, 0x88a13456,
+	0x9c8ad7ad, 0x11eddae4, 0x8645cd3f, 0x0b22c076,
+	0x190ecacc, 0x9469c785, 0x03c1d05e, 0x8ea6dd17,
+	0x9a8d3eec, 0x17ea33a5, 0x8042247e, 0x0d252937,
+	0xe2055e0b, 0x6f625342, 0xf8ca4499, 0x75ad49d0,
+	0x6186aa2b, 0xece1a762, 0x7b49b0b9, 0xf62ebdf0,
+	0xe402b74a, 0x6965ba03, 0xfecdadd8, 0x73aaa091,
+	0x6781436a, 0xeae64e23, 0x7d4e59f8, 0xf02954b1,
+	0xee0b8c88, 0x636c81c1, 0xf4c4961a, 0x79a39b53,
+	0x6d8878a8, 0xe0ef75e1, 0x7747623a, 0xfa206f73,
+	0xe80c65c9, 0x656b6880, 0xf2c37f5b, 0x7fa47212,
+	0x6b8f91e9, 0xe6e89ca0, 0x71408b7b, 0xfc278632,
+	0x4d043b08, 0xc0633641, 0x57cb219a, 0xdaac2cd3,
+	0xce87cf28, 0x43e0c261, 0xd448d5ba, 0x592fd8f3,
+	0x4b03d249, 0xc664df00, 0x51ccc8db, 0xdcabc592,
+	0xc8802669, 0x45e72b20, 0xd24f3cfb, 0x5f2831b2,
+	0x410ae98b, 0xcc6de4c2, 0x5bc5f319, 0xd6a2fe50,
+	0xc2891dab, 0x4fee10e2, 0xd8460739, 0x55210a70,
+	0x470d00ca, 0xca6a0d83, 0x5dc21a58, 0xd0a51711,
+	0xc48ef4ea, 0x49e9f9a3, 0xde41ee78, 0x5326e331,
+	0x00000000, 0x780d281b, 0xf01a5036, 0x8817782d,
+	0xe035a06c, 0x98388877, 0x102ff05a, 0x6822d841,
+	0xc06b40d9, 0xb86668c2, 0x307110ef, 0x487c38f4,
+	0x205ee0b5, 0x5853c8ae, 0xd044b083, 0xa8499898,
+	0x37ca41b6, 0x4fc769ad, 0xc7d01180, 0xbfdd399b,
+	0xd7ffe1da, 0xaff2c9c1, 0x27e5b1ec, 0x5fe899f7,
+	0xf7a1016f, 0x8fac2974, 0x07bb5159, 0x7fb67942,
+	0x1794a103, 0x6f998918, 0xe78ef135, 0x9f83d92e,
+	0xd9894268, 0xa1846a73, 0x2993125e, 0x519e3a45,
+	0x39bce204, 0x41b1ca1f, 0xc9a6b232, 0xb1ab9a29,
+	0x19e202b1, 0x61ef2aaa, 0xe9f85287, 0x91f57a9c,
+	0xf9d7a2dd, 0x81da8ac6, 0x09cdf2eb, 0x71c0daf0,
+	0xee4303de, 0x964e2bc5, 0x1e5953e8, 0x66547bf3,
+	0x0e76a3b2, 0x767b8ba9, 0xfe6cf384, 0x8661db9f,
+	0x2e284307, 0x56256b1c, 0xde321331, 0xa63f3b2a,
+	0xce1de36b, 0xb610cb70, 0x3e07b35d, 0x460a9b46,
+	0xb21385d0, 0xca1eadcb, 0x4209d5e6, 0x3a04fdfd,
+	0x522625bc, 0x2a2b0da7, 0xa23c758a, 0xda315d91,
+	0x7278c509, 0x0a75ed12, 0x8262953f, 0xfa6fbd24,
+	0x924d6565, 0xea404d7e, 0x62573553, 0x1a5a1d48,
+	0x85d9c466, 0xfdd4ec7d, 0x75c39450, 0x0dcebc4b,
+	0x65ec640a, 0x1de14c11, 0x95f6343c, 0xedfb1c27,
+	0x45b284bf, 0x3dbfaca4, 0xb5a8d489, 0xcda5fc92,
+	0xa58724d3, 0xdd8a0cc8, 0x559d74e5, 0x2d905cfe,
+	0x6b9ac7b8, 0x1397efa3, 0x9b80978e, 0xe38dbf95,
+	0x8baf67d4, 0xf3a24fcf, 0x7bb537e2, 0x03b81ff9,
+	0xabf18761, 0xd3fcaf7a, 0x5bebd757, 0x23e6ff4c,
+	0x4bc4270d, 0x33c90f16, 0xbbde773b, 0xc3d35f20,
+	0x5c50860e, 0x245dae15, 0xac4ad638, 0xd447fe23,
+	0xbc652662, 0xc4680e79, 0x4c7f7654, 0x34725e4f,
+	0x9c3bc6d7, 0xe436eecc, 0x6c2196e1, 0x142cbefa,
+	0x7c0e66bb, 0x04034ea0, 0x8c14368d, 0xf4191e96,
+	0xd33acba5, 0xab37e3be, 0x23209b93, 0x5b2db388,
+	0x330f6bc9, 0x4b0243d2, 0xc3153bff, 0xbb1813e4,
+	0x13518b7c, 0x6b5ca367, 0xe34bdb4a, 0x9b46f351,
+	0xf3642b10, 0x8b69030b, 0x037e7b26, 0x7b73533d,
+	0xe4f08a13, 0x9cfda208, 0x14eada25, 0x6ce7f23e,
+	0x04c52a7f, 0x7cc80264, 0xf4df7a49, 0x8cd25252,
+	0x249bcaca, 0x5c96e2d1, 0xd4819afc, 0xac8cb2e7,
+	0xc4ae6aa6, 0xbca342bd, 0x34b43a90, 0x4cb9128b,
+	0x0ab389cd, 0x72bea1d6, 0xfaa9d9fb, 0x82a4f1e0,
+	0xea8629a1, 0x928b01ba, 0x1a9c7997, 0x6291518c,
+	0xcad8c914, 0xb2d5e10f, 0x3ac29922, 0x42cfb139,
+	0x2aed6978, 0x52e04163, 0xdaf7394e, 0xa2fa1155,
+	0x3d79c87b, 0x4574e060, 0xcd63984d, 0xb56eb056,
+	0xdd4c6817, 0xa541400c, 0x2d563821, 0x555b103a,
+	0xfd1288a2, 0x851fa0b9, 0x0d08d894, 0x7505f08f,
+	0x1d2728ce, 0x652a00d5, 0xed3d78f8, 0x953050e3,
+	0x61294e75, 0x1924666e, 0x91331e43, 0xe93e3658,
+	0x811cee19, 0xf911c602, 0x7106be2f, 0x090b9634,
+	0xa1420eac, 0xd94f26b7, 0x51585e9a, 0x29557681,
+	0x4177aec0, 0x397a86db, 0xb16dfef6, 0xc960d6ed,
+	0x56e30fc3, 0x2eee27d8, 0xa6f95ff5, 0xdef477ee,
+	0xb6d6afaf, 0xcedb87b4, 0x46ccff99, 0x3ec1d782,
+	0x96884f1a, 0xee856701, 0x66921f2c, 0x1e9f3737,
+	0x76bdef76, 0x0eb0c76d, 0x86a7bf40, 0xfeaa975b,
+	0xb8a00c1d, 0xc0ad2406, 0x48ba5c2b, 0x30b77430,
+	0x5895ac71, 0x2098846a, 0xa88ffc47, 0xd082d45c,
+	0x78cb4cc4, 0x00c664df, 0x88d11cf2, 0xf0dc34e9,
+	0x98feeca8, 0xe0f3c4b3, 0x68e4bc9e, 0x10e99485,
+	0x8f6a4dab, 0xf76765b0, 0x7f701d9d, 0x077d3586,
+	0x6f5fedc7, 0x1752c5dc, 0x9f45bdf1, 0xe74895ea,
+	0x4f010d72, 0x370c2569, 0xbf1b5d44, 0xc716755f,
+	0xaf34ad1e, 0xd7398505, 0x5f2efd28, 0x2723d533,
+	0x00000000, 0x1168574f, 0x22d0ae9e, 0x33b8f9d1,
+	0xf3bd9c39, 0xe2d5cb76, 0xd16d32a7, 0xc00565e8,
+	0xe67b3973, 0xf7136e3c, 0xc4ab97ed, 0xd5c3c0a2,
+	0x15c6a54a, 0x04aef205, 0x37160bd4, 0x267e5c9b,
+	0xccf772e6, 0xdd9f25a9, 0xee27dc78, 0xff4f8b37,
+	0x3f4aeedf, 0x2e22b990, 0x1d9a4041, 0x0cf2170e,
+	0x2a8c4b95, 0x3be41cda, 0x085ce50b, 0x1934b244,
+	0xd931d7ac, 0xc85980e3, 0xfbe17932, 0xea892e7d,
+	0x2ff224c8, 0x3e9a7387, 0x0d228a56, 0x1c4add19,
+	0xdc4fb8f1, 0xcd27efbe, 0xfe9f166f, 0xeff74120,
+	0xc9891dbb, 0xd8e14af4, 0xeb59b325, 0xfa31e46a,
+	0x3a348182, 0x2b5cd6cd, 0x18e42f1c, 0x098c7853,
+	0xe305562e, 0xf26d0161, 0xc1d5f8b0, 0xd0bdafff,
+	0x10b8ca17, 0x01d09d58, 0x32686489, 0x230033c6,
+	0x057e6f5d, 0x14163812, 0x27aec1c3, 0x36c6968c,
+	0xf6c3f364, 0xe7aba42b, 0xd4135dfa, 0xc57b0ab5,
+	0xe9f98894, 0xf891dfdb, 0xcb29260a, 0xda417145,
+	0x1a4414ad, 0x0b2c43e2, 0x3894ba33, 0x29fced7c,
+	0x0f82b1e7, 0x1eeae6a8, 0x2d521f79, 0x3c3a4836,
+	0xfc3f2dde, 0xed577a91, 0xdeef8340, 0xcf87d40f,
+	0x250efa72, 0x3466ad3d, 0x07de54ec, 0x16b603a3,
+	0xd6b3664b, 0xc7db3104, 0xf463c8d5, 0xe50b9f9a,
+	0xc375c301, 0xd21d944e, 0xe1a56d9f, 0xf0cd3ad0,
+	0x30c85f38, 0x21a00877, 0x1218f1a6, 0x0370a6e9,
+	0xc60bac5c, 0xd763fb13, 0xe4db02c2, 0xf5b3558d,
+	0x35b63065, 0x24de672a, 0x17669efb, 0x060ec9b4,
+	0x2070952f, 0x3118c260, 0x02a03bb1, 0x13c86cfe,
+	0xd3cd0916, 0xc2a55e59, 0xf11da788, 0xe075f0c7,
+	0x0afcdeba, 0x1b9489f5, 0x282c7024, 0x3944276b,
+	0xf9414283, 0xe82915cc, 0xdb91ec1d, 0xcaf9bb52,
+	0xec87e7c9, 0xfdefb086, 0xce574957, 0xdf3f1e18,
+	0x1f3a7bf0, 0x0e522cbf, 0x3dead56e, 0x2c828221,
+	0x65eed02d, 0x74868762, 0x473e7eb3, 0x565629fc,
+	0x96534c14, 0x873b1b5b, 0xb483e28a, 0xa5ebb5c5,
+	0x8395e95e, 0x92fdbe11, 0xa14547c0, 0xb02d108f,
+	0x70287567, 0x61402228, 0x52f8dbf9, 0x43908cb6,
+	0xa919a2cb, 0xb871f584, 0x8bc90c55, 0x9aa15b1a,
+	0x5aa43ef2, 0x4bcc69bd, 0x7874906c, 0x691cc723,
+	0x4f629bb8, 0x5e0accf7, 0x6db23526, 0x7cda6269,
+	0xbcdf0781, 0xadb750ce, 0x9e0fa91f, 0x8f67fe50,
+	0x4a1cf4e5, 0x5b74a3aa, 0x68cc5a7b, 0x79a40d34,
+	0xb9a168dc, 0xa8c93f93, 0x9b71c642, 0x8a19910d,
+	0xac67cd96, 0xbd0f9ad9, 0x8eb76308, 0x9fdf3447,
+	0x5fda51af, 0x4eb206e0, 0x7d0aff31, 0x6c62a87e,
+	0x86eb8603, 0x9783d14c, 0xa43b289d, 0xb5537fd2,
+	0x75561a3a, 0x643e4d75, 0x5786b4a4, 0x46eee3eb,
+	0x6090bf70, 0x71f8e83f, 0x424011ee, 0x532846a1,
+	0x932d2349, 0x82457406, 0xb1fd8dd7, 0xa095da98,
+	0x8c1758b9, 0x9d7f0ff6, 0xaec7f627, 0xbfafa168,
+	0x7faac480, 0x6ec293cf, 0x5d7a6a1e, 0x4c123d51,
+	0x6a6c61ca, 0x7b043685, 0x48bccf54, 0x59d4981b,
+	0x99d1fdf3, 0x88b9aabc, 0xbb01536d, 0xaa690422,
+	0x40e02a5f, 0x51887d10, 0x623084c1, 0x7358d38e,
+	0xb35db666, 0xa235e129, 0x918d18f8, 0x80e54fb7,
+	0xa69b132c, 0xb7f34463, 0x844bbdb2, 0x9523eafd,
+	0x55268f15, 0x444ed85a, 0x77f6218b, 0x669e76c4,
+	0xa3e57c71, 0xb28d2b3e, 0x8135d2ef, 0x905d85a0,
+	0x5058e048, 0x4130b707, 0x72884ed6, 0x63e01999,
+	0x459e4502, 0x54f6124d, 0x674eeb9c, 0x7626bcd3,
+	0xb623d93b, 0xa74b8e74, 0x94f377a5, 0x859b20ea,
+	0x6f120e97, 0x7e7a59d8, 0x4dc2a009, 0x5caaf746,
+	0x9caf92ae, 0x8dc7c5e1, 0xbe7f3c30, 0xaf176b7f,
+	0x896937e4, 0x980160ab, 0xabb9997a, 0xbad1ce35,
+	0x7ad4abdd, 0x6bbcfc92, 0x58040543, 0x496c520c,
+	0x00000000, 0xcadca15b, 0x94b943b7, 0x5e65e2ec,
+	0x9f6e466a, 0x55b2e731, 0x0bd705dd, 0xc10ba486,
+	0x3edd8cd4, 0xf4012d8f, 0xaa64cf63, 0x60b86e38,
+	0xa1b3cabe, 0x6b6f6be5, 0x350a8909, 0xffd62852,
+	0xcba7d8ad, 0x017b79f6, 0x5f1e9b1a, 0x95c23a41,
+	0x54c99ec7, 0x9e153f9c, 0xc070dd70, 0x0aac7c2b,
+	0xf57a5479, 0x3fa6f522, 0x61c317ce, 0xab1fb695,
+	0x6a141213, 0xa0c8b348, 0xfead51a4, 0x3471f0ff,
+	0x2152705f, 0xeb8ed104, 0xb5eb33e8, 0x7f3792b3,
+	0xbe3c3635, 0x74e0976e, 0x2a857582, 0xe059d4d9,
+	0x1f8ffc8b, 0xd5535dd0, 0x8b36bf3c, 0x41ea1e67,
+	0x80e1bae1, 0x4a3d1bba, 0x1458f956, 0xde84580d,
+	0xeaf5a8f2, 0x202909a9, 0x7e4ceb45, 0xb4904a1e,
+	0x759bee98, 0xbf474fc3, 0xe122ad2f, 0x2bfe0c74,
+	0xd4282426, 0x1ef4857d, 0x40916791, 0x8a4dc6ca,
+	0x4b46624c, 0x819ac317, 0xdfff21fb, 0x152380a0,
+	0x42a4e0be, 0x887841e5, 0xd61da309, 0x1cc10252,
+	0xddcaa6d4, 0x1716078f, 0x4973e563, 0x83af4438,
+	0x7c796c6a, 0xb6a5cd31, 0xe8c02fdd, 0x221c8e86,
+	0xe3172a00, 0x29cb8b5b, 0x77ae69b7, 0xbd72c8ec,
+	0x89033813, 0x43df9948, 0x1dba7ba4, 0xd766daff,
+	0x166d7e79, 0xdcb1df22, 0x82d43dce, 0x48089c95,
+	0xb7deb4c7, 0x7d02159c, 0x2367f770, 0xe9bb562b,
+	0x28b0f2ad, 0xe26c53f6, 0xbc09b11a, 0x76d51041,
+	0x63f690e1, 0xa92a31ba, 0xf74fd356, 0x3d93720d,
+	0xfc98d68b, 0x364477d0, 0x6821953c, 0xa2fd3467,
+	0x5d2b1c35, 0x97f7bd6e, 0xc9925f82, 0x034efed9,
+	0xc2455a5f, 0x0899fb04, 0x56fc19e8, 0x9c20b8b3,
+	0xa851484c, 0x628de917, 0x3ce80bfb, 0xf634aaa0,
+	0x373f0e26, 0xfde3af7d, 0xa3864d91, 0x695aecca,
+	0x968cc498, 0x5c5065c3, 0x0235872f, 0xc8e92674,
+	0x09e282f2, 0xc33e23a9, 0x9d5bc145, 0x5787601e,
+	0x33550079, 0xf989a122, 0xa7ec43ce, 0x6d30e295,
+	0xac3b4613, 0x66e7e748, 0x388205a4, 0xf25ea4ff,
+	0x0d888cad, 0xc7542df6, 0x9931cf1a, 0x53ed6e41,
+	0x92e6cac7, 0x583a6b9c, 0x065f8970, 0xcc83282b,
+	0xf8f2d8d4, 0x322e798f, 0x6c4b9b63, 0xa6973a38,
+	0x679c9ebe, 0xad403fe5, 0xf325dd09, 0x39f97c52,
+	0xc62f5400, 0x0cf3f55b, 0x529617b7, 0x984ab6ec,
+	0x5941126a, 0x939db331, 0xcdf851dd, 0x0724f086,
+	0x12077026, 0xd8dbd17d, 0x86be3391, 0x4c6292ca,
+	0x8d69364c, 0x47b59717, 0x19d075fb, 0xd30cd4a0,
+	0x2cdafcf2, 0xe6065da9, 0xb863bf45, 0x72bf1e1e,
+	0xb3b4ba98, 0x79681bc3, 0x270df92f, 0xedd15874,
+	0xd9a0a88b, 0x137c09d0, 0x4d19eb3c, 0x87c54a67,
+	0x46ceeee1, 0x8c124fba, 0xd277ad56, 0x18ab0c0d,
+	0xe77d245f, 0x2da18504, 0x73c467e8, 0xb918c6b3,
+	0x78136235, 0xb2cfc36e, 0xecaa2182, 0x267680d9,
+	0x71f1e0c7, 0xbb2d419c, 0xe548a370, 0x2f94022b,
+	0xee9fa6ad, 0x244307f6, 0x7a26e51a, 0xb0fa4441,
+	0x4f2c6c13, 0x85f0cd48, 0xdb952fa4, 0x11498eff,
+	0xd0422a79, 0x1a9e8b22, 0x44fb69ce, 0x8e27c895,
+	0xba56386a, 0x708a9931, 0x2eef7bdd, 0xe433da86,
+	0x25387e00, 0xefe4df5b, 0xb1813db7, 0x7b5d9cec,
+	0x848bb4be, 0x4e5715e5, 0x1032f709, 0xdaee5652,
+	0x1be5f2d4, 0xd139538f, 0x8f5cb163, 0x45801038,
+	0x50a39098, 0x9a7f31c3, 0xc41ad32f, 0x0ec67274,
+	0xcfcdd6f2, 0x051177a9, 0x5b749545, 0x91a8341e,
+	0x6e7e1c4c, 0xa4a2bd17, 0xfac75ffb, 0x301bfea0,
+	0xf1105a26, 0x3bccfb7d, 0x65a91991, 0xaf75b8ca,
+	0x9b044835, 0x51d8e96e, 0x0fbd0b82, 0xc561aad9,
+	0x046a0e5f, 0xceb6af04, 0x90d34de8, 0x5a0fecb3,
+	0xa5d9c4e1, 0x6f0565ba, 0x31608756, 0xfbbc260d,
+	0x3ab7828b, 0xf06b23d0, 0xae0ec13c, 0x64d26067
+};
 #endif
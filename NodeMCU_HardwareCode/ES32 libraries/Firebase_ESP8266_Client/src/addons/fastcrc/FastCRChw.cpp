@@ -382,7 +382,7 @@ FastCRC32::FastCRC32(){
  * @param datalen Length of Data
  * @return CRC value
  */
-uint32_t FastCRC32::crc32(const uint8_t *data, const uint16_t datalen)
+uint32_t FastCRC32::crc32(const uint8_t *data, const size_t datalen)
 {
   // poly=0x04c11db7 init=0xffffffff refin=true refout=true xorout=0xffffffff check=0xcbf43926
   return generic(0x04C11DB7L, 0XFFFFFFFFL, CRC_FLAG_REFLECT | CRC_FLAG_XOR, data, datalen);
@@ -394,7 +394,7 @@ uint32_t FastCRC32::crc32(const uint8_t *data, const uint16_t datalen)
  * @param datalen Length of Data
  * @return CRC value
  */
-uint32_t FastCRC32::cksum(const uint8_t *data, const uint16_t datalen)
+uint32_t FastCRC32::cksum(const uint8_t *data, const size_t datalen)
 {
   // width=32 poly=0x04c11db7 init=0x00000000 refin=false refout=false xorout=0xffffffff check=0x765e7680
   return generic(0x04C11DB7L, 0, CRC_FLAG_NOREFLECT | CRC_FLAG_XOR, data, datalen);
@@ -407,7 +407,7 @@ uint32_t FastCRC32::cksum(const uint8_t *data, const uint16_t datalen)
  * @return CRC value
  */
 //#pragma GCC diagnostic ignored "-Wpointer-arith"
-uint32_t FastCRC32::update(const uint8_t *data, const uint16_t datalen)
+uint32_t FastCRC32::update(const uint8_t *data, const size_t datalen)
 {
 
   const uint8_t *src = data;
@@ -437,7 +437,7 @@ uint32_t FastCRC32::update(const uint8_t *data, const uint16_t datalen)
  * @param datalen Length of Data
  * @return CRC value
  */
-uint32_t FastCRC32::generic(const uint32_t polynom, const uint32_t seed, const uint32_t flags, const uint8_t *data, const uint16_t datalen)
+uint32_t FastCRC32::generic(const uint32_t polynom, const uint32_t seed, const uint32_t flags, const uint8_t *data, const size_t datalen)
 {
 
   rCRC->CTRL  = flags | (1<<CRC_CTRL_TCRC) | (1<<CRC_CTRL_WAS); // 32Bit Mode, prepare to write seed(25)
@@ -448,6 +448,6 @@ uint32_t FastCRC32::generic(const uint32_t polynom, const uint32_t seed, const u
   return update(data, datalen);
 }
 
-uint32_t FastCRC32::crc32_upd(const uint8_t *data, uint16_t len){return update(data, len);}
-uint32_t FastCRC32::cksum_upd(const uint8_t *data, uint16_t len){return update(data, len);}
+uint32_t FastCRC32::crc32_upd(const uint8_t *data, size_t len){return update(data, len);}
+uint32_t FastCRC32::cksum_upd(const uint8_t *data, size_t len){return update(data, len);}
 #endif // #if defined(KINETISK)
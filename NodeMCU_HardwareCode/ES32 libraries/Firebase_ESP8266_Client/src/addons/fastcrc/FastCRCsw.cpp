@@ -398,55 +398,88 @@ FastCRC32::FastCRC32(){}
 	crc = (crc >> 8) ^ pgm_read_dword(&table[crc & 0xff]); \
 	crc = (crc >> 8) ^ pgm_read_dword(&table[crc & 0xff]);
 
-/** CRC32
- * Alias CRC-32/ADCCP, PKZIP, Ethernet, 802.3
- * @param data Pointer to Data
- * @param datalen Length of Data
- * @return CRC value
- */
+#define crc_n8d(crc, data0, data1, table, table8) crc ^= data0; \
+	crc = pgm_read_dword(&table8[(crc & 0xff) + 0x300]) ^	\
+	pgm_read_dword(&table8[((crc >> 8) & 0xff) + 0x200]) ^	\
+	pgm_read_dword(&table8[((crc >> 16) & 0xff) + 0x100]) ^	\
+	pgm_read_dword(&table8[(crc >> 24) & 0xff]) ^	\
+	pgm_read_dword(&table[(data1 & 0xff) + 0x300]) ^	\
+	pgm_read_dword(&table[((data1 >> 8) & 0xff) + 0x200]) ^	\
+	pgm_read_dword(&table[((data1 >> 16) & 0xff) + 0x100]) ^	\
+	pgm_read_dword(&table[(data1 >> 24) & 0xff]);
+
 #if CRC_BIGTABLES
 #define CRC_TABLE_CRC32 crc_table_crc32_big
+#define CRC_TABLE_CKSUM crc_table_cksum_big
 #else
 #define CRC_TABLE_CRC32 crc_table_crc32
+#define CRC_TABLE_CKSUM crc_table_cksum
 #endif
 
-uint32_t FastCRC32::crc32_upd(const uint8_t *data, uint16_t len)
-{
+#if CRC_BIGTABLES && CRC_SLICING8
+#define CRC_TABLE_CRC32_8 crc_table_crc32_big8
+#define CRC_TABLE_CKSUM_8 crc_table_cksum_big8
+#else
+#define CRC_TABLE_CRC32_8 NULL
+#define CRC_TABLE_CKSUM_8 NULL
+#endif
 
-	uint32_t crc = seed;
+/** Reflected 32-Bit CRC, shared by CRC32 and CKSUM (the cksum table is byte reversed)
+ * @param crc Previous seed
+ * @param data Pointer to Data
+ * @param len Length of Data
+ * @param table 32-Bit CRC table
+ * @param table8 Slices 4 to 7 of the big table
+ * @return CRC value before final XOR
+ */
+static uint32_t crc32_calc(uint32_t crc, const uint8_t *data, size_t len, const uint32_t *table, const uint32_t *table8)
+{
+	(void)table8;
 
 	while (((uintptr_t)data & 3) && len) {
-		crc = (crc >> 8) ^ pgm_read_dword(&CRC_TABLE_CRC32[(crc & 0xff) ^ *data++]);
+		crc = (crc >> 8) ^ pgm_read_dword(&table[(crc & 0xff) ^ *data++]);
 		len--;
 	}
 
 	while (len >= 16) {
 		len -= 16;
-		#if CRC_BIGTABLES
-		crc_n4d(crc, ((uint32_t *)data)[0], CRC_TABLE_CRC32);
-		crc_n4d(crc, ((uint32_t *)data)[1], CRC_TABLE_CRC32);
-		crc_n4d(crc, ((uint32_t *)data)[2], CRC_TABLE_CRC32);
-		crc_n4d(crc, ((uint32_t *)data)[3], CRC_TABLE_CRC32);
+		#if CRC_BIGTABLES && CRC_SLICING8
+		crc_n8d(crc, ((uint32_t *)data)[0], ((uint32_t *)data)[1], table, table8);
+		crc_n8d(crc, ((uint32_t *)data)[2], ((uint32_t *)data)[3], table, table8);
+		#elif CRC_BIGTABLES
+		crc_n4d(crc, ((uint32_t *)data)[0], table);
+		crc_n4d(crc, ((uint32_t *)data)[1], table);
+		crc_n4d(crc, ((uint32_t *)data)[2], table);
+		crc_n4d(crc, ((uint32_t *)data)[3], table);
 		#else
-		crcsm_n4d(crc, ((uint32_t *)data)[0], CRC_TABLE_CRC32);
-		crcsm_n4d(crc, ((uint32_t *)data)[1], CRC_TABLE_CRC32);
-		crcsm_n4d(crc, ((uint32_t *)data)[2], CRC_TABLE_CRC32);
-		crcsm_n4d(crc, ((uint32_t *)data)[3], CRC_TABLE_CRC32);
+		crcsm_n4d(crc, ((uint32_t *)data)[0], table);
+		crcsm_n4d(crc, ((uint32_t *)data)[1], table);
+		crcsm_n4d(crc, ((uint32_t *)data)[2], table);
+		crcsm_n4d(crc, ((uint32_t *)data)[3], table);
 		#endif
 		data += 16;
 	}
 
 	while (len--) {
-		crc = (crc >> 8) ^ pgm_read_dword(&CRC_TABLE_CRC32[(crc & 0xff) ^ *data++]);
+		crc = (crc >> 8) ^ pgm_read_dword(&table[(crc & 0xff) ^ *data++]);
 	}
 
-	seed = crc;
-	crc = ~crc;
-
 	return crc;
 }
 
-uint32_t FastCRC32::crc32(const uint8_t *data, const uint16_t datalen)
+/** CRC32
+ * Alias CRC-32/ADCCP, PKZIP, Ethernet, 802.3
+ * @param data Pointer to Data
+ * @param datalen Length of Data
+ * @return CRC value
+ */
+uint32_t FastCRC32::crc32_upd(const uint8_t *data, size_t len)
+{
+	seed = crc32_calc(seed, data, len, CRC_TABLE_CRC32, CRC_TABLE_CRC32_8);
+	return ~seed;
+}
+
+uint32_t FastCRC32::crc32(const uint8_t *data, const size_t datalen)
 {
   // poly=0x04c11db7 init=0xffffffff refin=true refout=true xorout=0xffffffff check=0xcbf43926
   seed = 0xffffffff;
@@ -459,51 +492,59 @@ uint32_t FastCRC32::crc32(const uint8_t *data, const uint16_t datalen)
  * @param datalen Length of Data
  * @return CRC value
  */
- #if CRC_BIGTABLES
-#define CRC_TABLE_CKSUM crc_table_cksum_big
-#else
-#define CRC_TABLE_CKSUM crc_table_cksum
-#endif
-uint32_t FastCRC32::cksum_upd(const uint8_t *data, uint16_t len)
+uint32_t FastCRC32::cksum_upd(const uint8_t *data, size_t len)
 {
+	seed = crc32_calc(seed, data, len, CRC_TABLE_CKSUM, CRC_TABLE_CKSUM_8);
+	return ~REV32(seed);
+}
 
-	uint32_t crc = seed;
+uint32_t FastCRC32::cksum(const uint8_t *data, const size_t datalen)
+{
+  // width=32 poly=0x04c11db7 init=0x00000000 refin=false refout=false xorout=0xffffffff check=0x765e7680
+  seed = 0x00;
+  return cksum_upd(data, datalen);
+}
 
-	while (((uintptr_t)data & 3) && len) {
-		crc = (crc >> 8) ^ pgm_read_dword(&CRC_TABLE_CKSUM[(crc & 0xff) ^ *data++]);
-		len--;
-	}
+/** Streaming
+ * The context keeps the running CRC, the object seed is not used
+ * crc32_begin and cksum_begin reset the context for CRC-32 and CKSUM
+ * @param ctx Context of the stream
+ */
+void FastCRC32::crc32_begin(FastCRC32_Context &ctx)
+{
+  ctx.crc = 0xffffffff;
+  ctx.length = 0;
+  ctx.cksum = false;
+}
 
-	while (len >= 16) {
-		len -= 16;
-		#if CRC_BIGTABLES
-		crc_n4d(crc, ((uint32_t *)data)[0], CRC_TABLE_CKSUM);
-		crc_n4d(crc, ((uint32_t *)data)[1], CRC_TABLE_CKSUM);
-		crc_n4d(crc, ((uint32_t *)data)[2], CRC_TABLE_CKSUM);
-		crc_n4d(crc, ((uint32_t *)data)[3], CRC_TABLE_CKSUM);
-		#else
-		crcsm_n4d(crc, ((uint32_t *)data)[0], CRC_TABLE_CKSUM);
-		crcsm_n4d(crc, ((uint32_t *)data)[1], CRC_TABLE_CKSUM);
-		crcsm_n4d(crc, ((uint32_t *)data)[2], CRC_TABLE_CKSUM);
-		crcsm_n4d(crc, ((uint32_t *)data)[3], CRC_TABLE_CKSUM);
-		#endif
-		data += 16;
-	}
+void FastCRC32::cksum_begin(FastCRC32_Context &ctx)
+{
+  ctx.crc = 0x00;
+  ctx.length = 0;
+  ctx.cksum = true;
+}
 
-	while (len--) {
-		crc = (crc >> 8) ^ pgm_read_dword(&CRC_TABLE_CKSUM[(crc & 0xff) ^ *data++]);
-	}
-	
-	seed = crc;
-	crc = ~REV32(crc);	
-	return crc;
+/** Add the data to the stream
+ * @param ctx Context of the stream
+ * @param data Pointer to Data
+ * @param len Length of Data
+ */
+void FastCRC32::update(FastCRC32_Context &ctx, const uint8_t *data, size_t len)
+{
+  if (ctx.cksum)
+    ctx.crc = crc32_calc(ctx.crc, data, len, CRC_TABLE_CKSUM, CRC_TABLE_CKSUM_8);
+  else
+    ctx.crc = crc32_calc(ctx.crc, data, len, CRC_TABLE_CRC32, CRC_TABLE_CRC32_8);
+  ctx.length += len;
 }
 
-uint32_t FastCRC32::cksum(const uint8_t *data, const uint16_t datalen)
+/** Get the CRC of the data added so far, the stream can be continued
+ * @param ctx Context of the stream
+ * @return CRC value
+ */
+uint32_t FastCRC32::result(const FastCRC32_Context &ctx)
 {
-  // width=32 poly=0x04c11db7 init=0x00000000 refin=false refout=false xorout=0xffffffff check=0x765e7680
-  seed = 0x00;
-  return cksum_upd(data, datalen);
+  return ctx.cksum ? ~REV32(ctx.crc) : ~ctx.crc;
 }
 
 #endif // #if !defined(KINETISK)
@@ -58,6 +58,7 @@
 #elif defined(ESP8266)
 #include <Updater.h>
 #endif
+#include "addons/fastcrc/FastCRC.h"
 #define OTA_UPDATE_ENABLED
 #endif
 
@@ -93,6 +94,12 @@ class QueryFilter;
 #define DEFAULT_RTDB_KEEP_ALIVE_TIMEOUT 45 * 1000
 #define MAX_RTDB_KEEP_ALIVE_TIMEOUT 2 * 60 * 1000
 
+#define DEFAULT_MAX_CONCURRENT_REQUESTS 4
+#define MAX_CONCURRENT_REQUESTS 16
+#define MAX_ASYNC_INFLIGHT_REQUESTS 8
+#define MAX_COALESCED_WRITES 32
+#define MAX_READ_CACHE_SIZE 32
+
 #define MIN_RTDB_STREAM_RECONNECT_INTERVAL 1000
 #define MAX_RTDB_STREAM_RECONNECT_INTERVAL 60 * 1000
 
@@ -107,7 +114,15 @@ class QueryFilter;
 
 #define STREAM_TASK_STACK_SIZE 8192
 #define QUEUE_TASK_STACK_SIZE 8192
+#define TOKEN_REFRESH_TASK_STACK_SIZE 8192
+#define TCP_GATHER_BUFFER_SIZE 1024
+#define BSSL_BUFFER_SIZE_HIST_BUCKETS 6 //512, 1024, 2048, 4096, 8192 and 16384 bytes
+#define BSSL_BUFFER_SIZE_HIST_DECAY 64
+#define BSSL_BUFFER_SIZE_SHRINK_MIN_SAMPLES 32
+#define HTTP_RESPONSE_HEADER_RESERVED_SIZE 400
+#define MAX_ADAPTIVE_RESPONSE_SIZE 16384
 #define MAX_BLOB_PAYLOAD_SIZE 1024
+#define OTA_WRITE_BUFFER_SIZE 4096 //one flash sector
 #define MAX_EXCHANGE_TOKEN_ATTEMPTS 5
 #define ESP_DEFAULT_TS 1618971013
 
@@ -125,6 +140,7 @@ class QueryFilter;
 #define _NO_QUEUE false
 
 #include "FB_Error.h"
+#include "FB_Metrics.h"
 
 typedef enum
 {
@@ -566,8 +582,59 @@ typedef struct fb_esp_rtdb_download_status_info_t
 
 } RTDB_DownloadStatusInfo;
 
+typedef struct fb_esp_rtdb_async_status_info_t
+{
+    int httpCode = 0;
+    bool success = false;
+    MB_String path;
+    MB_String pushName;
+    MB_String ETag;
+    MB_String errorMsg;
+
+} RTDB_AsyncStatusInfo;
+
 typedef void (*RTDB_UploadProgressCallback)(RTDB_UploadStatusInfo);
 typedef void (*RTDB_DownloadProgressCallback)(RTDB_DownloadStatusInfo);
+typedef void (*RTDB_AsyncCallback)(RTDB_AsyncStatusInfo);
+
+//return false from the callback to stop reading the keys
+typedef bool (*RTDB_KeyCallback)(const char *key, size_t index);
+
+typedef struct fb_esp_rtdb_key_cursor_t
+{
+    MB_String path;
+    //the last key that was read, the next page starts after this key
+    MB_String lastKey;
+    size_t pageSize = 50;
+    size_t count = 0;
+    //the average size of the child in the previous page
+    size_t childSize = 0;
+    bool done = false;
+} RTDB_KeyCursor;
+
+struct fb_esp_rtdb_cached_write_t
+{
+    MB_String path;
+    MB_String value;
+    fb_esp_data_type type = d_any;
+};
+
+struct fb_esp_rtdb_read_cache_t
+{
+    MB_String path;
+    MB_String value;
+    MB_String etag;
+    fb_esp_data_type type = d_any;
+};
+
+struct fb_esp_rtdb_async_req_t
+{
+    fb_esp_method method = m_put;
+    fb_esp_data_type type = d_any;
+    bool no_content = false;
+    MB_String path;
+    unsigned long sent_ms = 0;
+};
 
 struct fb_esp_rtdb_request_info_t
 {
@@ -661,6 +728,20 @@ struct server_response_data_t
     MB_String pushName;
     MB_String fbError;
     MB_String transferEnc;
+
+    //incremental payload parsing state
+    size_t scanOfs = 0;
+    bool scanKeys = false;
+    bool scanInStr = false;
+    uint8_t scanEsc = 0;
+    uint32_t scanCp = 0;
+    bool scanIsKey = false;
+    char scanLast = 0;
+    int scanDepth = 0;
+    uint8_t scanTarget = 0;
+    uint8_t scanCapture = 0;
+    uint8_t scanKeyLen = 0;
+    char scanKey[8];
 };
 
 struct fb_esp_auth_token_error_t
@@ -747,6 +828,12 @@ struct fb_esp_token_signer_resources_t
     bool tokenTaskRunning = false;
     unsigned long lastReqMillis = 0;
     unsigned long preRefreshSeconds = 60;
+    //Refresh the token in background this many seconds (plus the random jitter) before it expires,
+    //the current token is still used by the requests until the new one is ready (0 to disable).
+    //On ESP8266 the refresh runs as the scheduled function between the loop() calls and blocks it
+    //for the token request.
+    unsigned long bgRefreshSeconds = 300;
+    unsigned long bgRefreshJitterSeconds = 60;
     unsigned long expiredSeconds = 3600;
     unsigned long reqTO = 2000;
     MB_String pk;
@@ -808,6 +895,11 @@ struct fb_esp_cfg_int_t
 {
     bool fb_multiple_requests = false;
     bool fb_processing = false;
+    uint8_t fb_active_requests = 0;
+    uint8_t fb_max_requests = DEFAULT_MAX_CONCURRENT_REQUESTS;
+#if defined(ESP32)
+    portMUX_TYPE fb_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
     uint8_t fb_stream_idx = 0;
 
     bool fb_reconnect_wifi = false;
@@ -826,18 +918,33 @@ struct fb_esp_cfg_int_t
     uint16_t atok_len = 0;
     uint16_t ltok_len = 0;
     uint16_t email_crc = 0, password_crc = 0, client_email_crc = 0, project_id_crc = 0, priv_key_crc = 0, uid_crc = 0;
+    unsigned long fb_token_refresh_jitter = 0;
 
 #if defined(ESP32)
+    TaskHandle_t token_refresh_task_handle = NULL;
     TaskHandle_t resumable_upload_task_handle = NULL;
     TaskHandle_t functions_check_task_handle = NULL;
     TaskHandle_t functions_deployment_task_handle = NULL;
 #endif
 };
 
+struct fb_esp_rtdb_transport_t
+{
+    //fb_transport_type_secure (default), fb_transport_type_plain or fb_transport_type_pinned_key
+    fb_transport_type type = fb_transport_type_secure;
+    //the gateway host and port to connect instead of the database host,
+    //the port is 80 for the plain client and 443 for the TLS client when not set
+    MB_String host;
+    uint16_t port = 0;
+    //the PEM public key of the gateway, required by fb_transport_type_pinned_key
+    const char *public_key = nullptr;
+};
+
 struct fb_esp_rtdb_config_t
 {
     bool data_type_stricted = false;
     size_t upload_buffer_size = 128;
+    struct fb_esp_rtdb_transport_t transport;
 
     //unused, call fbdo.setResponseSize instead
     //size_t download_buffer_size = 256;
@@ -1007,6 +1114,24 @@ struct fb_esp_cfg_t
     struct fb_esp_client_timeout_t timeout;
 };
 #ifdef ENABLE_RTDB
+#if defined(OTA_UPDATE_ENABLED)
+struct fb_esp_ota_info_t
+{
+    //decoded bytes waiting for a whole sector, allocated while downloading only
+    uint8_t *buf = nullptr;
+    size_t buf_len = 0;
+    //base64 symbols of the quad that continues in the next chunk
+    uint8_t quad[4];
+    uint8_t quad_len = 0;
+    uint8_t pad_len = 0;
+    //decoded size including the pad bytes
+    size_t size = 0;
+    //bytes written to flash
+    size_t committed = 0;
+    FastCRC32_Context crc = {0xffffffff, 0, false};
+};
+#endif
+
 struct fb_esp_rtdb_info_t
 {
     int queue_Idx = -1;
@@ -1025,6 +1150,15 @@ struct fb_esp_rtdb_info_t
     bool async = false;
     bool new_stream = false;
     size_t async_count = 0;
+    RTDB_AsyncCallback async_cb = NULL;
+    std::vector<struct fb_esp_rtdb_async_req_t> async_reqs;
+    uint32_t write_interval = 0;
+    unsigned long write_flush_millis = 0;
+    std::vector<struct fb_esp_rtdb_cached_write_t> writes;
+    bool local_push_id = false;
+#if defined(OTA_UPDATE_ENABLED)
+    struct fb_esp_ota_info_t ota;
+#endif
 
     uint8_t connection_status = 0;
     uint32_t queue_ID = 0;
@@ -1607,6 +1741,7 @@ struct fb_esp_session_info_t
     bool buffer_ovf = false;
     bool chunked_encoding = false;
     bool connected = false;
+    bool processing = false;
     bool classic_request = false;
     MB_String host;
     unsigned long last_conn_ms = 0;
@@ -1642,9 +1777,25 @@ struct fb_esp_session_info_t
 #endif
 #endif
 
+    bool adaptive_buffer = false;
+    size_t tx_count = 0;
+
 #if defined(ESP8266)
     uint16_t bssl_rx_size = 512;
     uint16_t bssl_tx_size = 512;
+    uint16_t bssl_hist_count = 0;
+    uint16_t bssl_rx_hist[BSSL_BUFFER_SIZE_HIST_BUCKETS] = {0};
+    uint16_t bssl_tx_hist[BSSL_BUFFER_SIZE_HIST_BUCKETS] = {0};
+#endif
+
+    //the gather buffer that collects the request fragments before they are sent
+    char *tx_buf = nullptr;
+    size_t tx_len = 0;
+    //the allocated size of tx_buf
+    size_t tx_cap = 0;
+
+#if defined(ENABLE_FB_METRICS)
+    FirebaseMetrics metrics;
 #endif
 };
 
@@ -2291,6 +2442,21 @@ static const char fb_esp_pgm_str_592[] PROGMEM = "File is still opened.";
 static const char fb_esp_pgm_str_593[] PROGMEM = "File not found.";
 #endif
 
+static const char fb_esp_pgm_str_594[] PROGMEM = "Backup chunk is incomplete or corrupted.";
+static const char fb_esp_pgm_str_595[] PROGMEM = ".mft";
+static const char fb_esp_pgm_str_596[] PROGMEM = "$key";
+static const char fb_esp_pgm_str_597[] PROGMEM = "chunks";
+static const char fb_esp_pgm_str_598[] PROGMEM = "start";
+static const char fb_esp_pgm_str_599[] PROGMEM = "end";
+static const char fb_esp_pgm_str_600[] PROGMEM = "crc";
+static const char fb_esp_pgm_str_601[] PROGMEM = "size";
+static const char fb_esp_pgm_str_602[] PROGMEM = "status";
+static const char fb_esp_pgm_str_603[] PROGMEM = "path";
+static const char fb_esp_pgm_str_604[] PROGMEM = "count";
+static const char fb_esp_pgm_str_605[] PROGMEM = "name";
+static const char fb_esp_pgm_str_606[] PROGMEM = "if-none-match: ";
+static const char fb_esp_pgm_str_607[] PROGMEM = "-0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz";
+
 static const unsigned char fb_esp_base64_table[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 static const char fb_esp_boundary_table[] PROGMEM = "=_abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
@@ -412,6 +412,7 @@ void FirebaseJsonBase::mIterate(MB_JSON *parent, int &arrIndex)
                         item = item->next;
                         _arrIndex++;
                     }
+                    iterator_data.depth--;
                 }
             }
             else if (isObject(e))
@@ -424,6 +425,8 @@ void FirebaseJsonBase::mIterate(MB_JSON *parent, int &arrIndex)
             if (isAr)
                 arrIndex++;
         }
+        //the next sibling of the parent is at the parent depth
+        iterator_data.depth--;
     }
 }
 
@@ -547,7 +550,8 @@ bool FirebaseJsonBase::mReadClient(Client *client)
 bool FirebaseJsonBase::mReadStream(Stream *s, int timeoutMS)
 {
     //non-blocking read
-    if (readStream(s, serData, buf, true, timeoutMS))
+    //an array object waits for the brackets instead of the braces
+    if (readStream(s, serData, buf, root_type == Root_Type_JSON, timeoutMS))
     {
         if (root != NULL)
             MB_JSON_Delete(root);
@@ -562,7 +566,7 @@ bool FirebaseJsonBase::mReadStream(Stream *s, int timeoutMS)
 bool FirebaseJsonBase::mReadSdFat(SD_FAT_FILE &file, int timeoutMS)
 {
     //non-blocking read
-    if (readSdFatFile(file, serData, buf, true, timeoutMS))
+    if (readSdFatFile(file, serData, buf, root_type == Root_Type_JSON, timeoutMS))
     {
         if (root != NULL)
             MB_JSON_Delete(root);
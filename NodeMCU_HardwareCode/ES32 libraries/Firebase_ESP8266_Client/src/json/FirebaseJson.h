@@ -64,6 +64,7 @@
 #define MB_STRING_USE_PSRAM
 #endif
 #include "MB_String.h"
+#include "MB_Chunked.h"
 
 using namespace mb_string;
 
@@ -224,7 +225,7 @@ static void *fb_js_malloc(size_t len)
     ESP.setExternalHeap();
 #endif
 
-    bool nn = ((p = (void *)malloc(newLen)) > 0);
+    bool nn = ((p = (void *)malloc(newLen)) != nullptr);
 
 #if defined(ESP8266_USE_EXTERNAL_HEAP)
     ESP.resetHeap();
@@ -832,7 +833,7 @@ protected:
         ESP.setExternalHeap();
 #endif
 
-        bool nn = ((p = (void *)malloc(newLen)) > 0);
+        bool nn = ((p = (void *)malloc(newLen)) != nullptr);
 
 #if defined(ESP8266_USE_EXTERNAL_HEAP)
         ESP.resetHeap();
@@ -1211,155 +1212,12 @@ protected:
 
     int readChunkedData(Client *stream, char *out, int &chunkState, int &chunkedSize, int &dataLen, int bufLen)
     {
-        char *tmp = nullptr;
-        char *buf = nullptr;
-        int p1 = 0;
-        int olen = 0;
-
-        if (chunkState == 0)
-        {
-            chunkState = 1;
-            chunkedSize = -1;
-            dataLen = 0;
-            buf = (char *)newP(bufLen);
-            int readLen = readLine(stream, buf, bufLen);
-            if (readLen)
-            {
-                p1 = strpos(buf, ';', 0);
-                if (p1 == -1)
-                {
-                    tmp = strP(fb_json_str_7);
-                    p1 = strpos(buf, tmp, 0);
-                    delP(&tmp);
-                }
-
-                if (p1 != -1)
-                {
-                    tmp = (char *)newP(p1 + 1);
-                    memcpy(tmp, buf, p1);
-                    chunkedSize = hex2int(tmp);
-                    delP(&tmp);
-                }
-
-                //last chunk
-                if (chunkedSize < 1)
-                    olen = -1;
-            }
-            else
-                chunkState = 0;
-
-            delP(&buf);
-        }
-        else
-        {
-
-            if (chunkedSize > -1)
-            {
-                buf = (char *)newP(bufLen);
-                int readLen = readLine(stream, buf, bufLen);
-
-                if (readLen > 0)
-                {
-                    //chunk may contain trailing
-                    if (dataLen + readLen - 2 < chunkedSize)
-                    {
-                        dataLen += readLen;
-                        memcpy(out, buf, readLen);
-                        olen = readLen;
-                    }
-                    else
-                    {
-                        if (chunkedSize - dataLen > 0)
-                            memcpy(out, buf, chunkedSize - dataLen);
-                        dataLen = chunkedSize;
-                        chunkState = 0;
-                        olen = readLen;
-                    }
-                }
-                else
-                {
-                    olen = -1;
-                }
-
-                delP(&buf);
-            }
-        }
-
-        return olen;
+        return MB_Chunked::read(stream, out, chunkState, chunkedSize, dataLen, bufLen);
     }
 
     int readChunkedData(Client *stream, MB_String &out, int &chunkState, int &chunkedSize, int &dataLen)
     {
-        char *tmp = nullptr;
-        int p1 = 0;
-        int olen = 0;
-
-        if (chunkState == 0)
-        {
-            chunkState = 1;
-            chunkedSize = -1;
-            dataLen = 0;
-            MB_String s;
-            int readLen = readLine(stream, s);
-            if (readLen)
-            {
-                p1 = strpos(s.c_str(), ';', 0);
-                if (p1 == -1)
-                {
-                    tmp = strP(fb_json_str_7);
-                    p1 = strpos(s.c_str(), tmp, 0);
-                    delP(&tmp);
-                }
-
-                if (p1 != -1)
-                {
-                    tmp = (char *)newP(p1 + 1);
-                    memcpy(tmp, s.c_str(), p1);
-                    chunkedSize = hex2int(tmp);
-                    delP(&tmp);
-                }
-
-                //last chunk
-                if (chunkedSize < 1)
-                    olen = -1;
-            }
-            else
-                chunkState = 0;
-        }
-        else
-        {
-
-            if (chunkedSize > -1)
-            {
-                MB_String s;
-                int readLen = readLine(stream, s);
-
-                if (readLen > 0)
-                {
-                    //chunk may contain trailing
-                    if (dataLen + readLen - 2 < chunkedSize)
-                    {
-                        dataLen += readLen;
-                        out += s;
-                        olen = readLen;
-                    }
-                    else
-                    {
-                        if (chunkedSize - dataLen > 0)
-                            out += s;
-                        dataLen = chunkedSize;
-                        chunkState = 0;
-                        olen = readLen;
-                    }
-                }
-                else
-                {
-                    olen = -1;
-                }
-            }
-        }
-
-        return olen;
+        return MB_Chunked::read(stream, out, chunkState, chunkedSize, dataLen);
     }
 
     int readClient(Client *client, MB_String &buf)
@@ -1589,7 +1447,7 @@ protected:
             }
 
             if (data.scnt > 0)
-                data.buf += r;
+                data.buf += (char)r;
 
             if (data.scnt == data.ecnt && data.scnt > 0)
             {
@@ -0,0 +1,166 @@
+/**
+ * MB_Chunked
+ *
+ * The decoder of the HTTP chunked transfer encoding body that is shared by the client readers.
+ *
+ * The chunk data is copied by the chunk size and the size line can be split over many reads,
+ * the decoder state is kept by the caller in these variables
+ * chunkState  - 0 new size line, 1 chunk data, 2 size digits, 3 chunk extension
+ * chunkedSize - the size of the current chunk
+ * dataLen     - the number of size digits (states 2 and 3) or the chunk data read (state 1)
+ *
+ * The read functions return the number of bytes read, 0 when more data is pending and
+ * -1 at the last (zero size) chunk.
+ *
+ * This work is an extension of the Firebase ESP Client library by K. Suwatchai (Mobizt)
+ * Copyright (c) 2026 RFID Door Lock System contributors
+ *
+ * The MIT License (MIT)
+*/
+
+#ifndef MB_Chunked_H
+#define MB_Chunked_H
+
+#include <Arduino.h>
+#include "MB_String.h"
+
+class MB_Chunked
+{
+public:
+    //read the chunk size line, the empty line (the end of previous chunk data) is skipped
+    template <typename T>
+    static bool readSize(T *stream, int &chunkState, int &chunkedSize, int &dataLen)
+    {
+        if (chunkState == 0)
+        {
+            chunkState = 2;
+            chunkedSize = 0;
+            dataLen = 0;
+        }
+
+        while (stream->available())
+        {
+            int c = stream->read();
+            if (c < 0)
+                break;
+
+            if (c == '\n')
+            {
+                if (dataLen > 0)
+                    return true;
+                chunkState = 2;
+            }
+            else if (chunkState == 2)
+            {
+                int v = c >= '0' && c <= '9' ? c - '0' : (c >= 'a' && c <= 'f' ? c - 'a' + 10 : (c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1));
+                if (v >= 0)
+                {
+                    chunkedSize = chunkedSize * 16 + v;
+                    dataLen++;
+                }
+                else if (dataLen > 0)
+                    chunkState = 3;
+            }
+        }
+
+        return false;
+    }
+
+    //the chunk data length that can be read now
+    template <typename T>
+    static int readLen(T *stream, int chunkedSize, int dataLen, int bufLen)
+    {
+        int len = chunkedSize - dataLen;
+        if (len > bufLen)
+            len = bufLen;
+        if (len > stream->available())
+            len = stream->available();
+        return len;
+    }
+
+    //read the chunk data up to bufLen bytes, the out buffer should be bufLen + 1 bytes
+    template <typename T>
+    static int read(T *stream, char *out, int &chunkState, int &chunkedSize, int &dataLen, int bufLen)
+    {
+        if (!stream)
+            return -1;
+
+        int ret = begin(stream, chunkState, chunkedSize, dataLen);
+        if (ret < 1)
+            return ret;
+
+        int len = readLen(stream, chunkedSize, dataLen, bufLen);
+        if (len <= 0)
+            return 0;
+
+        int n = stream->readBytes(out, len);
+        if (n < 0)
+            return -1;
+
+        out[n] = 0;
+        dataLen += n;
+
+        //the CRLF after the chunk data is skipped with the next size line
+        if (dataLen >= chunkedSize)
+            chunkState = 0;
+
+        return n;
+    }
+
+    //read all available chunk data of the current chunk and append to out
+    template <typename T>
+    static int read(T *stream, MB_String &out, int &chunkState, int &chunkedSize, int &dataLen)
+    {
+        if (!stream)
+            return -1;
+
+        int ret = begin(stream, chunkState, chunkedSize, dataLen);
+        if (ret < 1)
+            return ret;
+
+        char buf[256];
+        int olen = 0;
+
+        while (chunkState == 1)
+        {
+            int len = readLen(stream, chunkedSize, dataLen, sizeof(buf));
+            if (len <= 0)
+                break;
+
+            int n = stream->readBytes(buf, len);
+            if (n <= 0)
+                break;
+
+            out.appendN(buf, n);
+            dataLen += n;
+            olen += n;
+
+            if (dataLen >= chunkedSize)
+                chunkState = 0;
+        }
+
+        return olen;
+    }
+
+private:
+    //enter the chunk data state, 1 when the chunk data can be read, 0 when the size line is
+    //not complete and -1 at the last chunk
+    template <typename T>
+    static int begin(T *stream, int &chunkState, int &chunkedSize, int &dataLen)
+    {
+        if (chunkState == 1)
+            return 1;
+
+        if (!readSize(stream, chunkState, chunkedSize, dataLen))
+            return 0;
+
+        if (chunkedSize < 1)
+            return -1;
+
+        chunkState = 1;
+        dataLen = 0;
+        return 1;
+    }
+};
+
+#endif
@@ -68,6 +68,8 @@
 #endif
 
 #include "MB_JSON.h"
+#include "../extras/print/fb_json_dtoa.h"
+#include "../extras/parse/fb_json_strtod.h"
 
 /* define our own boolean type */
 #ifdef true
@@ -328,12 +330,36 @@ static MB_JSON_bool MB_JSON_parse_number(MB_JSON *const item, MB_JSON_parse_buff
     unsigned char number_c_string[64];
     unsigned char decimal_point = MB_JSON_get_decimal_point();
     size_t i = 0;
+    int64_t integer = 0;
+    int is_int = 0;
 
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
     {
         return false;
     }
 
+    /* the integer and the decimal number that fits the double significand are parsed in place,
+     * the others are parsed with strtod */
+    i = fb_json_strtod(MB_JSON_buffer_at_offset(input_buffer), input_buffer->length - input_buffer->offset, &number, &integer, &is_int);
+    if (i > 0)
+    {
+        item->valuedouble = number;
+
+        if (is_int)
+        {
+            /* use saturation in case of overflow */
+            item->valueint = integer >= INT_MAX ? INT_MAX : (integer <= INT_MIN ? INT_MIN : (int)integer);
+        }
+        else
+        {
+            item->valueint = number >= INT_MAX ? INT_MAX : (number <= (double)INT_MIN ? INT_MIN : (int)number);
+        }
+
+        item->type = MB_JSON_Number;
+        input_buffer->offset += i;
+        return true;
+    }
+
     /* copy the number into a temporary buffer and replace '.' with the decimal point
      * of the current locale (for strtod)
      * This also takes care of '\0' not necessarily being available for marking the end of the input */
@@ -574,62 +600,22 @@ static MB_JSON_bool MB_JSON_compare_double(double a, double b)
 static MB_JSON_bool MB_JSON_print_number(const MB_JSON *const item, MB_JSON_printbuffer *const output_buffer)
 {
     unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
     int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = MB_JSON_get_decimal_point();
-    double test = 0.0;
 
     if (output_buffer == NULL)
     {
         return false;
     }
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
-    {
-        length = sprintf((char *)number_buffer, "null");
-    }
-    else
-    {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char *)number_buffer, "%1.15g", d);
-
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char *)number_buffer, "%lg", &test) != 1) || !MB_JSON_compare_double((double)test, d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char *)number_buffer, "%1.17g", d);
-        }
-    }
-
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
-    {
-        return false;
-    }
-
-    /* reserve appropriate space in the output */
-    output_pointer = MB_JSON_ensure(output_buffer, (size_t)length + sizeof(""));
+    /* reserve the space for the longest number, the shortest representation that
+     * round trips is written directly to the output (NaN and Infinity as null) */
+    output_pointer = MB_JSON_ensure(output_buffer, FB_JSON_DTOA_BUFFER_SIZE);
     if (output_pointer == NULL)
     {
         return false;
     }
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
-    {
-        if (number_buffer[i] == decimal_point)
-        {
-            output_pointer[i] = '.';
-            continue;
-        }
-
-        output_pointer[i] = number_buffer[i];
-    }
-    output_pointer[i] = '\0';
+    length = fb_json_dtoa(item->valuedouble, (char *)output_pointer);
 
     output_buffer->offset += (size_t)length;
 
@@ -669,6 +669,24 @@ public:
         return (*this);
     }
 
+    //append the data of known length, slen is the current string length if known (no length scan)
+    MB_String &appendN(const char *cstr, size_t len, size_t slen = npos)
+    {
+        if (!cstr || len == 0)
+            return (*this);
+
+        if (slen == npos)
+            slen = length();
+
+        if (_reserve(slen + len, false))
+        {
+            memcpy(buf + slen, cstr, len);
+            *(buf + slen + len) = '\0';
+        }
+
+        return (*this);
+    }
+
     MB_String &appendP(PGM_P pgms, bool clear = false)
     {
         if (clear)
@@ -1528,7 +1546,7 @@ private:
         ESP.setExternalHeap();
 #endif
 
-        bool nn = ((p = (void *)malloc(newLen)) > 0);
+        bool nn = ((p = (void *)malloc(newLen)) != nullptr);
 
 #if defined(ESP8266_USE_EXTERNAL_HEAP)
         ESP.resetHeap();
@@ -1658,9 +1676,9 @@ private:
             {
                 bool nn = false;
 #if defined(BOARD_HAS_PSRAM) && defined(MB_STRING_USE_PSRAM)
-                nn = ((buf = (char *)ps_malloc(len)) > 0);
+                nn = ((buf = (char *)ps_malloc(len)) != nullptr);
 #else
-                nn = ((buf = (char *)malloc(len)) > 0);
+                nn = ((buf = (char *)malloc(len)) != nullptr);
 #endif
                 if (nn)
                 {
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// \brief Fast JSON number parser with the integer path (no floating point math)
+//        and the exact decimal path (Clinger's fast path) for the numbers that
+//        fit the double significand.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "fb_json_strtod.h"
+
+// the powers of ten that are exactly represented by double
+static const double fb_json_strtod_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+#define FB_JSON_STRTOD_MAX_EXACT_POW10 22
+#define FB_JSON_STRTOD_MAX_EXACT_INT 9007199254740992ULL // 2^53
+#define FB_JSON_STRTOD_MAX_DIGITS 19
+
+size_t fb_json_strtod(const unsigned char *str, size_t len, double *value, int64_t *ivalue, int *is_int)
+{
+    size_t i = 0;
+    int negative = 0, digits = 0, int_digits = 0, frac_digits = 0;
+    uint64_t mantissa = 0;
+    int exp10 = 0;
+
+    *is_int = 0;
+
+    if (i < len && str[i] == '-')
+    {
+        negative = 1;
+        i++;
+    }
+
+    // the leading zeros are not significant
+    while (i < len && str[i] == '0')
+    {
+        i++;
+        int_digits++;
+    }
+
+    while (i < len && str[i] >= '0' && str[i] <= '9')
+    {
+        if (digits++ >= FB_JSON_STRTOD_MAX_DIGITS)
+            return 0;
+        mantissa = mantissa * 10 + (uint64_t)(str[i++] - '0');
+        int_digits++;
+    }
+
+    if (i < len && str[i] == '.')
+    {
+        size_t j = i + 1;
+
+        // the zeros after the point are significant only after the first non zero digit
+        while (j < len && str[j] == '0' && digits == 0)
+        {
+            j++;
+            frac_digits++;
+            exp10--;
+        }
+
+        while (j < len && str[j] >= '0' && str[j] <= '9')
+        {
+            if (digits++ >= FB_JSON_STRTOD_MAX_DIGITS)
+                return 0;
+            mantissa = mantissa * 10 + (uint64_t)(str[j++] - '0');
+            frac_digits++;
+            exp10--;
+        }
+
+        // "1." is accepted as strtod does but the point alone is not a number
+        if (int_digits + frac_digits > 0)
+            i = j;
+    }
+
+    if (int_digits + frac_digits == 0)
+        return 0;
+
+    if (i < len && (str[i] == 'e' || str[i] == 'E'))
+    {
+        size_t j = i + 1;
+        int exp_negative = 0, exp = 0, exp_digits = 0;
+
+        if (j < len && (str[j] == '+' || str[j] == '-'))
+            exp_negative = str[j++] == '-';
+
+        while (j < len && str[j] >= '0' && str[j] <= '9')
+        {
+            if (exp < 10000)
+                exp = exp * 10 + (str[j] - '0');
+            j++;
+            exp_digits++;
+        }
+
+        // the exponent without digits is not the part of number
+        if (exp_digits > 0)
+        {
+            exp10 += exp_negative ? -exp : exp;
+            i = j;
+        }
+    }
+
+    // integer, no floating point math is needed for ivalue
+    if (int_digits > 0 && frac_digits == 0 && exp10 == 0 && mantissa <= (uint64_t)INT64_MAX)
+    {
+        *is_int = 1;
+        *ivalue = negative ? -(int64_t)mantissa : (int64_t)mantissa;
+    }
+
+    if (mantissa == 0)
+    {
+        *value = negative ? -0.0 : 0.0;
+        return i;
+    }
+
+    if (mantissa > FB_JSON_STRTOD_MAX_EXACT_INT)
+    {
+        // the large integer is rounded once by the conversion
+        if (exp10 != 0)
+            return 0;
+        *value = (double)mantissa;
+    }
+    else if (exp10 == 0)
+        *value = (double)mantissa;
+    else if (exp10 < 0 && exp10 >= -FB_JSON_STRTOD_MAX_EXACT_POW10)
+        *value = (double)mantissa / fb_json_strtod_pow10[-exp10];
+    else if (exp10 > 0 && exp10 <= FB_JSON_STRTOD_MAX_EXACT_POW10)
+        *value = (double)mantissa * fb_json_strtod_pow10[exp10];
+    else if (exp10 > FB_JSON_STRTOD_MAX_EXACT_POW10 && exp10 <= FB_JSON_STRTOD_MAX_EXACT_POW10 + 16)
+    {
+        // the mantissa with few digits can take the part of exponent exactly
+        uint64_t m = mantissa;
+        int e = exp10;
+        while (e > FB_JSON_STRTOD_MAX_EXACT_POW10 && m <= FB_JSON_STRTOD_MAX_EXACT_INT / 10)
+        {
+            m *= 10;
+            e--;
+        }
+
+        if (e > FB_JSON_STRTOD_MAX_EXACT_POW10)
+            return 0;
+
+        *value = (double)m * fb_json_strtod_pow10[e];
+    }
+    else
+        return 0;
+
+    if (negative)
+        *value = -*value;
+
+    return i;
+}
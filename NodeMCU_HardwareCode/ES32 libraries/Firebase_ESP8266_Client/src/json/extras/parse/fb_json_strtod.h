@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////
+// \brief Fast JSON number parser with the integer path (no floating point math)
+//        and the exact decimal path (Clinger's fast path) for the numbers that
+//        fit the double significand.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifndef FB_JSON_STRTOD_H
+#define FB_JSON_STRTOD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * Parse the number at the beginning of the string (not necessarily null terminated)
+     * \param str The string to parse
+     * \param len The length of string that can be read
+     * \param value The parsed value
+     * \param ivalue The parsed integer value when the number is integer (without fraction and exponent)
+     * \param is_int Set to 1 when the number is integer that fits int64, otherwise 0
+     * \return The number of characters that were parsed or 0 when the number can't be parsed exactly
+     * (e.g. more than 19 significant digits or large exponent), use strtod for this case
+     */
+    size_t fb_json_strtod(const unsigned char *str, size_t len, double *value, int64_t *ivalue, int *is_int);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FB_JSON_STRTOD_H
@@ -0,0 +1,347 @@
+///////////////////////////////////////////////////////////////////////////////
+// \brief Shortest round-trip double to string conversion (Grisu2) for the JSON
+//        number output, based on the Grisu2 algorithm by Florian Loitsch and
+//        the implementation of Milo Yip (MIT License).
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <string.h>
+
+#include "fb_json_dtoa.h"
+
+typedef struct
+{
+    uint64_t f;
+    int e;
+} fb_json_diyfp;
+
+#define FB_JSON_DTOA_SIGNIFICAND_SIZE 52
+#define FB_JSON_DTOA_EXPONENT_BIAS (0x3FF + FB_JSON_DTOA_SIGNIFICAND_SIZE)
+#define FB_JSON_DTOA_HIDDEN_BIT 0x0010000000000000ULL
+#define FB_JSON_DTOA_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFULL
+#define FB_JSON_DTOA_EXPONENT_MASK 0x7FF0000000000000ULL
+
+// normalized 10^k, k = -348, -340, ..., 340
+static const uint64_t fb_json_dtoa_pow10_f[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+static const int16_t fb_json_dtoa_pow10_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+static const uint64_t fb_json_dtoa_pow10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+    10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL};
+
+static fb_json_diyfp fb_json_diyfp_make(uint64_t f, int e)
+{
+    fb_json_diyfp r;
+    r.f = f;
+    r.e = e;
+    return r;
+}
+
+static fb_json_diyfp fb_json_diyfp_normalize(fb_json_diyfp v)
+{
+    while (!(v.f & 0x8000000000000000ULL))
+    {
+        v.f <<= 1;
+        v.e--;
+    }
+    return v;
+}
+
+static fb_json_diyfp fb_json_diyfp_mul(fb_json_diyfp x, fb_json_diyfp y)
+{
+    const uint64_t M32 = 0xFFFFFFFFULL;
+    const uint64_t a = x.f >> 32, b = x.f & M32, c = y.f >> 32, d = y.f & M32;
+    const uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    tmp += 1ULL << 31; // round
+    return fb_json_diyfp_make(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64);
+}
+
+// the boundaries of the value (the mid points to its neighbors) with the same exponent
+static void fb_json_diyfp_boundaries(fb_json_diyfp v, fb_json_diyfp *minus, fb_json_diyfp *plus)
+{
+    fb_json_diyfp pl = fb_json_diyfp_make((v.f << 1) + 1, v.e - 1);
+    while (!(pl.f & (FB_JSON_DTOA_HIDDEN_BIT << 1)))
+    {
+        pl.f <<= 1;
+        pl.e--;
+    }
+    pl.f <<= 64 - FB_JSON_DTOA_SIGNIFICAND_SIZE - 2;
+    pl.e -= 64 - FB_JSON_DTOA_SIGNIFICAND_SIZE - 2;
+
+    fb_json_diyfp mi = v.f == FB_JSON_DTOA_HIDDEN_BIT ? fb_json_diyfp_make((v.f << 2) - 1, v.e - 2) : fb_json_diyfp_make((v.f << 1) - 1, v.e - 1);
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+
+    *plus = pl;
+    *minus = mi;
+}
+
+static fb_json_diyfp fb_json_dtoa_cached_power(int e, int *K)
+{
+    // dk must be positive, so can do ceiling in positive
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int k = (int)dk;
+    if (dk - k > 0.0)
+        k++;
+
+    unsigned index = (unsigned)((k >> 3) + 1);
+    *K = -(-348 + (int)(index << 3));
+
+    return fb_json_diyfp_make(fb_json_dtoa_pow10_f[index], fb_json_dtoa_pow10_e[index]);
+}
+
+static void fb_json_dtoa_round(char *buffer, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+    {
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static int fb_json_dtoa_count_digits(uint32_t n)
+{
+    int d = 1;
+    while (d < 10 && n >= fb_json_dtoa_pow10[d])
+        d++;
+    return d;
+}
+
+static void fb_json_dtoa_digit_gen(fb_json_diyfp W, fb_json_diyfp Mp, uint64_t delta, char *buffer, int *len, int *K)
+{
+    const fb_json_diyfp one = fb_json_diyfp_make(1ULL << -Mp.e, Mp.e);
+    const uint64_t wp_w = Mp.f - W.f;
+    uint32_t p1 = (uint32_t)(Mp.f >> -one.e);
+    uint64_t p2 = Mp.f & (one.f - 1);
+    int kappa = fb_json_dtoa_count_digits(p1);
+    *len = 0;
+
+    while (kappa > 0)
+    {
+        uint32_t div = (uint32_t)fb_json_dtoa_pow10[kappa - 1];
+        uint32_t d = p1 / div;
+        p1 %= div;
+
+        if (d || *len)
+            buffer[(*len)++] = (char)('0' + d);
+
+        kappa--;
+
+        uint64_t tmp = ((uint64_t)p1 << -one.e) + p2;
+        if (tmp <= delta)
+        {
+            *K += kappa;
+            fb_json_dtoa_round(buffer, *len, delta, tmp, fb_json_dtoa_pow10[kappa] << -one.e, wp_w);
+            return;
+        }
+    }
+
+    for (;;)
+    {
+        p2 *= 10;
+        delta *= 10;
+        char d = (char)(p2 >> -one.e);
+
+        if (d || *len)
+            buffer[(*len)++] = (char)('0' + d);
+
+        p2 &= one.f - 1;
+        kappa--;
+
+        if (p2 < delta)
+        {
+            *K += kappa;
+            int index = -kappa;
+            fb_json_dtoa_round(buffer, *len, delta, p2, one.f, wp_w * (index < 20 ? fb_json_dtoa_pow10[index] : 0));
+            return;
+        }
+    }
+}
+
+static void fb_json_dtoa_grisu2(uint64_t bits, char *buffer, int *length, int *K)
+{
+    int biased_e = (int)((bits & FB_JSON_DTOA_EXPONENT_MASK) >> FB_JSON_DTOA_SIGNIFICAND_SIZE);
+    uint64_t significand = bits & FB_JSON_DTOA_SIGNIFICAND_MASK;
+    fb_json_diyfp v = biased_e != 0 ? fb_json_diyfp_make(significand + FB_JSON_DTOA_HIDDEN_BIT, biased_e - FB_JSON_DTOA_EXPONENT_BIAS) : fb_json_diyfp_make(significand, 1 - FB_JSON_DTOA_EXPONENT_BIAS);
+
+    fb_json_diyfp w_m, w_p;
+    fb_json_diyfp_boundaries(v, &w_m, &w_p);
+
+    const fb_json_diyfp c_mk = fb_json_dtoa_cached_power(w_p.e, K);
+    const fb_json_diyfp W = fb_json_diyfp_mul(fb_json_diyfp_normalize(v), c_mk);
+    fb_json_diyfp Wp = fb_json_diyfp_mul(w_p, c_mk);
+    fb_json_diyfp Wm = fb_json_diyfp_mul(w_m, c_mk);
+    Wm.f++;
+    Wp.f--;
+
+    fb_json_dtoa_digit_gen(W, Wp, Wp.f - Wm.f, buffer, length, K);
+}
+
+static int fb_json_dtoa_exponent(int K, char *buffer)
+{
+    int n = 0;
+    if (K < 0)
+    {
+        buffer[n++] = '-';
+        K = -K;
+    }
+
+    if (K >= 100)
+    {
+        buffer[n++] = (char)('0' + K / 100);
+        K %= 100;
+        buffer[n++] = (char)('0' + K / 10);
+        buffer[n++] = (char)('0' + K % 10);
+    }
+    else if (K >= 10)
+    {
+        buffer[n++] = (char)('0' + K / 10);
+        buffer[n++] = (char)('0' + K % 10);
+    }
+    else
+        buffer[n++] = (char)('0' + K);
+
+    return n;
+}
+
+// place the decimal point of the digits (value is digits x 10^k)
+static int fb_json_dtoa_prettify(char *buffer, int length, int k)
+{
+    const int kk = length + k; // 10^(kk-1) <= v < 10^kk
+
+    if (0 <= k && kk <= 21)
+    {
+        // 1234e7 -> 12340000000
+        for (int i = length; i < kk; i++)
+            buffer[i] = '0';
+        return kk;
+    }
+    else if (0 < kk && kk <= 21)
+    {
+        // 1234e-2 -> 12.34
+        memmove(&buffer[kk + 1], &buffer[kk], (size_t)(length - kk));
+        buffer[kk] = '.';
+        return length + 1;
+    }
+    else if (-6 < kk && kk <= 0)
+    {
+        // 1234e-6 -> 0.001234
+        const int offset = 2 - kk;
+        memmove(&buffer[offset], &buffer[0], (size_t)length);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        for (int i = 2; i < offset; i++)
+            buffer[i] = '0';
+        return length + offset;
+    }
+    else if (length == 1)
+    {
+        // 1e30
+        buffer[1] = 'e';
+        return 2 + fb_json_dtoa_exponent(kk - 1, &buffer[2]);
+    }
+
+    // 1234e30 -> 1.234e33
+    memmove(&buffer[2], &buffer[1], (size_t)(length - 1));
+    buffer[1] = '.';
+    buffer[length + 1] = 'e';
+    return length + 2 + fb_json_dtoa_exponent(kk - 1, &buffer[length + 2]);
+}
+
+static int fb_json_dtoa_u64(uint64_t v, char *buffer)
+{
+    char tmp[20];
+    int n = 0, len = 0;
+
+    do
+    {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+
+    while (n > 0)
+        buffer[len++] = tmp[--n];
+
+    return len;
+}
+
+int fb_json_dtoa(double value, char *buffer)
+{
+    uint64_t bits = 0;
+    int len = 0;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    // NaN and Infinity
+    if ((bits & FB_JSON_DTOA_EXPONENT_MASK) == FB_JSON_DTOA_EXPONENT_MASK)
+    {
+        memcpy(buffer, "null", 5);
+        return 4;
+    }
+
+    if (bits >> 63)
+    {
+        buffer[len++] = '-';
+        bits &= ~0x8000000000000000ULL;
+        value = -value;
+    }
+
+    // the integral value that can be represented exactly
+    if (value < 9007199254740992.0 && value == (double)(uint64_t)value)
+    {
+        len += fb_json_dtoa_u64((uint64_t)value, buffer + len);
+        buffer[len] = 0;
+        return len;
+    }
+
+    int length = 0, K = 0;
+    fb_json_dtoa_grisu2(bits, buffer + len, &length, &K);
+    len += fb_json_dtoa_prettify(buffer + len, length, K);
+    buffer[len] = 0;
+    return len;
+}
@@ -0,0 +1,33 @@
+///////////////////////////////////////////////////////////////////////////////
+// \brief Shortest round-trip double to string conversion (Grisu2) for the JSON
+//        number output, based on the Grisu2 algorithm by Florian Loitsch and
+//        the implementation of Milo Yip (MIT License).
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifndef FB_JSON_DTOA_H
+#define FB_JSON_DTOA_H
+
+#define FB_JSON_DTOA_BUFFER_SIZE 32
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * Convert the double to the shortest string that is parsed back to the same value
+     * The integral value (up to 2^53) is written as integer without the floating point math
+     * \param value The double value (NaN and Infinity are written as null)
+     * \param buffer The buffer with at least FB_JSON_DTOA_BUFFER_SIZE bytes
+     * \return The number of characters that are written, not counting the terminating null character
+     */
+    int fb_json_dtoa(double value, char *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FB_JSON_DTOA_H
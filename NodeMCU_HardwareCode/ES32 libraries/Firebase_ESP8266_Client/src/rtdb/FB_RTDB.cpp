@@ -128,6 +128,8 @@ bool FB_RTDB::mSetRules(FirebaseData *fbdo, MB_StringPtr rules, fb_esp_mem_stora
 
 void FB_RTDB::storeToken(MB_String &atok, const char *databaseSecret)
 {
+    //the background refresh swaps the token under the same lock and only while the token type is the auth token
+    Signer.lockAuthToken();
     atok = Signer.config->_int.auth_token;
     Signer.setTokenType(token_type_legacy_token);
     Signer.config->signer.tokens.legacy_token = databaseSecret;
@@ -135,17 +137,20 @@ void FB_RTDB::storeToken(MB_String &atok, const char *databaseSecret)
     Signer.config->_int.ltok_len = strlen(databaseSecret);
     Signer.config->_int.rtok_len = 0;
     Signer.config->_int.atok_len = 0;
+    Signer.unlockAuthToken();
     Signer.handleToken();
 }
 
 void FB_RTDB::restoreToken(MB_String &atok, fb_esp_auth_token_type tk)
 {
+    Signer.lockAuthToken();
     Signer.config->_int.auth_token = atok.c_str();
     atok.clear();
     Signer.config->signer.tokens.legacy_token = "";
     Signer.config->signer.tokens.token_type = tk;
     Signer.config->_int.atok_len = Signer.config->_int.auth_token.length();
     Signer.config->_int.ltok_len = 0;
+    Signer.unlockAuthToken();
     Signer.handleToken();
 }
 
@@ -368,7 +373,17 @@ bool FB_RTDB::buildRequest(FirebaseData *fbdo, fb_esp_method method, MB_StringPt
 
     struct fb_esp_rtdb_request_info_t req;
 
-    MB_String _path, tpath, pre, post;
+    MB_String _path, tpath, pre, post, pushKey, pushPath;
+
+    //the push to the generated key can be retried without duplicate
+    if (method == m_post && fbdo->_ss.rtdb.local_push_id && type != d_timestamp && (priority_addr == 0 || type == d_json) && makePushID(pushKey))
+    {
+        pushPath = path;
+        pushPath += '/';
+        pushPath += pushKey;
+        path = MB_StringPtr(toAddr(pushPath), mb_string_sub_type_mb_string);
+        method = m_put_nocontent;
+    }
 
     tpath = path;
     ut->replaceFirebasePath(tpath);
@@ -376,6 +391,40 @@ bool FB_RTDB::buildRequest(FirebaseData *fbdo, fb_esp_method method, MB_StringPt
 
     ut->makePath(tpath);
 
+    //the scalar writes are cached and sent later as one multi-path update
+    if (fbdo->_ss.rtdb.write_interval > 0)
+    {
+        bool scalar = type == d_integer || type == d_float || type == d_double || type == d_boolean || type == d_string;
+        MB_String key = tpath;
+        trimPathSlashes(key);
+
+        if (scalar && key.length() > 0 && priority_addr == 0 && !async && !queue && MB_String(etag).length() == 0)
+        {
+            if (method == m_put)
+                return cacheWrite(fbdo, key, payload, type);
+            else if (method == m_get && query_addr == 0 && readCachedWrite(fbdo, key, type, subtype, value_addr))
+                return true;
+        }
+
+        //keep the order of the cached writes and other requests
+        if (!flushWrites(fbdo))
+            return false;
+    }
+
+    //the cached value is revalidated with its ETag
+    bool cacheable = _readCacheSize > 0 && method == m_get && query_addr == 0 && type != d_blob && type != d_file && type != d_file_ota && MB_String(etag).length() == 0;
+    MB_String cacheKey, cacheETag;
+    if (_readCacheSize > 0)
+    {
+        cacheKey = tpath;
+        trimPathSlashes(cacheKey);
+
+        if (cacheable)
+            getReadCacheETag(cacheKey, cacheETag);
+        else if (method == m_put || method == m_put_nocontent || method == m_post || method == m_patch || method == m_patch_nocontent || method == m_delete || method == m_set_priority || method == m_restore)
+            invalidateReadCache(cacheKey);
+    }
+
     req.downloadCallback = downloadCallback;
     req.uploadCallback = uploadCallback;
 
@@ -472,6 +521,8 @@ bool FB_RTDB::buildRequest(FirebaseData *fbdo, fb_esp_method method, MB_StringPt
     req.data.address.priority = priority_addr;
     req.data.address.query = query_addr;
     req.data.etag = etag;
+    if (cacheETag.length() > 0)
+        req.data.etag = cacheETag;
     req.data.value_subtype = subtype;
     req.data.blobSize = blob_size;
     req.payload = payload;
@@ -492,6 +543,18 @@ bool FB_RTDB::buildRequest(FirebaseData *fbdo, fb_esp_method method, MB_StringPt
 
     bool ret = processRequest(fbdo, &req);
 
+    //the key of the failed push is kept to retry the write to the same key
+    if (pushKey.length() > 0)
+        fbdo->_ss.rtdb.push_name = pushKey;
+
+    if (cacheable)
+    {
+        if (fbdo->_ss.http_code == FIREBASE_ERROR_HTTP_CODE_NOT_MODIFIED && cacheETag.length() > 0)
+            ret = readCache(fbdo, cacheKey, type, subtype, value_addr);
+        else if (ret)
+            storeReadCache(fbdo, cacheKey);
+    }
+
 #if defined(ESP8266)
     if (type == d_file_ota)
         fbdo->_ss.bssl_rx_size = rx_size;
@@ -503,6 +566,375 @@ bool FB_RTDB::buildRequest(FirebaseData *fbdo, fb_esp_method method, MB_StringPt
     return ret;
 }
 
+void FB_RTDB::setLocalPushID(FirebaseData *fbdo, bool enable)
+{
+    fbdo->_ss.rtdb.local_push_id = enable;
+}
+
+String FB_RTDB::newPushID()
+{
+    MB_String key;
+    makePushID(key);
+    return key.c_str();
+}
+
+bool FB_RTDB::newPushID(FirebaseData *fbdo, String &key)
+{
+    MB_String s;
+    bool ret = makePushID(s);
+    key = s.c_str();
+
+    if (!ret)
+    {
+        fbdo->_ss.http_code = FIREBASE_ERROR_SYSTEM_TIME_NOT_SET;
+        fbdo->_ss.error.clear();
+    }
+
+    return ret;
+}
+
+bool FB_RTDB::makePushID(MB_String &key)
+{
+    key.clear();
+
+    if (time(nullptr) < ut->default_ts)
+        return false;
+
+    uint64_t ms = (uint64_t)time(nullptr) * 1000 + millis() % 1000;
+    char buf[21];
+
+#if defined(ESP32)
+    FirebaseConfig *cfg = Signer.getCfg();
+    if (cfg)
+        portENTER_CRITICAL(&cfg->_int.fb_mux);
+#endif
+
+    ut->makePushID(buf, ms, _pushMillis, _pushRand);
+
+#if defined(ESP32)
+    if (cfg)
+        portEXIT_CRITICAL(&cfg->_int.fb_mux);
+#endif
+
+    key = buf;
+    return true;
+}
+
+void FB_RTDB::setWriteCoalescing(FirebaseData *fbdo, uint32_t interval)
+{
+    if (interval == 0)
+        flushWrites(fbdo);
+
+    fbdo->_ss.rtdb.write_interval = interval;
+}
+
+bool FB_RTDB::flushWrites(FirebaseData *fbdo, bool force)
+{
+    if (fbdo->_ss.rtdb.writes.size() == 0)
+        return true;
+
+    if (!force && millis() - fbdo->_ss.rtdb.write_flush_millis < fbdo->_ss.rtdb.write_interval && fbdo->_ss.rtdb.writes.size() < MAX_COALESCED_WRITES)
+        return true;
+
+    //take the cached writes, the flush request itself is not cached
+    std::vector<struct fb_esp_rtdb_cached_write_t> writes;
+    writes.swap(fbdo->_ss.rtdb.writes);
+
+    //{"path1":value1,"path2":value2}
+    MB_String payload;
+    payload.appendP(fb_esp_pgm_str_163);
+    for (size_t i = 0; i < writes.size(); i++)
+    {
+        if (i > 0)
+            payload.appendP(fb_esp_pgm_str_132);
+        appendJsonKey(payload, writes[i].path);
+        payload.appendP(fb_esp_pgm_str_7);
+        payload += writes[i].value;
+    }
+    payload.appendP(fb_esp_pgm_str_127);
+
+    MB_String path, empty;
+    path.appendP(fb_esp_pgm_str_1);
+
+    bool ret = buildRequest(fbdo, m_patch_nocontent, MB_StringPtr(toAddr(path), mb_string_sub_type_mb_string), MB_StringPtr(toAddr(payload), mb_string_sub_type_mb_string), d_json, _NO_SUB_TYPE, _NO_REF, _NO_QUERY, _NO_PRIORITY, MB_StringPtr(toAddr(empty), mb_string_sub_type_mb_string), _NO_ASYNC, _NO_QUEUE, _NO_BLOB_SIZE, MB_StringPtr(toAddr(empty), mb_string_sub_type_mb_string));
+
+    //keep the writes to retry at the next flush
+    if (!ret)
+    {
+        for (size_t i = 0; i < fbdo->_ss.rtdb.writes.size(); i++)
+            writes.push_back(fbdo->_ss.rtdb.writes[i]);
+        writes.swap(fbdo->_ss.rtdb.writes);
+    }
+
+    fbdo->_ss.rtdb.write_flush_millis = millis();
+
+    return ret;
+}
+
+bool FB_RTDB::cacheWrite(FirebaseData *fbdo, const MB_String &key, MB_StringPtr payload, fb_esp_data_type type)
+{
+    std::vector<struct fb_esp_rtdb_cached_write_t> &writes = fbdo->_ss.rtdb.writes;
+
+    //the paths in a multi-path update can't overlap
+    for (size_t i = 0; i < writes.size(); i++)
+    {
+        if (isChildPath(key, writes[i].path))
+        {
+            if (!flushWrites(fbdo))
+                return false;
+            break;
+        }
+    }
+
+    //last writer wins, the older values at this path and its children are replaced
+    for (size_t i = 0; i < writes.size();)
+    {
+        if (strcmp(writes[i].path.c_str(), key.c_str()) == 0 || isChildPath(writes[i].path, key))
+            writes.erase(writes.begin() + i);
+        else
+            i++;
+    }
+
+    if (writes.size() == 0)
+        fbdo->_ss.rtdb.write_flush_millis = millis();
+
+    struct fb_esp_rtdb_cached_write_t item;
+    item.path = key;
+    item.type = type;
+    if (type == d_string)
+        item.value.appendP(fb_esp_pgm_str_3);
+    item.value += payload;
+    if (type == d_string)
+        item.value.appendP(fb_esp_pgm_str_3);
+    writes.push_back(item);
+
+    fbdo->_ss.http_code = FIREBASE_ERROR_HTTP_CODE_OK;
+    fbdo->_ss.error.clear();
+
+    return flushWrites(fbdo, false);
+}
+
+bool FB_RTDB::readCachedWrite(FirebaseData *fbdo, const MB_String &key, fb_esp_data_type type, int subtype, uint32_t value_addr)
+{
+    std::vector<struct fb_esp_rtdb_cached_write_t> &writes = fbdo->_ss.rtdb.writes;
+
+    for (size_t i = 0; i < writes.size(); i++)
+    {
+        if (strcmp(writes[i].path.c_str(), key.c_str()) != 0)
+            continue;
+
+        bool num = type == d_integer || type == d_float || type == d_double;
+        bool cachedNum = writes[i].type == d_integer || writes[i].type == d_float || writes[i].type == d_double;
+        if (writes[i].type != type && !(num && cachedNum))
+            return false;
+
+        setCachedValue(fbdo, key, writes[i].value, writes[i].type, type, subtype, value_addr);
+
+        return true;
+    }
+
+    return false;
+}
+
+void FB_RTDB::setCachedValue(FirebaseData *fbdo, const MB_String &key, const MB_String &value, fb_esp_data_type cachedType, fb_esp_data_type type, int subtype, uint32_t value_addr)
+{
+    fbdo->_ss.rtdb.path.clear();
+    fbdo->_ss.rtdb.path.appendP(fb_esp_pgm_str_1);
+    fbdo->_ss.rtdb.path += key;
+    fbdo->_ss.rtdb.raw = value;
+    fbdo->_ss.rtdb.req_method = m_get;
+    fbdo->_ss.rtdb.req_data_type = type;
+    fbdo->_ss.rtdb.resp_data_type = cachedType;
+    if (cachedType == d_string)
+        fbdo->setRaw(true);
+    fbdo->_ss.rtdb.data_available = true;
+    fbdo->_ss.rtdb.path_not_found = false;
+    fbdo->_ss.http_code = FIREBASE_ERROR_HTTP_CODE_OK;
+    fbdo->_ss.error.clear();
+
+    if (fbdo->_ss.jsonPtr)
+        fbdo->_ss.jsonPtr->clear();
+
+    if (fbdo->_ss.arrPtr)
+        fbdo->_ss.arrPtr->clear();
+
+    struct fb_esp_rtdb_request_info_t req;
+    req.method = m_get;
+    req.data.type = type;
+    req.data.value_subtype = subtype;
+    req.data.address.dout = value_addr;
+    setRefValue(fbdo, &req);
+}
+
+void FB_RTDB::setReadCache(size_t size)
+{
+    if (size > MAX_READ_CACHE_SIZE)
+        size = MAX_READ_CACHE_SIZE;
+
+    lockReadCache();
+    _readCacheSize = size;
+    while (_readCache.size() > _readCacheSize)
+        _readCache.erase(_readCache.begin());
+    unlockReadCache();
+}
+
+void FB_RTDB::getReadCacheETag(const MB_String &key, MB_String &etag)
+{
+    lockReadCache();
+    for (size_t i = 0; i < _readCache.size(); i++)
+    {
+        if (strcmp(_readCache[i].path.c_str(), key.c_str()) == 0)
+        {
+            etag = _readCache[i].etag;
+            break;
+        }
+    }
+    unlockReadCache();
+}
+
+bool FB_RTDB::readCache(FirebaseData *fbdo, const MB_String &key, fb_esp_data_type type, int subtype, uint32_t value_addr)
+{
+    bool ret = false;
+    struct fb_esp_rtdb_read_cache_t item;
+
+    lockReadCache();
+    for (size_t i = 0; i < _readCache.size(); i++)
+    {
+        if (strcmp(_readCache[i].path.c_str(), key.c_str()) == 0)
+        {
+            //the most recently used item is at the end
+            item = _readCache[i];
+            _readCache.erase(_readCache.begin() + i);
+            _readCache.push_back(item);
+            ret = true;
+            break;
+        }
+    }
+    unlockReadCache();
+
+    if (ret)
+    {
+        setCachedValue(fbdo, key, item.value, item.type, type, subtype, value_addr);
+        fbdo->_ss.rtdb.resp_etag = item.etag;
+    }
+
+    return ret;
+}
+
+void FB_RTDB::storeReadCache(FirebaseData *fbdo, const MB_String &key)
+{
+    fb_esp_data_type type = fbdo->_ss.rtdb.resp_data_type;
+
+    if (fbdo->_ss.rtdb.resp_etag.length() == 0 || type == d_any || type == d_blob || type == d_file || type == d_file_ota)
+        return;
+
+    struct fb_esp_rtdb_read_cache_t item;
+    item.path = key;
+    item.etag = fbdo->_ss.rtdb.resp_etag;
+    item.type = type;
+    if (type == d_string)
+        item.value.appendP(fb_esp_pgm_str_3);
+    item.value += fbdo->_ss.rtdb.raw;
+    if (type == d_string)
+        item.value.appendP(fb_esp_pgm_str_3);
+
+    lockReadCache();
+    for (size_t i = 0; i < _readCache.size(); i++)
+    {
+        if (strcmp(_readCache[i].path.c_str(), key.c_str()) == 0)
+        {
+            _readCache.erase(_readCache.begin() + i);
+            break;
+        }
+    }
+
+    //evict the least recently used
+    if (_readCache.size() >= _readCacheSize)
+        _readCache.erase(_readCache.begin());
+
+    _readCache.push_back(item);
+    unlockReadCache();
+}
+
+void FB_RTDB::invalidateReadCache(const MB_String &key)
+{
+    if (_readCacheSize == 0)
+        return;
+
+    //the key of the root ("" or "/") covers all cached paths
+    MB_String parent = key;
+    trimPathSlashes(parent);
+
+    lockReadCache();
+    if (parent.length() == 0)
+        _readCache.clear();
+
+    for (size_t i = 0; i < _readCache.size();)
+    {
+        if (strcmp(_readCache[i].path.c_str(), parent.c_str()) == 0 || isChildPath(_readCache[i].path, parent) || isChildPath(parent, _readCache[i].path))
+            _readCache.erase(_readCache.begin() + i);
+        else
+            i++;
+    }
+    unlockReadCache();
+}
+
+void FB_RTDB::lockReadCache()
+{
+#if defined(ESP32)
+    //the stream task may invalidate the cache
+    if (!_readCacheMutex)
+        _readCacheMutex = xSemaphoreCreateMutex();
+    if (_readCacheMutex)
+        xSemaphoreTake(_readCacheMutex, portMAX_DELAY);
+#endif
+}
+
+void FB_RTDB::unlockReadCache()
+{
+#if defined(ESP32)
+    if (_readCacheMutex)
+        xSemaphoreGive(_readCacheMutex);
+#endif
+}
+
+void FB_RTDB::trimPathSlashes(MB_String &path)
+{
+    while (path.length() > 0 && path[0] == '/')
+        path.erase(0, 1);
+    while (path.length() > 0 && path[path.length() - 1] == '/')
+        path.erase(path.length() - 1, 1);
+}
+
+void FB_RTDB::appendJsonKey(MB_String &buf, const MB_String &key)
+{
+    //the path is the key of the multi-path update, the quotes, backslashes and control characters are escaped
+    char hex[7];
+    buf.appendP(fb_esp_pgm_str_3);
+    for (size_t i = 0; i < key.length(); i++)
+    {
+        unsigned char c = (unsigned char)key[i];
+        if (c == '"' || c == '\\')
+        {
+            buf += '\\';
+            buf += (char)c;
+        }
+        else if (c < 0x20)
+        {
+            snprintf(hex, sizeof(hex), "\\u%04x", c);
+            buf += hex;
+        }
+        else
+            buf += (char)c;
+    }
+    buf.appendP(fb_esp_pgm_str_3);
+}
+
+bool FB_RTDB::isChildPath(const MB_String &path, const MB_String &parent)
+{
+    return path.length() > parent.length() && path[parent.length()] == '/' && strncmp(path.c_str(), parent.c_str(), parent.length()) == 0;
+}
+
 bool FB_RTDB::mDeleteNodesByTimestamp(FirebaseData *fbdo, MB_StringPtr path, MB_StringPtr timestampNode, MB_StringPtr limit, MB_StringPtr dataRetentionPeriod)
 {
     if (fbdo->_ss.rtdb.pause)
@@ -603,9 +1035,7 @@ bool FB_RTDB::mBeginStream(FirebaseData *fbdo, MB_StringPtr path)
 
     clearDataStatus(fbdo);
 
-    fb_esp_rtdb_request_info_t req;
-
-    return waitResponse(fbdo, &req);
+    return waitStreamResponse(fbdo, true);
 }
 
 bool FB_RTDB::mBeginMultiPathStream(FirebaseData *fbdo, MB_StringPtr parentPath)
@@ -723,9 +1153,7 @@ bool FB_RTDB::handleStreamRead(FirebaseData *fbdo)
         fbdo->_ss.con_mode = fb_esp_con_mode_rtdb_stream;
     }
     
-    fb_esp_rtdb_request_info_t req;
-
-    if (!waitResponse(fbdo, &req))
+    if (!waitStreamResponse(fbdo, false))
         return ret;
 
     return true;
@@ -1140,14 +1568,11 @@ void FB_RTDB::endAutoRunErrorQueue(FirebaseData *fbdo)
 
 void FB_RTDB::clearErrorQueue(FirebaseData *fbdo)
 {
-    for (uint8_t i = 0; i < fbdo->_qMan.size(); i++)
-    {
-        if (!fbdo->_qMan._queueCollection)
-            return;
+    if (!fbdo->_qMan._queueCollection)
+        return;
 
-        QueueItem item = fbdo->_qMan._queueCollection->at(i);
-        fbdo->clearQueueItem(&item);
-    }
+    //the items are copies, remove them from the collection itself
+    fbdo->_qMan._queueCollection->clear();
 }
 
 void FB_RTDB::setMaxRetry(FirebaseData *fbdo, uint8_t num)
@@ -1280,6 +1705,7 @@ uint8_t FB_RTDB::openErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, fb_es
 
 #endif
 
+    ut->mbfs->close(mbfs_type storageType);
     return count;
 }
 
@@ -1495,6 +1921,739 @@ bool FB_RTDB::mRestore(FirebaseData *fbdo, fb_esp_mem_storage_type storageType,
     return ret;
 }
 
+bool FB_RTDB::mBackupChunks(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, MB_StringPtr nodePath, MB_StringPtr fileName, size_t keysPerChunk, RTDB_DownloadProgressCallback callback)
+{
+    MB_String path = nodePath, base = fileName, filename, first, last;
+    ut->makePath(base);
+
+    if (keysPerChunk == 0)
+        keysPerChunk = 1;
+
+    //the manifest keeps the node path, chunk count and status, each chunk has its own record
+    FirebaseJson manifest, record;
+    FirebaseJsonData data;
+    int count = 0;
+    bool resume = false;
+
+    //resume the interrupted backup of the same node
+    if (loadChunkManifest(fbdo, manifest, storageType, base, -1))
+    {
+        manifest.get(data, pgm2Str(fb_esp_pgm_str_603));
+        if (data.success && strcmp(data.to<const char *>(), path.c_str()) == 0)
+        {
+            manifest.get(data, pgm2Str(fb_esp_pgm_str_602));
+            resume = data.success && data.intValue == 0;
+        }
+    }
+
+    if (resume)
+    {
+        manifest.get(data, pgm2Str(fb_esp_pgm_str_604));
+        count = data.intValue;
+    }
+    else
+    {
+        //the chunk count is increased when the chunk was saved
+        manifest.clear();
+        manifest.set(pgm2Str(fb_esp_pgm_str_603), path.c_str());
+        manifest.set(pgm2Str(fb_esp_pgm_str_604), 0);
+        manifest.set(pgm2Str(fb_esp_pgm_str_602), 0);
+
+        if (!saveChunkManifest(fbdo, manifest, storageType, base, -1))
+            return false;
+    }
+
+    MB_String after;
+
+    //download again the saved chunks that were changed by their key range
+    for (int i = 0; i < count; i++)
+    {
+        //the chunks from the one without record are downloaded again
+        if (!loadChunkManifest(fbdo, record, storageType, base, i))
+        {
+            count = i;
+            manifest.set(pgm2Str(fb_esp_pgm_str_604), count);
+            break;
+        }
+
+        recordKey(record, fb_esp_pgm_str_598, first);
+        recordKey(record, fb_esp_pgm_str_599, last);
+        after = last;
+
+        if (chunkValid(record, storageType, base, i))
+            continue;
+
+        QueryFilter query;
+        MB_String start, end;
+
+        //the node without children is saved as a single chunk
+        if (first.length() > 0)
+        {
+            queryKey(start, first);
+            queryKey(end, last);
+            query.orderBy(pgm2Str(fb_esp_pgm_str_596));
+            query.startAt(start.c_str());
+            query.endAt(end.c_str());
+        }
+
+        if (!downloadChunk(fbdo, storageType, path, base, i, first.length() > 0 ? &query : nullptr, callback) ||
+            !saveChunk(fbdo, manifest, storageType, base, i, first, last))
+            return false;
+    }
+
+    //the next chunk starts at the last key of the previous chunk which was already saved
+    for (int i = count;; i++)
+    {
+        QueryFilter query;
+        MB_String start;
+
+        query.orderBy(pgm2Str(fb_esp_pgm_str_596));
+        if (after.length() > 0)
+        {
+            queryKey(start, after);
+            query.startAt(start.c_str());
+        }
+        query.limitToFirst((int)(keysPerChunk + (after.length() > 0 ? 1 : 0)));
+
+        if (!downloadChunk(fbdo, storageType, path, base, i, &query, callback))
+            return false;
+
+        chunkFileName(filename, base, i);
+
+        size_t keys = 0;
+        if (!scanChunkKeys(storageType, filename, after, first, last, keys))
+        {
+            fbdo->_ss.http_code = MB_FILE_ERROR_FILE_IO_ERROR;
+            return false;
+        }
+
+        //no more keys after the previous chunk
+        if (keys == 0 && i > 0)
+        {
+            ut->mbfs->remove(filename, mbfs_type storageType);
+            break;
+        }
+
+        //the node without children e.g. null or primitive value is saved as a single chunk
+        if (keys == 0 && !downloadChunk(fbdo, storageType, path, base, i, nullptr, callback))
+            return false;
+
+        if (!saveChunk(fbdo, manifest, storageType, base, i, first, last))
+            return false;
+
+        if (keys < keysPerChunk)
+            break;
+
+        after = last;
+    }
+
+    manifest.set(pgm2Str(fb_esp_pgm_str_602), 1);
+    return saveChunkManifest(fbdo, manifest, storageType, base, -1);
+}
+
+bool FB_RTDB::downloadChunk(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, const MB_String &path, const MB_String &base, int index, QueryFilter *query, RTDB_DownloadProgressCallback callback)
+{
+    MB_String filename;
+    chunkFileName(filename, base, index);
+
+    struct fb_esp_rtdb_request_info_t req;
+    req.filename = filename;
+    req.path = path;
+    req.method = m_download;
+    req.data.type = d_json;
+    req.storageType = storageType;
+    req.downloadCallback = callback;
+
+    if (query)
+        req.data.address.query = getAddr(query);
+
+    fbdo->_ss.rtdb.path = req.path;
+    fbdo->_ss.rtdb.filename = req.filename;
+
+    return handleRequest(fbdo, &req);
+}
+
+bool FB_RTDB::saveChunk(FirebaseData *fbdo, FirebaseJson &manifest, fb_esp_mem_storage_type storageType, const MB_String &base, int index, const MB_String &first, const MB_String &last)
+{
+    MB_String filename;
+    chunkFileName(filename, base, index);
+
+    uint32_t crc = 0;
+    size_t len = 0;
+
+    if (!chunkFileCRC(storageType, filename, crc, len))
+    {
+        fbdo->_ss.http_code = MB_FILE_ERROR_FILE_IO_ERROR;
+        return false;
+    }
+
+    //the record of each chunk is a small file, the write cost does not grow with the chunk count
+    FirebaseJson record;
+    record.set(pgm2Str(fb_esp_pgm_str_598), first.c_str());
+    record.set(pgm2Str(fb_esp_pgm_str_599), last.c_str());
+    record.set(pgm2Str(fb_esp_pgm_str_600), MB_String(crc, 16).c_str());
+    record.set(pgm2Str(fb_esp_pgm_str_601), (int)len);
+    record.set(pgm2Str(fb_esp_pgm_str_602), 1);
+
+    if (!saveChunkManifest(fbdo, record, storageType, base, index))
+        return false;
+
+    FirebaseJsonData data;
+    manifest.get(data, pgm2Str(fb_esp_pgm_str_604));
+    if (data.intValue >= index + 1)
+        return true;
+
+    //the progress is kept for the next call when the backup was interrupted
+    manifest.set(pgm2Str(fb_esp_pgm_str_604), index + 1);
+    return saveChunkManifest(fbdo, manifest, storageType, base, -1);
+}
+
+bool FB_RTDB::mRestoreChunks(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, MB_StringPtr nodePath, MB_StringPtr fileName, RTDB_UploadProgressCallback callback)
+{
+    MB_String path = nodePath, base = fileName, filename;
+    ut->makePath(base);
+
+    FirebaseJson manifest, record;
+    FirebaseJsonData data;
+
+    if (!loadChunkManifest(fbdo, manifest, storageType, base, -1))
+        return false;
+
+    //the backup was not completed
+    manifest.get(data, pgm2Str(fb_esp_pgm_str_602));
+    if (!data.success || data.intValue != 1)
+    {
+        fbdo->_ss.http_code = FIREBASE_ERROR_BACKUP_CHUNK_INVALID;
+        return false;
+    }
+
+    manifest.get(data, pgm2Str(fb_esp_pgm_str_604));
+    int count = data.intValue;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!loadChunkManifest(fbdo, record, storageType, base, i))
+            return false;
+
+        record.get(data, pgm2Str(fb_esp_pgm_str_602));
+        if (!data.success)
+            data.intValue = 0;
+
+        //restored by the interrupted call
+        if (data.intValue == 2)
+            continue;
+
+        if (data.intValue != 1 || !chunkValid(record, storageType, base, i))
+        {
+            fbdo->_ss.http_code = FIREBASE_ERROR_BACKUP_CHUNK_INVALID;
+            return false;
+        }
+
+        record.get(data, pgm2Str(fb_esp_pgm_str_601));
+
+        //the empty chunk contains only null
+        if (data.intValue > 4)
+        {
+            chunkFileName(filename, base, i);
+
+            struct fb_esp_rtdb_request_info_t req;
+            req.filename = filename;
+            req.path = path;
+            req.method = m_restore;
+            req.data.type = d_json;
+            req.storageType = storageType;
+            req.uploadCallback = callback;
+
+            fbdo->_ss.rtdb.path = req.path;
+            fbdo->_ss.rtdb.filename = req.filename;
+
+            if (!handleRequest(fbdo, &req))
+                return false;
+        }
+
+        record.set(pgm2Str(fb_esp_pgm_str_602), 2);
+
+        if (!saveChunkManifest(fbdo, record, storageType, base, i))
+            return false;
+    }
+
+    //the backup can be restored again
+    for (int i = 0; i < count; i++)
+    {
+        if (!loadChunkManifest(fbdo, record, storageType, base, i))
+            return false;
+
+        record.set(pgm2Str(fb_esp_pgm_str_602), 1);
+
+        if (!saveChunkManifest(fbdo, record, storageType, base, i))
+            return false;
+    }
+
+    return true;
+}
+
+bool FB_RTDB::scanChunkKeys(fb_esp_mem_storage_type storageType, const MB_String &filename, const MB_String &after, MB_String &first, MB_String &last, size_t &count)
+{
+    first.clear();
+    last.clear();
+    count = 0;
+
+    if (ut->mbfs->open(filename, mbfs_type storageType, mb_file_open_mode_read) < 0)
+        return false;
+
+    //the top-level keys are read from the file block by block without keeping the child values
+    char *buf = (char *)ut->newP(512);
+    char out[4];
+    int read = 0, depth = 0;
+    bool inStr = false, isKey = false;
+    char prev = 0;
+    uint8_t esc = 0;
+    uint32_t cp = 0;
+    MB_String key;
+
+    while ((read = ut->mbfs->read(mbfs_type storageType, (uint8_t *)buf, 512)) > 0)
+    {
+        for (int i = 0; i < read; i++)
+        {
+            char c = buf[i];
+
+            if (inStr)
+            {
+                if (esc == 0 && c == '"')
+                {
+                    inStr = false;
+
+                    //the key of the previous chunk is not counted
+                    if (isKey && (after.length() == 0 || compareKeys(key.c_str(), after.c_str()) > 0))
+                    {
+                        if (count == 0 || compareKeys(key.c_str(), first.c_str()) < 0)
+                            first = key;
+                        if (count == 0 || compareKeys(key.c_str(), last.c_str()) > 0)
+                            last = key;
+                        count++;
+                    }
+                }
+                else if (isKey)
+                {
+                    int n = ut->decodeJsonChar(c, esc, cp, out);
+                    if (n > 0)
+                        key.appendN(out, n);
+                }
+                else
+                    esc = esc == 0 && c == '\\' ? 1 : 0;
+
+                continue;
+            }
+
+            switch (c)
+            {
+            case '{':
+            case '[':
+                depth++;
+                prev = c;
+                break;
+            case '}':
+            case ']':
+                depth--;
+                prev = c;
+                break;
+            case ',':
+            case ':':
+                prev = c;
+                break;
+            case '"':
+                inStr = true;
+                isKey = depth == 1 && (prev == '{' || prev == ',');
+                esc = 0;
+                cp = 0;
+                key.clear();
+                break;
+            default:
+                break;
+            }
+        }
+        ut->idle();
+    }
+
+    ut->mbfs->close(mbfs_type storageType);
+    ut->delP(&buf);
+    return true;
+}
+
+void FB_RTDB::queryKey(MB_String &value, const MB_String &key)
+{
+    //the key is the JSON string of the query argument which was URL encoded
+    MB_String s;
+    for (size_t i = 0; i < key.length(); i++)
+    {
+        if (key[i] == '"' || key[i] == '\\')
+            s += '\\';
+        s += key[i];
+    }
+    value = ut->url_encode(s);
+}
+
+bool FB_RTDB::loadChunkManifest(FirebaseData *fbdo, FirebaseJson &manifest, fb_esp_mem_storage_type storageType, const MB_String &base, int index)
+{
+    MB_String filename;
+    manifestFileName(filename, base, index);
+
+    int sz = ut->mbfs->open(filename, mbfs_type storageType, mb_file_open_mode_read);
+
+    if (sz < 0)
+    {
+        fbdo->_ss.http_code = sz;
+        return false;
+    }
+
+    char *buf = (char *)ut->newP(sz + 1);
+    int read = ut->mbfs->read(mbfs_type storageType, (uint8_t *)buf, sz);
+    ut->mbfs->close(mbfs_type storageType);
+
+    bool ret = sz > 0 && read == sz && manifest.setJsonData(buf);
+    ut->delP(&buf);
+
+    if (!ret)
+        fbdo->_ss.http_code = FIREBASE_ERROR_BACKUP_CHUNK_INVALID;
+
+    return ret;
+}
+
+bool FB_RTDB::saveChunkManifest(FirebaseData *fbdo, FirebaseJson &manifest, fb_esp_mem_storage_type storageType, const MB_String &base, int index)
+{
+    MB_String filename, str;
+    manifestFileName(filename, base, index);
+    manifest.toString(str);
+
+    int ret = ut->mbfs->open(filename, mbfs_type storageType, mb_file_open_mode_write);
+
+    if (ret < 0)
+    {
+        fbdo->_ss.http_code = ret;
+        return false;
+    }
+
+    ret = ut->mbfs->write(mbfs_type storageType, (uint8_t *)str.c_str(), str.length());
+    ut->mbfs->close(mbfs_type storageType);
+
+    if (ret != (int)str.length())
+    {
+        fbdo->_ss.http_code = MB_FILE_ERROR_FILE_IO_ERROR;
+        return false;
+    }
+
+    return true;
+}
+
+void FB_RTDB::recordKey(FirebaseJson &record, PGM_P name, MB_String &key)
+{
+    FirebaseJsonData data;
+    record.get(data, pgm2Str(name));
+    key.clear();
+
+    if (!data.success)
+        return;
+
+    //the string value is still JSON escaped
+    char out[4];
+    uint8_t esc = 0;
+    uint32_t cp = 0;
+    for (size_t i = 0; i < data.stringValue.length(); i++)
+    {
+        int n = ut->decodeJsonChar(data.stringValue[i], esc, cp, out);
+        if (n > 0)
+            key.appendN(out, n);
+    }
+}
+
+void FB_RTDB::manifestFileName(MB_String &filename, const MB_String &base, int index)
+{
+    //<base>.mft for the manifest, <base>.000.mft and so on for the chunk records
+    if (index < 0)
+        filename = base;
+    else
+        chunkFileName(filename, base, index);
+    filename.appendP(fb_esp_pgm_str_595);
+}
+
+void FB_RTDB::chunkFileName(MB_String &filename, const MB_String &base, int index)
+{
+    //<base>.000 to <base>.999, <base>.1000 and so on
+    filename = base;
+    filename.appendP(fb_esp_pgm_str_4);
+    if (index < 100)
+        filename += '0';
+    if (index < 10)
+        filename += '0';
+    filename += index;
+}
+
+bool FB_RTDB::chunkFileCRC(fb_esp_mem_storage_type storageType, const MB_String &filename, uint32_t &crc, size_t &len)
+{
+    if (ut->mbfs->open(filename, mbfs_type storageType, mb_file_open_mode_read) < 0)
+        return false;
+
+    FastCRC32 CRC32;
+    FastCRC32_Context ctx;
+    CRC32.crc32_begin(ctx);
+
+    uint8_t *buf = (uint8_t *)ut->newP(512);
+    int read = 0;
+
+    while ((read = ut->mbfs->read(mbfs_type storageType, buf, 512)) > 0)
+    {
+        CRC32.update(ctx, buf, read);
+        ut->idle();
+    }
+
+    ut->mbfs->close(mbfs_type storageType);
+    ut->delP(&buf);
+
+    crc = CRC32.result(ctx);
+    len = ctx.length;
+    return true;
+}
+
+bool FB_RTDB::chunkValid(FirebaseJson &record, fb_esp_mem_storage_type storageType, const MB_String &base, int index)
+{
+    FirebaseJsonData data;
+    MB_String filename;
+    uint32_t crc = 0;
+    size_t len = 0;
+
+    chunkFileName(filename, base, index);
+
+    if (!chunkFileCRC(storageType, filename, crc, len))
+        return false;
+
+    record.get(data, pgm2Str(fb_esp_pgm_str_601));
+    if (!data.success || (size_t)data.intValue != len)
+        return false;
+
+    record.get(data, pgm2Str(fb_esp_pgm_str_600));
+    if (!data.success || data.stringValue.length() == 0)
+        return false;
+
+    return strtoul(data.stringValue.c_str(), NULL, 16) == crc;
+}
+
+int FB_RTDB::compareKeys(const char *a, const char *b)
+{
+    //the database orders the 32-bit integer keys numerically before the string keys
+    int64_t va = 0, vb = 0;
+    bool ia = ut->isIntKey(a, va), ib = ut->isIntKey(b, vb);
+
+    if (ia && ib)
+        return va < vb ? -1 : (va > vb ? 1 : 0);
+
+    if (ia != ib)
+        return ia ? -1 : 1;
+
+    return strcmp(a, b);
+}
+
+void FB_RTDB::mBeginKeyCursor(RTDB_KeyCursor *cursor, MB_StringPtr path, size_t pageSize)
+{
+    if (!cursor)
+        return;
+
+    cursor->path = path;
+    cursor->lastKey.clear();
+    cursor->pageSize = pageSize > 0 ? pageSize : 1;
+    cursor->count = 0;
+    cursor->childSize = 0;
+    cursor->done = false;
+}
+
+bool FB_RTDB::readKeys(FirebaseData *fbdo, RTDB_KeyCursor *cursor, RTDB_KeyCallback callback)
+{
+    size_t count = 0;
+    return mReadKeys(fbdo, cursor, callback, nullptr, 0, count);
+}
+
+size_t FB_RTDB::readKeys(FirebaseData *fbdo, RTDB_KeyCursor *cursor, String *keys, size_t size)
+{
+    size_t count = 0;
+    if (keys && size > 0)
+        mReadKeys(fbdo, cursor, NULL, keys, size, count);
+    return count;
+}
+
+bool FB_RTDB::mGetKeys(FirebaseData *fbdo, MB_StringPtr path, RTDB_KeyCallback callback, size_t pageSize)
+{
+    RTDB_KeyCursor cursor;
+    mBeginKeyCursor(&cursor, path, pageSize);
+
+    size_t count = 0;
+    while (!cursor.done)
+    {
+        if (!mReadKeys(fbdo, &cursor, callback, nullptr, 0, count))
+            return false;
+    }
+
+    return true;
+}
+
+bool FB_RTDB::mReadKeys(FirebaseData *fbdo, RTDB_KeyCursor *cursor, RTDB_KeyCallback callback, String *buf, size_t size, size_t &count)
+{
+    count = 0;
+
+    if (!cursor || cursor->done)
+        return true;
+
+    size_t pageSize = cursor->pageSize > 0 ? cursor->pageSize : 1;
+    if (buf && size < pageSize)
+        pageSize = size;
+
+    //the pending coalesced writes should be visible to the key listing
+    if (fbdo->_ss.rtdb.writes.size() > 0 && !flushWrites(fbdo))
+        return false;
+
+    //the next page starts at the last key of the previous page which will be skipped
+    bool next = cursor->lastKey.length() > 0;
+    size_t limit = 0;
+
+    //the page is returned with the child values, limit the page to the response buffer
+    //with the child size of the previous page
+    if (cursor->childSize > 0)
+    {
+        size_t fit = fbdo->_ss.resp_size / cursor->childSize;
+        if (next && fit > 0)
+            fit--;
+        if (fit < pageSize)
+            pageSize = fit > 0 ? fit : 1;
+    }
+
+    MB_String start;
+    if (next)
+        queryKey(start, cursor->lastKey);
+
+    while (true)
+    {
+        limit = pageSize + (next ? 1 : 0);
+
+        QueryFilter query;
+        query.orderBy(pgm2Str(fb_esp_pgm_str_596));
+        if (next)
+            query.startAt(start.c_str());
+        query.limitToFirst((int)limit);
+
+        struct fb_esp_rtdb_request_info_t req;
+        req.path = cursor->path;
+        req.method = m_get;
+        req.data.type = d_json;
+        req.data.address.query = getAddr(&query);
+
+        fbdo->_ss.rtdb.path = req.path;
+
+        if (handleRequest(fbdo, &req))
+            break;
+
+        //the values of the page did not fit in the response buffer, read the smaller page
+        if (fbdo->_ss.http_code != FIREBASE_ERROR_BUFFER_OVERFLOW || pageSize == 1)
+            return false;
+
+        pageSize /= 2;
+    }
+
+    std::vector<MB_String> keys;
+
+    //the keys are read from the raw payload without parsing the child values
+    if (fbdo->_ss.rtdb.resp_data_type == d_json)
+        getTopLevelKeys(fbdo->_ss.rtdb.raw.c_str(), keys);
+
+    if (keys.size() > 0)
+        cursor->childSize = fbdo->_ss.rtdb.raw.length() / keys.size() + 1;
+
+    fbdo->_ss.rtdb.raw.clear();
+
+    //the REST response is not ordered
+    std::sort(keys.begin(), keys.end(), [this](const MB_String &a, const MB_String &b)
+              { return compareKeys(a.c_str(), b.c_str()) < 0; });
+
+    size_t i = next && keys.size() > 0 && strcmp(keys[0].c_str(), cursor->lastKey.c_str()) == 0 ? 1 : 0;
+    bool stop = false;
+
+    for (; i < keys.size() && count < pageSize; i++)
+    {
+        if (buf)
+            buf[count] = keys[i].c_str();
+
+        if (callback && !callback(keys[i].c_str(), cursor->count))
+            stop = true;
+
+        cursor->lastKey = keys[i];
+        cursor->count++;
+        count++;
+
+        if (stop)
+            break;
+    }
+
+    if (stop || keys.size() < limit)
+        cursor->done = true;
+
+    return true;
+}
+
+void FB_RTDB::getTopLevelKeys(const char *raw, std::vector<MB_String> &keys)
+{
+    int depth = 0;
+    bool inStr = false, isKey = false;
+    char last = 0;
+    uint8_t esc = 0;
+    uint32_t cp = 0;
+    MB_String key;
+
+    for (const char *p = raw; p && *p; p++)
+    {
+        if (inStr)
+        {
+            if (*p == '"' && esc != 1)
+            {
+                inStr = false;
+                esc = 0;
+                cp = 0;
+                if (isKey)
+                    keys.push_back(key);
+                continue;
+            }
+
+            //the keys are unescaped as the other decoded strings
+            char out[4];
+            int n = ut->decodeJsonChar(*p, esc, cp, out);
+            if (isKey)
+                key.appendN(out, n);
+            continue;
+        }
+
+        switch (*p)
+        {
+        case '{':
+        case '[':
+            depth++;
+            last = *p;
+            break;
+        case '}':
+        case ']':
+            depth--;
+            last = *p;
+            break;
+        case ',':
+        case ':':
+            last = *p;
+            break;
+        case '"':
+            inStr = true;
+            isKey = depth == 1 && (last == '{' || last == ',');
+            key.clear();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
 void FB_RTDB::setRefValue(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req)
 {
     if (req->data.address.dout > 0 && req->method == m_get)
@@ -1701,8 +2860,150 @@ void FB_RTDB::allowMultipleRequests(bool enable)
 
     cfg->_int.fb_multiple_requests = enable;
 }
+
+void FB_RTDB::setMaxConcurrentRequests(uint8_t max)
+{
+    FirebaseConfig *cfg = Signer.getCfg();
+    if (!cfg)
+        return;
+
+    if (max < 1)
+        max = 1;
+    else if (max > MAX_CONCURRENT_REQUESTS)
+        max = MAX_CONCURRENT_REQUESTS;
+
+    cfg->_int.fb_max_requests = max;
+}
 #endif
 
+void FB_RTDB::setAsyncCallback(FirebaseData *fbdo, RTDB_AsyncCallback callback)
+{
+    //the pending requests without callback can't be tracked
+    if (!callback && fbdo->_ss.rtdb.async_reqs.size() > 0)
+        processAsync(fbdo, true);
+
+    fbdo->_ss.rtdb.async_cb = callback;
+}
+
+bool FB_RTDB::processAsync(FirebaseData *fbdo, bool wait)
+{
+    if (fbdo->_ss.rtdb.async_reqs.size() == 0)
+        return true;
+
+    //the session is being used by other request
+    if (!ut->beginRequest(fbdo->_ss.processing, fbdo->_ss.http_code, wait))
+        return !wait;
+
+    bool ret = readAsyncResponses(fbdo, wait, 0);
+
+    ut->endRequest(fbdo->_ss.processing);
+
+    return ret;
+}
+
+bool FB_RTDB::readAsyncResponses(FirebaseData *fbdo, bool wait, size_t keep)
+{
+    FirebaseConfig *cfg = Signer.getCfg();
+    bool ret = true;
+
+    while (fbdo->_ss.rtdb.async_reqs.size() > keep)
+    {
+        WiFiClient *stream = fbdo->tcpClient.stream();
+
+        if (!fbdo->_ss.connected || !stream || (!stream->connected() && stream->available() == 0))
+        {
+            failAsync(fbdo, FIREBASE_ERROR_TCP_ERROR_CONNECTION_LOST);
+            return false;
+        }
+
+        if (!wait && stream->available() == 0)
+        {
+            if (cfg && millis() - fbdo->_ss.rtdb.async_reqs[0].sent_ms > cfg->timeout.serverResponse)
+            {
+                failAsync(fbdo, FIREBASE_ERROR_TCP_RESPONSE_PAYLOAD_READ_TIMED_OUT);
+                fbdo->closeSession();
+                return false;
+            }
+            break;
+        }
+
+        if (!handleAsyncResponse(fbdo))
+            ret = false;
+    }
+
+    return ret;
+}
+
+bool FB_RTDB::handleAsyncResponse(FirebaseData *fbdo)
+{
+    struct fb_esp_rtdb_async_req_t item = fbdo->_ss.rtdb.async_reqs[0];
+    fbdo->_ss.rtdb.async_reqs.erase(fbdo->_ss.rtdb.async_reqs.begin());
+
+    struct fb_esp_rtdb_request_info_t req;
+    req.method = item.method;
+    req.data.type = item.type;
+    req.path = item.path;
+
+    //read the response as the normal request
+    bool async = fbdo->_ss.rtdb.async;
+    fbdo->_ss.rtdb.async = false;
+    fbdo->_ss.rtdb.no_content_req = item.no_content;
+    fbdo->_ss.rtdb.req_method = item.method;
+    fbdo->_ss.http_code = FIREBASE_ERROR_HTTP_CODE_UNDEFINED;
+    fbdo->_ss.error.clear();
+
+    bool ret = handleResponse(fbdo, &req);
+
+    fbdo->_ss.rtdb.async = async;
+
+    RTDB_AsyncStatusInfo in;
+    in.httpCode = fbdo->_ss.http_code;
+    in.success = ret;
+    in.path = item.path;
+    in.pushName = fbdo->_ss.rtdb.push_name;
+    in.ETag = fbdo->_ss.rtdb.resp_etag;
+    if (!ret)
+        in.errorMsg = fbdo->errorReason().c_str();
+
+    //the responses that follow can't be read
+    if (!ret && fbdo->_ss.http_code < 0)
+    {
+        int code = fbdo->_ss.http_code;
+        fbdo->closeSession();
+        sendAsyncCallback(fbdo, in);
+        failAsync(fbdo, code);
+        return false;
+    }
+
+    sendAsyncCallback(fbdo, in);
+
+    return ret;
+}
+
+void FB_RTDB::failAsync(FirebaseData *fbdo, int code)
+{
+    std::vector<struct fb_esp_rtdb_async_req_t> reqs;
+    reqs.swap(fbdo->_ss.rtdb.async_reqs);
+
+    fbdo->_ss.http_code = code;
+
+    for (size_t i = 0; i < reqs.size(); i++)
+    {
+        RTDB_AsyncStatusInfo in;
+        in.httpCode = code;
+        in.success = false;
+        in.path = reqs[i].path;
+        in.errorMsg = fbdo->errorReason().c_str();
+        sendAsyncCallback(fbdo, in);
+    }
+}
+
+void FB_RTDB::sendAsyncCallback(FirebaseData *fbdo, RTDB_AsyncStatusInfo &in)
+{
+    if (fbdo->_ss.rtdb.async_cb)
+        fbdo->_ss.rtdb.async_cb(in);
+}
+
 void FB_RTDB::rescon(FirebaseData *fbdo, const char *host, fb_esp_rtdb_request_info_t *req)
 {
     if (req->method == m_stream)
@@ -1717,7 +3018,7 @@ void FB_RTDB::rescon(FirebaseData *fbdo, const char *host, fb_esp_rtdb_request_i
     {
         fbdo->_ss.last_conn_ms = millis();
         fbdo->closeSession();
-        fbdo->setSecure();
+        fbdo->setSecure(ut->config->rtdb.transport.type, ut->config->rtdb.transport.public_key);
         fbdo->ethDNSWorkAround(&ut->config->spi_ethernet_module, host, 443);
     }
 
@@ -1732,6 +3033,34 @@ void FB_RTDB::rescon(FirebaseData *fbdo, const char *host, fb_esp_rtdb_request_i
 }
 
 bool FB_RTDB::handleRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req)
+{
+    //the session keeps its request slot until the response was handled
+    if (!ut->beginRequest(fbdo->_ss.processing, fbdo->_ss.http_code))
+        return false;
+
+#if defined(ENABLE_FB_METRICS)
+    //the byte counts of the request that fails before sending are not left from the previous one
+    fbdo->_ss.tx_count = 0;
+    fbdo->_ss.payload_length = 0;
+#if defined(ESP8266) && !defined(FB_ENABLE_EXTERNAL_CLIENT)
+    //the handshake is timed by the ESP8266 client only
+    fbdo->tcpClient.metrics = &fbdo->_ss.metrics;
+#endif
+    fbdo->_ss.metrics.beginRequest();
+#endif
+
+    bool ret = runRequest(fbdo, req);
+
+#if defined(ENABLE_FB_METRICS)
+    fbdo->_ss.metrics.endRequest(ret, fbdo->_ss.tx_count, fbdo->_ss.payload_length);
+#endif
+
+    ut->endRequest(fbdo->_ss.processing);
+
+    return ret;
+}
+
+bool FB_RTDB::runRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req)
 {
     ut->idle();
     FirebaseConfig *cfg = Signer.getCfg();
@@ -1755,13 +3084,23 @@ bool FB_RTDB::handleRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_
         return false;
     }
 
-    if (!ut->waitIdle(fbdo->_ss.http_code))
-        return false;
+    //read the pending async responses before the connection is reused for other request
+    if (fbdo->_ss.rtdb.async_reqs.size() > 0)
+    {
+        readAsyncResponses(fbdo, false, 0);
+
+        if (!req->async || fbdo->_ss.rtdb.async_count > Signer.config->async_close_session_max_request)
+            readAsyncResponses(fbdo, true, 0);
+        else if (fbdo->_ss.rtdb.async_reqs.size() >= MAX_ASYNC_INFLIGHT_REQUESTS)
+            readAsyncResponses(fbdo, true, MAX_ASYNC_INFLIGHT_REQUESTS - 1);
+
+        fbdo->_ss.error.clear();
+    }
 
     if (!fbdo->_ss.connected)
         fbdo->_ss.rtdb.async_count = 0;
 
-    if ((fbdo->_ss.rtdb.async && !req->async) || fbdo->_ss.rtdb.async_count > Signer.config->async_close_session_max_request)
+    if ((fbdo->_ss.rtdb.async && !req->async && !fbdo->_ss.rtdb.async_cb) || fbdo->_ss.rtdb.async_count > Signer.config->async_close_session_max_request)
     {
         fbdo->_ss.rtdb.async_count = 0;
         fbdo->closeSession();
@@ -1785,12 +3124,21 @@ bool FB_RTDB::handleRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_
     fbdo->_ss.rtdb.async = req->async;
     if (req->async)
         fbdo->_ss.rtdb.async_count++;
+
+#if defined(ENABLE_FB_METRICS)
+    fbdo->_ss.metrics.beginPhase(fb_esp_metrics_phase_send);
+#endif
+
     int ret = sendRequest(fbdo, req);
 
     if (ret == 0)
     {
         fbdo->_ss.connected = true;
 
+#if defined(ENABLE_FB_METRICS)
+        fbdo->_ss.metrics.beginPhase(fb_esp_metrics_phase_wait);
+#endif
+
         if (req->method == m_stream)
         {
             if (!waitResponse(fbdo, req))
@@ -1863,10 +3211,13 @@ bool FB_RTDB::handleRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_
             fbdo->_ss.rtdb.data_available = fbdo->_ss.rtdb.raw.length() > 0;
             if (fbdo->_ss.rtdb.blob)
                 fbdo->_ss.rtdb.data_available |= fbdo->_ss.rtdb.blob->size() > 0;
+
+            fbdo->updateBufferSize(fbdo->_ss.tx_count, fbdo->_ss.payload_length, fbdo->_ss.buffer_ovf);
         }
     }
     else
     {
+        fbdo->_ss.tx_len = 0;
         fbdo->_ss.http_code = ret;
         if (ret != FIREBASE_ERROR_TCP_ERROR_CONNECTION_INUSED)
             fbdo->_ss.connected = false;
@@ -2015,6 +3366,10 @@ int FB_RTDB::sendRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *
     if (fbdo->_ss.long_running_task > 0)
         return FIREBASE_ERROR_LONG_RUNNING_TASK;
 
+    //discard the fragments left from the failed request
+    fbdo->_ss.tx_len = 0;
+    fbdo->_ss.tx_count = 0;
+
     size_t buffSize = cfg->rtdb.upload_buffer_size;
 
     if (buffSize < 128)
@@ -2062,7 +3417,10 @@ int FB_RTDB::sendRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *
 
     fbdo->_ss.max_payload_length = 0;
 
-    fbdo->tcpClient.begin(cfg->database_url.c_str(), FIREBASE_PORT);
+    //the local gateway is connected instead of the database host when it was set
+    struct fb_esp_rtdb_transport_t &transport = cfg->rtdb.transport;
+    uint16_t port = transport.port > 0 ? transport.port : (transport.type == fb_transport_type_plain ? 80 : FIREBASE_PORT);
+    fbdo->tcpClient.begin(transport.host.length() > 0 ? transport.host.c_str() : cfg->database_url.c_str(), port);
 
     if (req->task_type == fb_esp_rtdb_task_upload_rules)
     {
@@ -2198,6 +3556,8 @@ int FB_RTDB::sendRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *
                     s.appendP(fb_esp_pgm_str_3, true);
                     ret = fbdo->tcpSend(s.c_str());
                 }
+                else
+                    ret = FIREBASE_ERROR_TCP_ERROR_SEND_PAYLOAD_FAILED;
             }
         }
     }
@@ -2226,10 +3586,11 @@ int FB_RTDB::sendRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *
 
             ret = fbdo->tcpSend(s.c_str());
 
-            if (ret == 0)
-                sendBase64File(bufSize, fbdo->tcpClient.stream(), req->filename, (fb_esp_mem_storage_type)fbdo->_ss.rtdb.storage_type, fbdo, req);
-            else
+            if (ret != 0 || !sendBase64File(bufSize, fbdo->tcpClient.stream(), req->filename, (fb_esp_mem_storage_type)fbdo->_ss.rtdb.storage_type, fbdo, req))
+            {
+                ut->mbfs->close(mbfs_type req->storageType);
                 return FIREBASE_ERROR_TCP_ERROR_SEND_PAYLOAD_FAILED;
+            }
 
             buf = (char *)ut->newP(2);
             buf[0] = '"';
@@ -2242,16 +3603,20 @@ int FB_RTDB::sendRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *
         }
         else
         {
-            while (len)
+            buf = (char *)ut->newP(buffSize);
+
+            while (len > 0 && buf)
             {
                 if (!fbdo->reconnect())
+                {
+                    ut->delP(&buf);
                     return FIREBASE_ERROR_TCP_ERROR_CONNECTION_LOST;
+                }
 
                 toRead = len;
                 if (toRead > buffSize)
-                    toRead = buffSize - 1;
+                    toRead = buffSize;
 
-                buf = (char *)ut->newP(buffSize);
                 int read = ut->mbfs->read(mbfs_type req->storageType, (uint8_t *)buf, toRead);
                 readLen += read;
 
@@ -2260,26 +3625,29 @@ int FB_RTDB::sendRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *
                 if (read != (int)toRead)
                     break;
 
-                buf[toRead] = '\0';
-
-                ret = fbdo->tcpSend(buf);
-                ut->delP(&buf);
+                ret = fbdo->tcpSend(buf, toRead);
 
                 if (ret != 0)
+                {
+                    ut->delP(&buf);
                     return FIREBASE_ERROR_TCP_ERROR_SEND_PAYLOAD_FAILED;
+                }
 
                 len -= toRead;
-
-                if (len <= 0)
-                    break;
             }
 
+            ut->delP(&buf);
+
             reportUploadProgress(fbdo, req, req->fileSize);
         }
 
         ut->mbfs->close(mbfs_type req->storageType);
     }
 
+    //send the remaining gathered header and payload
+    if (ret == 0)
+        ret = fbdo->tcpFlush();
+
     if (ret != 0)
         return FIREBASE_ERROR_TCP_ERROR_SEND_PAYLOAD_FAILED;
 
@@ -2287,132 +3655,67 @@ int FB_RTDB::sendRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *
     return ret;
 }
 
-void FB_RTDB::sendBase64File(size_t bufSize, WiFiClient *client, const MB_String &filePath, fb_esp_mem_storage_type storageType, FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req)
+bool FB_RTDB::sendBase64File(size_t bufSize, WiFiClient *client, const MB_String &filePath, fb_esp_mem_storage_type storageType, FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req)
 {
-    size_t chunkSize = bufSize;
-    size_t fbuffSize = 3;
-    size_t byteAdd = 0;
-    size_t byteSent = 0;
-
-    unsigned char *buff = (unsigned char *)ut->newP(chunkSize);
-    memset(buff, 0, chunkSize);
+    size_t blockSize = ut->base64BlockSize(bufSize);
+    uint8_t *buff = (uint8_t *)ut->newP(blockSize + blockSize / 3);
+    if (!buff)
+        return false;
 
     size_t len = ut->mbfs->size(mbfs_type storageType);
-    size_t fbuffIndex = 0;
-    unsigned char *fbuff = (unsigned char *)ut->newP(3);
-    int readLen = 0;
+    size_t readLen = 0;
+    bool ret = true;
 
-    while (ut->mbfs->available(mbfs_type storageType))
+    while (readLen < len && ret)
     {
-        memset(fbuff, 0, fbuffSize);
-        if (len - fbuffIndex >= 3)
-        {
-
-            size_t rd = ut->mbfs->read(mbfs_type storageType, fbuff, 3);
-
-            readLen += rd;
-            reportUploadProgress(fbdo, req, readLen);
-
-            if (rd != 3)
-                break;
-
-            buff[byteAdd++] = fb_esp_base64_table[fbuff[0] >> 2];
-            buff[byteAdd++] = fb_esp_base64_table[((fbuff[0] & 0x03) << 4) | (fbuff[1] >> 4)];
-            buff[byteAdd++] = fb_esp_base64_table[((fbuff[1] & 0x0f) << 2) | (fbuff[2] >> 6)];
-            buff[byteAdd++] = fb_esp_base64_table[fbuff[2] & 0x3f];
-
-            if (byteAdd >= chunkSize - 4)
-            {
-                byteSent += byteAdd;
-                client->write(buff, byteAdd);
-                memset(buff, 0, chunkSize);
-                byteAdd = 0;
-            }
+        size_t n = len - readLen < blockSize ? len - readLen : blockSize;
+        size_t whole = n / 3 * 3;
+        size_t olen = 0;
 
-            fbuffIndex += 3;
-        }
-        else
+        //the file block is read behind the space of its encoded text
+        if (whole > 0)
         {
-
-            if (len - fbuffIndex == 1)
-            {
-                int r = ut->mbfs->read(mbfs_type storageType);
-                if (r > -1)
-                    fbuff[0] = (uint8_t)r;
-                readLen++;
-                reportUploadProgress(fbdo, req, readLen);
-            }
-            else if (len - fbuffIndex == 2)
-            {
-                int r = ut->mbfs->read(mbfs_type storageType);
-                if (r > -1)
-                    fbuff[0] = (uint8_t)r;
-                r = ut->mbfs->read(mbfs_type storageType);
-                if (r > -1)
-                    fbuff[1] = (uint8_t)r;
-                readLen += 2;
-                reportUploadProgress(fbdo, req, readLen);
-            }
-
-            break;
+            if (ut->mbfs->read(mbfs_type storageType, buff + whole / 3, whole) != (int)whole)
+                break;
+            olen = ut->encodeBase64Block(buff, whole);
         }
-    }
-
-    if (byteAdd > 0)
-    {
-        client->write(buff, byteAdd);
-    }
-
-    if (len - fbuffIndex > 0)
-    {
-
-        memset(buff, 0, chunkSize);
-        byteAdd = 0;
 
-        buff[byteAdd++] = fb_esp_base64_table[fbuff[0] >> 2];
-        if (len - fbuffIndex == 1)
+        if (whole < n)
         {
-            buff[byteAdd++] = fb_esp_base64_table[(fbuff[0] & 0x03) << 4];
-            buff[byteAdd++] = '=';
-        }
-        else
-        {
-            buff[byteAdd++] = fb_esp_base64_table[((fbuff[0] & 0x03) << 4) | (fbuff[1] >> 4)];
-            buff[byteAdd++] = fb_esp_base64_table[(fbuff[1] & 0x0f) << 2];
+            uint8_t tail[2];
+            if (ut->mbfs->read(mbfs_type storageType, tail, n - whole) != (int)(n - whole))
+                break;
+            olen += ut->encodeBase64Tail(tail, n - whole, buff + olen);
         }
-        buff[byteAdd++] = '=';
 
-        client->write(buff, byteAdd);
+        readLen += n;
+        reportUploadProgress(fbdo, req, readLen);
+
+        ret = client->write(buff, olen) == olen;
     }
 
     ut->delP(&buff);
-    ut->delP(&fbuff);
+
+    return ret && readLen == len;
 }
 
 bool FB_RTDB::waitResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req)
 {
-#if defined(ESP32)
-    FirebaseConfig *cfg = Signer.getCfg();
-    if (!cfg)
-    {
-        fbdo->_ss.http_code = FIREBASE_ERROR_UNINITIALIZED;
-        return false;
-    }
+    return handleResponse(fbdo, req);
+}
 
-    //if currently perform stream payload handling process, skip it.
-    if (cfg->_int.fb_processing && fbdo->_ss.con_mode == fb_esp_con_mode_rtdb_stream)
-        return true;
+bool FB_RTDB::waitStreamResponse(FirebaseData *fbdo, bool wait)
+{
+    //if currently perform stream payload handling process of this session or no free slot, skip it.
+    if (!ut->beginRequest(fbdo->_ss.processing, fbdo->_ss.http_code, wait))
+        return !wait;
+
+    fb_esp_rtdb_request_info_t req;
+    bool ret = waitResponse(fbdo, &req);
 
-    //set the blocking flag
-    cfg->_int.fb_processing = true;
-    bool ret = handleResponse(fbdo, req);
-    //reset the blocking flag
-    cfg->_int.fb_processing = false;
+    ut->endRequest(fbdo->_ss.processing);
 
     return ret;
-#elif defined(ESP8266)
-    return handleResponse(fbdo, req);
-#endif
 }
 
 void FB_RTDB::waitRxReady(FirebaseData *fbdo, unsigned long &dataTime)
@@ -2484,6 +3787,7 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
     char *tmp = nullptr;
     MB_String header;
     MB_String payload;
+    size_t payloadLen = 0;
     bool isHeader = false;
 
     struct server_response_data_t response;
@@ -2496,9 +3800,10 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
     int chunkedDataSize = 0;
     int chunkedDataLen = 0;
     int defaultChunkSize = fbdo->_ss.resp_size;
+    //the base64 file data of the chunked body that ends inside a quad
+    MB_String base64Tail;
 
 #if defined(OTA_UPDATE_ENABLED)
-    int base64PadLenTail = 0;      //pad length from tail checking
     int base64PadLenSignature = 0; //pad length from signature checking
 #endif
 
@@ -2528,6 +3833,18 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
     {
         if (fbdo->_ss.rtdb.async)
         {
+            //keep the request info, its response will be read later
+            if (fbdo->_ss.rtdb.async_cb)
+            {
+                struct fb_esp_rtdb_async_req_t item;
+                item.method = req->method;
+                item.type = req->data.type;
+                item.no_content = req->method != m_post;
+                item.path = req->path;
+                item.sent_ms = millis();
+                fbdo->_ss.rtdb.async_reqs.push_back(item);
+                return true;
+            }
 
 #if defined(ESP32)
             chunkBufSize = stream->available();
@@ -2560,6 +3877,18 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                 chunkBufSize = stream->available();
                 ut->idle();
             }
+
+            //the server closed the connection before any response byte arrived
+            if (chunkBufSize <= 0 && !fbdo->tcpClient.connected())
+            {
+                fbdo->_ss.http_code = FIREBASE_ERROR_TCP_ERROR_CONNECTION_LOST;
+                fbdo->_ss.connected = false;
+                return false;
+            }
+
+#if defined(ENABLE_FB_METRICS)
+            fbdo->_ss.metrics.beginPhase(fb_esp_metrics_phase_receive);
+#endif
         }
     }
 
@@ -2629,6 +3958,7 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                 {
                     //stream payload data
                     payload = header;
+                    payloadLen = header.length();
                     fbdo->_ss.payload_length = header.length();
                     if (fbdo->_ss.max_payload_length < fbdo->_ss.payload_length)
                         fbdo->_ss.max_payload_length = fbdo->_ss.payload_length;
@@ -2672,6 +4002,12 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                         ut->parseRespHeader(header.c_str(), response);
                         fbdo->_ss.rtdb.resp_etag = response.etag;
 
+                        //the error and push name keys are scanned while the payload is received
+                        response.scanKeys = response.noEvent && (response.httpCode >= 400 || req->method == m_post);
+
+                        if (response.contentLen > 0 && response.contentLen <= (int)fbdo->_ss.resp_size)
+                            payload.reserve(response.contentLen);
+
                         if (ut->strposP(response.contentType.c_str(), fb_esp_pgm_str_9, 0) > -1)
                         {
                             chunkBufSize = stream->available();
@@ -2802,10 +4138,11 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                             {
                                 if (response.contentLen > 0 && fbdo->_ss.payload_length + readLen < (size_t)response.contentLen)
                                 {
-                                    fbdo->checkOvf(payload.length() + readLen, response);
+                                    size_t chunkLen = strlen(pChunk);
+                                    fbdo->checkOvf(payloadLen + chunkLen, response);
 
                                     if (!fbdo->_ss.buffer_ovf)
-                                        payload += pChunk;
+                                        ut->appendRespPayload(payload, payloadLen, pChunk, chunkLen, response);
 
                                     if (pChunk)
                                         ut->delP(&pChunk);
@@ -2833,10 +4170,11 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                             if (fbdo->_ss.max_payload_length < fbdo->_ss.payload_length)
                                 fbdo->_ss.max_payload_length = fbdo->_ss.payload_length;
 
-                            fbdo->checkOvf(payload.length() + readLen, response);
+                            size_t chunkLen = strlen(pChunk);
+                            fbdo->checkOvf(payloadLen + chunkLen, response);
 
                             if (!fbdo->_ss.buffer_ovf)
-                                payload += pChunk;
+                                ut->appendRespPayload(payload, payloadLen, pChunk, chunkLen, response);
                         }
 
                         if (!fbdo->_ss.rtdb.data_tmo && !fbdo->_ss.buffer_ovf)
@@ -2845,7 +4183,12 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                             if (response.dataType == 0 && !response.isEvent && !response.noContent)
                             {
                                 bool getOfs = req->data.type == d_blob || req->method == m_download || ((req->data.type == d_file || downloadOTA || req->data.type == d_any) && req->method == m_get);
-                                ut->parseRespPayload(payload.c_str(), response, getOfs);
+
+                                //resume from the bytes that were already classified
+                                if (response.noEvent)
+                                    ut->classifyRespPayload(payload.c_str(), payloadLen, response, getOfs, response.contentLen > 0 && fbdo->_ss.payload_length >= (size_t)response.contentLen);
+                                else
+                                    ut->parseRespPayload(payload.c_str(), response, getOfs);
 
                                 fbdo->_ss.rtdb.resp_data_type = response.dataType;
                                 fbdo->_ss.content_length = response.payloadLen;
@@ -2854,7 +4197,7 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                                 if (req->method == m_download || req->method == m_restore)
                                     fbdo->_ss.error = response.fbError;
 
-                                if (req->method == m_download && response.dataType != d_json)
+                                if (req->method == m_download && response.dataType != d_any && response.dataType != d_json)
                                 {
                                     fbdo->_ss.http_code = FIREBASE_ERROR_EXPECTED_JSON_DATA;
 
@@ -2862,6 +4205,7 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
 
                                     header.clear();
                                     payload.clear();
+                                    payloadLen = 0;
                                     ut->mbfs->close(mbfs_type fbdo->_ss.rtdb.storage_type);
                                     fbdo->closeSession();
                                     return false;
@@ -2878,7 +4222,9 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                             }
 
                             //in case of the payload data type is file, decode and write stream to temp file
-                            if (req->task_type == fb_esp_rtdb_task_download_rules || response.dataType == d_file || (req->method == m_download || ((req->data.type == d_file || downloadOTA) && req->method == m_get)))
+                            //the read of the chunked body returns no data at the size lines and the last chunk,
+                            //its short first chunks are kept in the payload until the data type was known
+                            if (readLen > 0 && (response.dataType > 0 || !response.isChunkedEnc) && (req->task_type == fb_esp_rtdb_task_download_rules || response.dataType == d_file || (req->method == m_download || ((req->data.type == d_file || downloadOTA) && req->method == m_get))))
                             {
 
                                 int ofs = 0;
@@ -2886,13 +4232,14 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
 
                                 if (req && downloadByteLen == 0)
                                 {
-                                    req->fileSize = response.contentLen;
+                                    //the size of the chunked body is not known, the progress is not reported
+                                    req->fileSize = response.contentLen > 0 ? response.contentLen : 0;
                                     RTDB_DownloadStatusInfo in;
                                     in.localFileName = ut->mbfs->name(mbfs_type req->storageType);
                                     in.remotePath = req->path;
                                     in.status = fb_esp_rtdb_download_status_init;
                                     in.size = req->fileSize;
-                                    if (req->data.type == d_file || req->data.type == d_file_ota)
+                                    if ((req->data.type == d_file || req->data.type == d_file_ota) && req->fileSize > 0)
                                     {
                                         //decoded data size (with padding)
                                         in.size = (req->fileSize - strlen_P(fb_esp_pgm_str_93)) * 3 / 4;
@@ -2923,6 +4270,7 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                                         {
                                             int write = ut->mbfs->write(mbfs_type req->storageType, (uint8_t *)payload.c_str(), readLen);
                                             payload.clear();
+                                            payloadLen = 0;
 
                                             if (write != readLen)
                                             {
@@ -2944,7 +4292,7 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                                         else
                                         {
 
-                                            if (pChunkIdx == 1)
+                                            if (downloadByteLen == 0)
                                             {
                                                 len = payload.size() - response.payloadOfs; //payloadOfs must be 13 for signature len
                                                 ofs = response.payloadOfs;
@@ -2954,7 +4302,8 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
 
 #if defined(OTA_UPDATE_ENABLED)
                                                     //size may include pad which we don't know from the first chunk until the last chunk
-                                                    int decodedSize = (3 * (response.contentLen - response.payloadOfs - 1) / 4);
+                                                    int paddedSize = (3 * (response.contentLen - response.payloadOfs - 1) / 4);
+                                                    int decodedSize = paddedSize;
 
                                                     if (base64PadLenSignature > 0)
                                                     {
@@ -2963,16 +4312,19 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                                                     }
 #if defined(ESP32)
                                                     error.code = 0;
-                                                    Update.begin(decodedSize);
+                                                    if (!Update.begin(decodedSize))
+                                                        error.code = FIREBASE_ERROR_FW_UPDATE_BEGIN_FAILED;
 #elif defined(ESP8266)
                                                     error.code = ut->beginUpdate(stream, decodedSize, false);
 
 #endif
+                                                    if (error.code == 0)
+                                                        ut->beginOTA(fbdo->_ss.rtdb.ota, paddedSize, error.code);
 #endif
                                                 }
                                             }
 #if defined(OTA_UPDATE_ENABLED)
-                                            base64PadLenTail = ut->trimLastChunkBase64(payload, len);
+                                            ut->trimLastChunkBase64(payload, len);
 
 #endif
                                             downloadByteLen += len + ofs;
@@ -2980,7 +4332,11 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
 
                                             if (req->data.type == d_file)
                                             {
-                                                ut->decodeBase64Stream(payload.c_str() + ofs, len, (fb_esp_mem_storage_type)fbdo->_ss.rtdb.storage_type);
+                                                //the chunks of the body do not end at the base64 quads
+                                                if (response.isChunkedEnc)
+                                                    ut->decodeBase64Stream(base64Tail, payload.c_str() + ofs, len, (fb_esp_mem_storage_type)fbdo->_ss.rtdb.storage_type);
+                                                else
+                                                    ut->decodeBase64Stream(payload.c_str() + ofs, len, (fb_esp_mem_storage_type)fbdo->_ss.rtdb.storage_type);
                                             }
                                             else if (downloadOTA)
                                             {
@@ -2988,7 +4344,7 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
 
 #if defined(OTA_UPDATE_ENABLED)
                                                 if (error.code == 0)
-                                                    ut->decodeBase64OTA(payload.c_str() + ofs, len, error.code);
+                                                    ut->decodeBase64OTA(fbdo->_ss.rtdb.ota, payload.c_str() + ofs, len, error.code);
 #endif
                                             }
                                         }
@@ -3024,6 +4380,7 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                                 if (response.dataType > 0)
                                 {
                                     payload.clear();
+                                    payloadLen = 0;
                                     readLen = 0;
                                 }
                             }
@@ -3047,9 +4404,9 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                     {
                         if (!stream)
                             break;
-                        //read all the rest data
-                        while (stream->available() > 0)
-                            stream->read();
+                        //read all the rest data, the overflown payload is counted to the content length
+                        while (stream->available() > 0 && stream->read() > -1)
+                            fbdo->_ss.payload_length++;
                     }
                 }
             }
@@ -3060,6 +4417,9 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
 
     header.clear();
 
+    if (base64Tail.length() > 0)
+        ut->decodeBase64Stream(base64Tail.c_str(), base64Tail.length(), (fb_esp_mem_storage_type)fbdo->_ss.rtdb.storage_type);
+
     if (downloadByteLen > 0)
         reportDownloadProgress(fbdo, req, response.contentLen);
 
@@ -3069,22 +4429,22 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
 
 #if defined(OTA_UPDATE_ENABLED)
 
-        //write extra pad
-        if (base64PadLenTail > 0 && base64PadLenSignature == 0)
-        {
-            uint8_t pad[base64PadLenTail];
-            memset(pad, 0, base64PadLenTail);
-            Update.write(pad, base64PadLenTail);
-        }
-
         if (error.code == 0)
         {
-            if (!Update.end())
-                error.code = FIREBASE_ERROR_FW_UPDATE_END_FAILED;
+            //the update size may still count the pad bytes which were only known from the tail
+            if (!ut->endOTA(fbdo->_ss.rtdb.ota, error.code) || !Update.end(true))
+            {
+                if (error.code == 0)
+                    error.code = FIREBASE_ERROR_FW_UPDATE_END_FAILED;
+            }
         }
 
         if (error.code != 0)
+        {
+            ut->clearOTA(fbdo->_ss.rtdb.ota);
+            ut->abortUpdate();
             fbdo->_ss.http_code = error.code;
+        }
 
         return fbdo->_ss.http_code == FIREBASE_ERROR_HTTP_CODE_OK;
 
@@ -3165,14 +4525,17 @@ bool FB_RTDB::handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req
                 //the payload ever parsed?
                 if (response.dataType == 0 && !response.noContent)
                 {
-                    if (req->data.type == d_blob || req->method == m_download || ((req->data.type == d_file || downloadOTA) && req->method == m_get))
-                        ut->parseRespPayload(payload.c_str(), response, true);
-                    else
-                        ut->parseRespPayload(payload.c_str(), response, false);
+                    bool getOfs = req->data.type == d_blob || req->method == m_download || ((req->data.type == d_file || downloadOTA) && req->method == m_get);
 
-                    fbdo->_ss.error = response.fbError;
+                    if (response.noEvent)
+                        ut->classifyRespPayload(payload.c_str(), payloadLen, response, getOfs, true);
+                    else
+                        ut->parseRespPayload(payload.c_str(), response, getOfs);
                 }
 
+                //the keys scanned from the whole payload
+                fbdo->_ss.error = response.fbError;
+
                 fbdo->_ss.rtdb.resp_data_type = response.dataType;
                 fbdo->_ss.content_length = response.payloadLen;
 
@@ -3327,7 +4690,7 @@ void FB_RTDB::sendCB(FirebaseData *fbdo)
 
     // to allow other subsequence request which can be occurred in the user stream
     // callback
-    cfg->_int.fb_processing = false;
+    ut->endRequest(fbdo->_ss.processing);
 
     if (fbdo->_dataAvailableCallback)
     {
@@ -3486,6 +4849,16 @@ void FB_RTDB::parseStreamPayload(FirebaseData *fbdo, const char *payload)
 
         handlePayload(fbdo, response, payload);
 
+        //the cached values under the changed path are out of date
+        if (_readCacheSize > 0)
+        {
+            MB_String key = fbdo->_ss.rtdb.stream_path;
+            key.appendP(fb_esp_pgm_str_1);
+            key += response.eventPath;
+            trimPathSlashes(key);
+            invalidateReadCache(key);
+        }
+
         //Any stream update?
         //based on BLOB or file event data changes (no old data available for comparision or inconvenient for large data)
         //event path changes
@@ -3616,51 +4989,60 @@ int FB_RTDB::sendHeader(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *r
             hasServerValue = ut->strpos(req->payload.c_str(), pgm2Str(fb_esp_pgm_str_166), 0) != -1;
     }
 
-    MB_String header;
-    int ret = -1;
+    //the header fragments are gathered into the session's TX buffer and sent
+    //together with the payload, no header string is built.
+    int ret = 0;
     if (req->method == m_stream)
-        header.appendP(fb_esp_pgm_str_22, true);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_22);
     else
     {
         if (req->method == m_put || req->method == m_put_nocontent || req->method == m_set_priority || req->method == m_set_rules)
         {
             http_method = m_put;
             if (fbdo->_ss.classic_request)
-                header.appendP(fb_esp_pgm_str_24, true);
+                ret = fbdo->tcpWriteP(fb_esp_pgm_str_24);
             else
-                header.appendP(fb_esp_pgm_str_23, true);
+                ret = fbdo->tcpWriteP(fb_esp_pgm_str_23);
         }
         else if (req->method == m_post)
         {
             http_method = m_post;
-            header.appendP(fb_esp_pgm_str_24, true);
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_24);
         }
         else if (req->method == m_get || req->method == m_get_nocontent || req->method == m_get_shallow || req->method == m_get_priority || req->method == m_download || req->method == m_read_rules)
         {
             http_method = m_get;
-            header.appendP(fb_esp_pgm_str_25, true);
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_25);
         }
         else if (req->method == m_patch || req->method == m_patch_nocontent || req->method == m_restore)
         {
             http_method = m_patch;
-            header.appendP(fb_esp_pgm_str_26, true);
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_26);
         }
         else if (req->method == m_delete)
         {
             http_method = m_delete;
             if (fbdo->_ss.classic_request)
-                header.appendP(fb_esp_pgm_str_24, true);
+                ret = fbdo->tcpWriteP(fb_esp_pgm_str_24);
             else
-                header.appendP(fb_esp_pgm_str_27, true);
+                ret = fbdo->tcpWriteP(fb_esp_pgm_str_27);
         }
-        header.appendP(fb_esp_pgm_str_6);
+
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_6);
     }
 
+    if (ret != 0)
+        return ret;
+
     ut->makePath(req->path);
-    header += req->path;
+    ret = fbdo->tcpWrite(req->path.c_str(), req->path.length());
 
-    if (req->method == m_patch || req->method == m_patch_nocontent)
-        header.appendP(fb_esp_pgm_str_1);
+    if (ret == 0 && (req->method == m_patch || req->method == m_patch_nocontent))
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_1);
+
+    if (ret != 0)
+        return ret;
 
     bool appendAuth = false;
 
@@ -3677,199 +5059,249 @@ int FB_RTDB::sendHeader(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *r
     if (appendAuth)
     {
         if (Signer.getTokenType() == token_type_oauth2_access_token || cfg->signer.test_mode)
-            header.appendP(fb_esp_pgm_str_238);
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_238);
         else
-            header.appendP(fb_esp_pgm_str_2);
-
-        ret = fbdo->tcpSend(header.c_str());
-        header.clear();
-
-        if (ret < 0)
-            return ret;
+        {
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_2);
 
-        if (Signer.getTokenType() != token_type_oauth2_access_token && !cfg->signer.test_mode)
-            ret = fbdo->tcpSend(cfg->_int.auth_token.c_str());
+            //the token may be replaced by the background refresh task
+            if (ret == 0)
+            {
+                Signer.lockAuthToken();
+                ret = fbdo->tcpWrite(cfg->_int.auth_token.c_str(), cfg->_int.auth_token.length());
+                Signer.unlockAuthToken();
+            }
+        }
 
         if (ret < 0)
             return ret;
     }
 
+    MB_String num;
+
     if (fbdo->_ss.rtdb.read_tmo > 0)
     {
-        header.appendP(fb_esp_pgm_str_158);
-        header += fbdo->_ss.rtdb.read_tmo;
-        header.appendP(fb_esp_pgm_str_159);
+        num += fbdo->_ss.rtdb.read_tmo;
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_158);
+        if (ret == 0)
+            ret = fbdo->tcpWrite(num.c_str(), num.length());
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_159);
+        num.clear();
     }
 
-    if (fbdo->_ss.rtdb.write_limit.length() > 0)
+    if (ret == 0 && fbdo->_ss.rtdb.write_limit.length() > 0)
     {
-        header.appendP(fb_esp_pgm_str_160);
-        header += fbdo->_ss.rtdb.write_limit;
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_160);
+        if (ret == 0)
+            ret = fbdo->tcpWrite(fbdo->_ss.rtdb.write_limit.c_str(), fbdo->_ss.rtdb.write_limit.length());
     }
 
-    if (req->method == m_get_shallow)
+    if (ret == 0 && req->method == m_get_shallow)
     {
-        header.appendP(fb_esp_pgm_str_155);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_155);
         fbdo->_ss.rtdb.shallow_flag = true;
     }
 
+    if (ret != 0)
+        return ret;
+
     QueryFilter *query = req->data.address.query > 0 ? addrTo<QueryFilter *>(req->data.address.query) : nullptr;
 
     bool hasQuery = false;
 
-    if (req->method == m_get && query)
+    if ((req->method == m_get || req->method == m_download) && query)
     {
         if (query->_orderBy.length() > 0)
         {
             hasQuery = true;
-            header.appendP(fb_esp_pgm_str_96);
-            header += query->_orderBy;
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_96);
+            if (ret == 0)
+                ret = fbdo->tcpWrite(query->_orderBy.c_str(), query->_orderBy.length());
 
-            if (req->method == m_get)
+            //the range filters of the reads, the chunked backup download pages the keys with them
+            if (req->method == m_get || req->method == m_download)
             {
-                if (query->_limitToFirst.length() > 0)
+                if (ret == 0 && query->_limitToFirst.length() > 0)
                 {
-                    header.appendP(fb_esp_pgm_str_97);
-                    header += query->_limitToFirst;
+                    ret = fbdo->tcpWriteP(fb_esp_pgm_str_97);
+                    if (ret == 0)
+                        ret = fbdo->tcpWrite(query->_limitToFirst.c_str(), query->_limitToFirst.length());
                 }
 
-                if (query->_limitToLast.length() > 0)
+                if (ret == 0 && query->_limitToLast.length() > 0)
                 {
-                    header.appendP(fb_esp_pgm_str_98);
-                    header += query->_limitToLast;
+                    ret = fbdo->tcpWriteP(fb_esp_pgm_str_98);
+                    if (ret == 0)
+                        ret = fbdo->tcpWrite(query->_limitToLast.c_str(), query->_limitToLast.length());
                 }
 
-                if (query->_startAt.length() > 0)
+                if (ret == 0 && query->_startAt.length() > 0)
                 {
-                    header.appendP(fb_esp_pgm_str_99);
-                    header += query->_startAt;
+                    ret = fbdo->tcpWriteP(fb_esp_pgm_str_99);
+                    if (ret == 0)
+                        ret = fbdo->tcpWrite(query->_startAt.c_str(), query->_startAt.length());
                 }
 
-                if (query->_endAt.length() > 0)
+                if (ret == 0 && query->_endAt.length() > 0)
                 {
-                    header.appendP(fb_esp_pgm_str_100);
-                    header += query->_endAt;
+                    ret = fbdo->tcpWriteP(fb_esp_pgm_str_100);
+                    if (ret == 0)
+                        ret = fbdo->tcpWrite(query->_endAt.c_str(), query->_endAt.length());
                 }
 
-                if (query->_equalTo.length() > 0)
+                if (ret == 0 && query->_equalTo.length() > 0)
                 {
-                    header.appendP(fb_esp_pgm_str_101);
-                    header += query->_equalTo;
+                    ret = fbdo->tcpWriteP(fb_esp_pgm_str_101);
+                    if (ret == 0)
+                        ret = fbdo->tcpWrite(query->_equalTo.c_str(), query->_equalTo.length());
                 }
             }
+
+            if (ret != 0)
+                return ret;
         }
     }
 
     if (req->method == m_download)
     {
-        header.appendP(fb_esp_pgm_str_162);
-        header.appendP(fb_esp_pgm_str_28);
-        MB_String filename;
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_162);
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_28);
 
-        for (size_t i = 0; i < fbdo->_ss.rtdb.path.length(); i++)
+        for (size_t i = 0; ret == 0 && i < fbdo->_ss.rtdb.path.length(); i++)
         {
             if (fbdo->_ss.rtdb.path.c_str()[i] == '/')
-                filename.appendP(fb_esp_pgm_str_4);
+                ret = fbdo->tcpWriteP(fb_esp_pgm_str_4);
             else
-                filename += fbdo->_ss.rtdb.path.c_str()[i];
+                ret = fbdo->tcpWrite(fbdo->_ss.rtdb.path.c_str() + i, 1);
         }
 
-        header += filename;
-        filename.clear();
+        if (ret != 0)
+            return ret;
     }
 
     if (req->method == m_get && req->filename.length() > 0)
     {
-        header.appendP(fb_esp_pgm_str_28);
-        header += fbdo->_ss.rtdb.filename;
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_28);
+        if (ret == 0)
+            ret = fbdo->tcpWrite(fbdo->_ss.rtdb.filename.c_str(), fbdo->_ss.rtdb.filename.length());
+        if (ret != 0)
+            return ret;
     }
 
-    if (req->async || req->method == m_get_nocontent || req->method == m_restore || req->method == m_put_nocontent || req->method == m_patch_nocontent)
-        header.appendP(fb_esp_pgm_str_29);
+    //the push name of async request is required by the async callback
+    if ((req->async && (req->method != m_post || !fbdo->_ss.rtdb.async_cb)) || req->method == m_get_nocontent || req->method == m_restore || req->method == m_put_nocontent || req->method == m_patch_nocontent)
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_29);
 
-    header.appendP(fb_esp_pgm_str_30);
-    header.appendP(fb_esp_pgm_str_31);
-    header += cfg->database_url;
-    header.appendP(fb_esp_pgm_str_21);
-    header.appendP(fb_esp_pgm_str_32);
+    if (ret == 0)
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_30);
+    if (ret == 0)
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_31);
+    if (ret == 0)
+        ret = fbdo->tcpWrite(cfg->database_url.c_str(), cfg->database_url.length());
+    if (ret == 0)
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_21);
+    if (ret == 0)
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_32);
 
-    if (Signer.getTokenType() == token_type_oauth2_access_token)
+    if (ret == 0 && Signer.getTokenType() == token_type_oauth2_access_token)
     {
-        header.appendP(fb_esp_pgm_str_237);
-        header += cfg->signer.tokens.auth_type;
-        header.appendP(fb_esp_pgm_str_6);
-
-        ret = fbdo->tcpSend(header.c_str());
-        header.clear();
-
-        if (ret < 0)
-            return ret;
-
-        ret = fbdo->tcpSend(cfg->_int.auth_token.c_str());
-
-        if (ret < 0)
-            return ret;
-
-        header.appendP(fb_esp_pgm_str_21);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_237);
+        if (ret == 0)
+            ret = fbdo->tcpWrite(cfg->signer.tokens.auth_type.c_str(), cfg->signer.tokens.auth_type.length());
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_6);
+        if (ret == 0)
+        {
+            Signer.lockAuthToken();
+            ret = fbdo->tcpWrite(cfg->_int.auth_token.c_str(), cfg->_int.auth_token.length());
+            Signer.unlockAuthToken();
+        }
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_21);
     }
 
+    if (ret != 0)
+        return ret;
+
     //Timestamp cannot use with ETag header, otherwise cases internal server error
     if (!hasServerValue && !hasQuery && req->data.type != d_timestamp && (req->method == m_delete || req->method == m_get || req->method == m_get_nocontent || req->method == m_put || req->method == m_put_nocontent || req->method == m_post))
-        header.appendP(fb_esp_pgm_str_148);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_148);
 
-    if (fbdo->_ss.rtdb.req_etag.length() > 0 && (req->method == m_put || req->method == m_put_nocontent || req->method == m_delete))
+    if (ret == 0 && fbdo->_ss.rtdb.req_etag.length() > 0 && req->method == m_get)
     {
-        header.appendP(fb_esp_pgm_str_149);
-        header += fbdo->_ss.rtdb.req_etag;
-        header.appendP(fb_esp_pgm_str_21);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_606);
+        if (ret == 0)
+            ret = fbdo->tcpWrite(fbdo->_ss.rtdb.req_etag.c_str(), fbdo->_ss.rtdb.req_etag.length());
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_21);
     }
 
-    if (fbdo->_ss.classic_request && http_method != m_get && http_method != m_post && http_method != m_patch)
+    if (ret == 0 && fbdo->_ss.rtdb.req_etag.length() > 0 && (req->method == m_put || req->method == m_put_nocontent || req->method == m_delete))
     {
-        header.appendP(fb_esp_pgm_str_153);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_149);
+        if (ret == 0)
+            ret = fbdo->tcpWrite(fbdo->_ss.rtdb.req_etag.c_str(), fbdo->_ss.rtdb.req_etag.length());
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_21);
+    }
+
+    if (ret == 0 && fbdo->_ss.classic_request && http_method != m_get && http_method != m_post && http_method != m_patch)
+    {
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_153);
 
-        if (http_method == m_put)
-            header.appendP(fb_esp_pgm_str_23);
-        else if (http_method == m_delete)
-            header.appendP(fb_esp_pgm_str_27);
+        if (ret == 0 && http_method == m_put)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_23);
+        else if (ret == 0 && http_method == m_delete)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_27);
 
-        header.appendP(fb_esp_pgm_str_21);
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_21);
     }
 
+    if (ret != 0)
+        return ret;
+
     if (req->method == m_stream)
     {
         fbdo->_ss.rtdb.http_req_conn_type = fb_esp_http_connection_type_keep_alive;
-        header.appendP(fb_esp_pgm_str_34);
-        header.appendP(fb_esp_pgm_str_35);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_34);
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_35);
     }
     else if (req->method == m_download || req->method == m_restore)
     {
         fbdo->_ss.rtdb.http_req_conn_type = fb_esp_http_connection_type_close;
-        header.appendP(fb_esp_pgm_str_34);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_34);
     }
     else
     {
         fbdo->_ss.rtdb.http_req_conn_type = fb_esp_http_connection_type_keep_alive;
-        header.appendP(fb_esp_pgm_str_36);
-        header.appendP(fb_esp_pgm_str_37);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_36);
+        if (ret == 0)
+            ret = fbdo->tcpWriteP(fb_esp_pgm_str_37);
     }
 
-    if (req->method != m_download && req->method != m_restore)
-        header.appendP(fb_esp_pgm_str_38);
+    if (ret == 0 && req->method != m_download && req->method != m_restore)
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_38);
 
     if (req->method == m_get_priority || req->method == m_set_priority)
         fbdo->_ss.rtdb.priority_val_flag = true;
 
-    if (req->method == m_put || req->method == m_put_nocontent || req->method == m_post || req->method == m_patch || req->method == m_patch_nocontent || req->method == m_restore || req->method == m_set_rules || req->method == m_set_priority)
+    if (ret == 0 && (req->method == m_put || req->method == m_put_nocontent || req->method == m_post || req->method == m_patch || req->method == m_patch_nocontent || req->method == m_restore || req->method == m_set_rules || req->method == m_set_priority))
     {
-        header.appendP(fb_esp_pgm_str_12);
-        header += getPayloadLen(req);
+        num += getPayloadLen(req);
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_12);
+        if (ret == 0)
+            ret = fbdo->tcpWrite(num.c_str(), num.length());
     }
-    header.appendP(fb_esp_pgm_str_21);
-    header.appendP(fb_esp_pgm_str_21);
 
-    ret = fbdo->tcpSend(header.c_str());
-    header.clear();
+    if (ret == 0)
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_21);
+    if (ret == 0)
+        ret = fbdo->tcpWriteP(fb_esp_pgm_str_21);
+
     return ret;
 }
 
@@ -3967,7 +5399,10 @@ bool FB_RTDB::handleStreamRequest(FirebaseData *fbdo, const MB_String &path)
     ret = sendRequest(fbdo, &_req) == 0;
 
     if (!ret)
+    {
+        fbdo->_ss.tx_len = 0;
         fbdo->_ss.http_code = FIREBASE_ERROR_TCP_ERROR_NOT_CONNECTED;
+    }
 
     return ret;
 }
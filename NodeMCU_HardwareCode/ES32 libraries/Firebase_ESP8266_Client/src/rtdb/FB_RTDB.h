@@ -73,8 +73,104 @@ public:
    * @note The multiple HTTP requessts at a time is disable by default to prevent the large memory used in multiple requests.
   */
   void allowMultipleRequests(bool enable);
+
+  /** Set the maximum number of requests at a time when multiple requests are allowed (for ESP32 only).
+   * 
+   * @param max - The number of requests (1 - 16), default is 4.
+   * 
+   * @note Each Firebase Data object holds its own connection and runs one request at a time,
+   * the requests of other Firebase Data objects wait for a free slot.
+  */
+  void setMaxConcurrentRequests(uint8_t max);
 #endif
 
+  /** Set the callback function to get the results of async requests e.g. setIntAsync and pushJSONAsync.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param callback The callback function that accept RTDB_AsyncStatusInfo data.
+   * 
+   * @note When callback was set, the async requests are kept in the in-flight list (up to 8 requests)
+   * and their responses are read later by processAsync or before the next request of this Firebase Data object.
+   * The callback function should not use the same Firebase Data object for other request.
+   * 
+   * Set the callback to NULL to send the async requests without waiting for their responses.
+  */
+  void setAsyncCallback(FirebaseData *fbdo, RTDB_AsyncCallback callback);
+
+  /** Read the arrived responses of async requests and send the results to the async callback.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param wait Optional. Wait for the responses of all pending async requests.
+   * @return Boolean value, indicates the success of the operation.
+   * 
+   * @note This function should be called inside the loop when async callback was set.
+  */
+  bool processAsync(FirebaseData *fbdo, bool wait = false);
+
+  /** Enable the write coalescing of the set functions for int, float, double, bool and string.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param interval The flush interval in ms, 0 to disable and send the cached writes.
+   * 
+   * @note The values are cached by path (the last value wins) and sent as one multi-path update
+   * (silent PATCH) when the interval was elapsed since the first cached write or 32 paths were cached.
+   * 
+   * The get functions of the cached paths return the cached values, other requests send the cached writes first.
+   * 
+   * Call flushWrites inside the loop to send the cached writes when no set function was called.
+  */
+  void setWriteCoalescing(FirebaseData *fbdo, uint32_t interval);
+
+  /** Send the cached writes as one multi-path update.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param force Optional. Send now or only when the flush interval was elapsed.
+   * @return Boolean value, indicates the success of the operation.
+  */
+  bool flushWrites(FirebaseData *fbdo, bool force = true);
+
+  /** Enable the read cache of get functions.
+   * 
+   * @param size The number of cached paths (up to 32), 0 to disable.
+   * 
+   * @note The value, data type and ETag of the get request without query are cached by path (least recently used are evicted).
+   * The next get request of the cached path sends the ETag with if-none-match header, the cached value is used
+   * when the server responds with 304 (not modified).
+   * 
+   * The cached values are removed by the set, push, update and delete requests and by the stream events at the overlapping paths.
+  */
+  void setReadCache(size_t size);
+
+  /** Enable the push keys that were generated by the device.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param enable The boolean value to enable or disable.
+   * 
+   * @note The push functions send the data with PUT (silent) to the new key that was generated by newPushID 
+   * instead of POST, the retry of the same push (e.g. from the error queue) writes to the same key without duplicate.
+   * 
+   * The key is available from fbdo->pushName() after the push function was called, also when the push was failed, 
+   * the same data can be written (set) to this key to retry without duplicate.
+   * The device time should be set (e.g. Firebase.setSystemTime) otherwise the server generated key will be used.
+  */
+  void setLocalPushID(FirebaseData *fbdo, bool enable);
+
+  /** Generate the new push key (the same format as the keys that were generated by the server).
+   * 
+   * @return The 20 characters key or empty string when the device time was not set.
+   * 
+   * @note The keys are ordered by time and the keys that were generated within the same millisecond are still in order.
+  */
+  String newPushID();
+
+  /** Generate the new push key or report the error when the key can't be generated.
+   * 
+   * @param fbdo The pointer to Firebase Data Object to keep the error.
+   * @param key The String to keep the 20 characters key.
+   * @return Boolean value, indicates the key was generated, false when the device time was not set.
+  */
+  bool newPushID(FirebaseData *fbdo, String &key);
+
   /** Set the timeout of Firebase.get functions.
    * 
    * @param fbdo The pointer to Firebase Data Object.
@@ -1560,6 +1656,89 @@ public:
   template <typename T1 = const char *, typename T2 = const char *>
   bool restore(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, T1 nodePath, T2 fileName, RTDB_UploadProgressCallback callback = NULL) { return mRestore(fbdo, storageType, toStringPtr(nodePath), toStringPtr(fileName), callback); }
 
+  /** Backup (download) the database at the defined node to the chunk files split by the child key ranges.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param storageType The enum of memory storage type e.g. mem_storage_type_flash and mem_storage_type_sd. The file systems can be changed in FirebaseFS.h.
+   * @param nodePath The path to the node to be backuped.
+   * @param fileName The base file name (without extension) of the chunk files and manifest.
+   * @param keysPerChunk Optional. The number of child nodes to save in each chunk.
+   * @param callback Optional. The callback function that accept RTDB_DownloadStatusInfo data.
+   * @return Boolean value, indicates the success of the operation.
+   * 
+   * @note The chunks are saved as fileName.000, fileName.001, ... with the records that keep the key range, 
+   * size and CRC32 of each chunk as fileName.000.mft, fileName.001.mft, ... The manifest that keeps the node 
+   * path and chunk count is saved as fileName.mft.
+   * 
+   * The chunks are read page by page in the key order, the keys of the node are not listed before the backup.
+   * 
+   * When the previous backup of the same node was interrupted, call this function again to resume from the chunk 
+   * that was not completed. The new backup will be started when the previous backup was completed.
+  */
+  template <typename T1 = const char *, typename T2 = const char *>
+  bool backupChunks(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, T1 nodePath, T2 fileName, size_t keysPerChunk = 100, RTDB_DownloadProgressCallback callback = NULL) { return mBackupChunks(fbdo, storageType, toStringPtr(nodePath), toStringPtr(fileName), keysPerChunk, callback); }
+
+  /** Restore the database at a defined path using the chunk files saved by backupChunks.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param storageType The enum of memory storage type e.g. mem_storage_type_flash and mem_storage_type_sd. The file systems can be changed in FirebaseFS.h.
+   * @param nodePath The path to the node to be restored the data.
+   * @param fileName The base file name (without extension) of the chunk files and manifest.
+   * @param callback Optional. The callback function that accept RTDB_UploadStatusInfo data.
+   * @return Boolean value, indicates the success of the operation.
+   * 
+   * @note Each chunk is checked with the CRC32 in its record before it was restored (PATCH) to the node.
+   * When the previous restore was interrupted, call this function again to resume from the chunk that was not restored.
+  */
+  template <typename T1 = const char *, typename T2 = const char *>
+  bool restoreChunks(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, T1 nodePath, T2 fileName, RTDB_UploadProgressCallback callback = NULL) { return mRestoreChunks(fbdo, storageType, toStringPtr(nodePath), toStringPtr(fileName), callback); }
+
+  /** Begin the cursor to read the child keys of the node page by page.
+   * 
+   * @param cursor The pointer to RTDB_KeyCursor data to keep the read position.
+   * @param path The path to the parent node.
+   * @param pageSize Optional. The number of keys to read in each page.
+   * 
+   * @note The page will be made smaller when the child values of the page do not fit in the response payload buffer.
+  */
+  template <typename T = const char *>
+  void beginKeyCursor(RTDB_KeyCursor *cursor, T path, size_t pageSize = 50) { mBeginKeyCursor(cursor, toStringPtr(path), pageSize); }
+
+  /** Read the next page of the child keys from the cursor.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param cursor The pointer to RTDB_KeyCursor data that was set with beginKeyCursor.
+   * @param callback The callback function that accept the key and its index, return false to stop reading.
+   * @return Boolean value, indicates the success of the operation.
+   * 
+   * @note The keys are read in the database key order, cursor->done is true when all keys were read.
+   * Only one page of the children is held in memory at a time.
+  */
+  bool readKeys(FirebaseData *fbdo, RTDB_KeyCursor *cursor, RTDB_KeyCallback callback);
+
+  /** Read the next page of the child keys from the cursor into the array.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param cursor The pointer to RTDB_KeyCursor data that was set with beginKeyCursor.
+   * @param keys The String array to keep the keys.
+   * @param size The size of array, the page size is limited to this size.
+   * @return The number of keys that were read.
+  */
+  size_t readKeys(FirebaseData *fbdo, RTDB_KeyCursor *cursor, String *keys, size_t size);
+
+  /** Read all child keys of the node page by page.
+   * 
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param path The path to the parent node.
+   * @param callback The callback function that accept the key and its index, return false to stop reading.
+   * @param pageSize Optional. The number of keys to read in each request.
+   * @return Boolean value, indicates the success of the operation.
+   * 
+   * @note Use this instead of getShallowData for the node with many children.
+  */
+  template <typename T = const char *>
+  bool getKeys(FirebaseData *fbdo, T path, RTDB_KeyCallback callback, size_t pageSize = 50) { return mGetKeys(fbdo, toStringPtr(path), callback, pageSize); }
+
   /** Set maximum Firebase read/store retry operation (0 - 255) 
    * in case of network problems and buffer overflow.
    * 
@@ -1769,12 +1948,21 @@ public:
 
 private:
   UtilsClass *ut = nullptr;
+  std::vector<struct fb_esp_rtdb_read_cache_t> _readCache;
+  uint64_t _pushMillis = 0;
+  uint8_t _pushRand[12];
+  size_t _readCacheSize = 0;
+#if defined(ESP32)
+  SemaphoreHandle_t _readCacheMutex = NULL;
+#endif
   void begin(UtilsClass *u);
   void rescon(FirebaseData *fbdo, const char *host, fb_esp_rtdb_request_info_t *req);
   void clearDataStatus(FirebaseData *fbdo);
 
   //request without queue and data out pointer
   bool handleRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
+  //send request and handle response while holding the request slot
+  bool runRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
 
   //send managed request data
   int sendRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
@@ -1783,6 +1971,8 @@ private:
   int sendHeader(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
   size_t getPayloadLen(fb_esp_rtdb_request_info_t *req);
   bool waitResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req);
+  //handle stream response with the request slot of session
+  bool waitStreamResponse(FirebaseData *fbdo, bool wait);
   //handle managed response data
   bool handleResponse(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req);
   int openFile(FirebaseData *fbdo, fb_esp_rtdb_request_info_t *req, mb_file_open_mode mode, bool closeSession = false);
@@ -1791,7 +1981,7 @@ private:
   void handlePayload(FirebaseData *fbdo, struct server_response_data_t &response, const char *payload);
   //request with queue and data out pointer
   bool processRequest(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
-  void sendBase64File(size_t bufSize, WiFiClient *client, const MB_String &filePath, fb_esp_mem_storage_type storageType, FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
+  bool sendBase64File(size_t bufSize, WiFiClient *client, const MB_String &filePath, fb_esp_mem_storage_type storageType, FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
   void setRefValue(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
   void addQueueData(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req);
   bool buildRequest(FirebaseData *fbdo, fb_esp_method method, MB_StringPtr path, MB_StringPtr payload, fb_esp_data_type type, int subtype, uint32_t value_addr, uint32_t query_addr, uint32_t priority_addr, MB_StringPtr etag, bool async, bool queue, size_t blob_size, MB_StringPtr filename, fb_esp_mem_storage_type storage_type = mem_storage_type_undefined, RTDB_DownloadProgressCallback downloadCallback = NULL, RTDB_UploadProgressCallback uploadCallback = NULL);
@@ -1804,6 +1994,25 @@ private:
   bool mBeginMultiPathStream(FirebaseData *fbdo, MB_StringPtr parentPath);
   bool mBackup(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, MB_StringPtr nodePath, MB_StringPtr fileName, RTDB_DownloadProgressCallback callback = NULL);
   bool mRestore(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, MB_StringPtr nodePath, MB_StringPtr fileName, RTDB_UploadProgressCallback callback = NULL);
+  bool mBackupChunks(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, MB_StringPtr nodePath, MB_StringPtr fileName, size_t keysPerChunk, RTDB_DownloadProgressCallback callback = NULL);
+  bool mRestoreChunks(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, MB_StringPtr nodePath, MB_StringPtr fileName, RTDB_UploadProgressCallback callback = NULL);
+  bool downloadChunk(FirebaseData *fbdo, fb_esp_mem_storage_type storageType, const MB_String &path, const MB_String &base, int index, QueryFilter *query, RTDB_DownloadProgressCallback callback);
+  bool saveChunk(FirebaseData *fbdo, FirebaseJson &manifest, fb_esp_mem_storage_type storageType, const MB_String &base, int index, const MB_String &first, const MB_String &last);
+  bool scanChunkKeys(fb_esp_mem_storage_type storageType, const MB_String &filename, const MB_String &after, MB_String &first, MB_String &last, size_t &count);
+  void queryKey(MB_String &value, const MB_String &key);
+  bool loadChunkManifest(FirebaseData *fbdo, FirebaseJson &manifest, fb_esp_mem_storage_type storageType, const MB_String &base, int index);
+  bool saveChunkManifest(FirebaseData *fbdo, FirebaseJson &manifest, fb_esp_mem_storage_type storageType, const MB_String &base, int index);
+  void recordKey(FirebaseJson &record, PGM_P name, MB_String &key);
+  void manifestFileName(MB_String &filename, const MB_String &base, int index);
+  void chunkFileName(MB_String &filename, const MB_String &base, int index);
+  bool chunkFileCRC(fb_esp_mem_storage_type storageType, const MB_String &filename, uint32_t &crc, size_t &len);
+  bool chunkValid(FirebaseJson &record, fb_esp_mem_storage_type storageType, const MB_String &base, int index);
+  int compareKeys(const char *a, const char *b);
+  bool makePushID(MB_String &key);
+  void mBeginKeyCursor(RTDB_KeyCursor *cursor, MB_StringPtr path, size_t pageSize);
+  bool mGetKeys(FirebaseData *fbdo, MB_StringPtr path, RTDB_KeyCallback callback, size_t pageSize);
+  bool mReadKeys(FirebaseData *fbdo, RTDB_KeyCursor *cursor, RTDB_KeyCallback callback, String *buf, size_t size, size_t &count);
+  void getTopLevelKeys(const char *raw, std::vector<MB_String> &keys);
   uint8_t mErrorQueueCount(FirebaseData *fbdo, MB_StringPtr filename, fb_esp_mem_storage_type storageType);
   bool mRestoreErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, fb_esp_mem_storage_type storageType);
   bool mDeleteStorageFile(MB_StringPtr filename, fb_esp_mem_storage_type storageType);
@@ -1825,6 +2034,23 @@ private:
   void reportUploadProgress(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req, size_t readBytes);
   void reportDownloadProgress(FirebaseData *fbdo, struct fb_esp_rtdb_request_info_t *req, size_t readBytes);
   void sendUploadCallback(FirebaseData *fbdo, RTDB_UploadStatusInfo &in, RTDB_UploadProgressCallback cb, RTDB_UploadStatusInfo *out);
+  //read the responses of pending async requests until the keep number of requests left
+  bool readAsyncResponses(FirebaseData *fbdo, bool wait, size_t keep);
+  bool handleAsyncResponse(FirebaseData *fbdo);
+  void failAsync(FirebaseData *fbdo, int code);
+  void sendAsyncCallback(FirebaseData *fbdo, RTDB_AsyncStatusInfo &in);
+  bool cacheWrite(FirebaseData *fbdo, const MB_String &key, MB_StringPtr payload, fb_esp_data_type type);
+  bool readCachedWrite(FirebaseData *fbdo, const MB_String &key, fb_esp_data_type type, int subtype, uint32_t value_addr);
+  bool isChildPath(const MB_String &path, const MB_String &parent);
+  void appendJsonKey(MB_String &buf, const MB_String &key);
+  void setCachedValue(FirebaseData *fbdo, const MB_String &key, const MB_String &value, fb_esp_data_type cachedType, fb_esp_data_type type, int subtype, uint32_t value_addr);
+  void getReadCacheETag(const MB_String &key, MB_String &etag);
+  bool readCache(FirebaseData *fbdo, const MB_String &key, fb_esp_data_type type, int subtype, uint32_t value_addr);
+  void storeReadCache(FirebaseData *fbdo, const MB_String &key);
+  void invalidateReadCache(const MB_String &key);
+  void lockReadCache();
+  void unlockReadCache();
+  void trimPathSlashes(MB_String &path);
   void sendDownloadCallback(FirebaseData *fbdo, RTDB_DownloadStatusInfo &in, RTDB_DownloadProgressCallback cb, RTDB_DownloadStatusInfo *out);
 #if defined(ESP32)
       void runStreamTask(FirebaseData *fbdo, const char *taskName);
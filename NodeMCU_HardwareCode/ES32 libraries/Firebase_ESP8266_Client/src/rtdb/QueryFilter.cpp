@@ -84,7 +84,7 @@ QueryFilter &QueryFilter::mStartAt(MB_StringPtr val, bool isString)
         _startAt = (const char *)FPSTR("\"");
     _startAt += val;
     if (isString)
-        _startAt = (const char *)FPSTR("\"");
+        _startAt += (const char *)FPSTR("\"");
     return *this;
 }
 
@@ -94,7 +94,7 @@ QueryFilter &QueryFilter::mEndAt(MB_StringPtr val, bool isString)
         _endAt = (const char *)FPSTR("\"");
     _endAt += val;
     if (isString)
-        _endAt = (const char *)FPSTR("\"");
+        _endAt += (const char *)FPSTR("\"");
     return *this;
 }
 
@@ -53,6 +53,9 @@ FirebaseData::~FirebaseData()
 
     if (_ss.jsonPtr)
         delete _ss.jsonPtr;
+
+    if (_ss.tx_buf)
+        delete[] _ss.tx_buf;
 }
 
 bool FirebaseData::init()
@@ -430,6 +433,19 @@ String FirebaseData::pushName()
     return _ss.rtdb.push_name.c_str();
 }
 
+#if defined(OTA_UPDATE_ENABLED)
+size_t FirebaseData::otaWrittenBytes()
+{
+    return _ss.rtdb.ota.committed;
+}
+
+uint32_t FirebaseData::otaCRC32()
+{
+    FastCRC32 crc32;
+    return crc32.result(_ss.rtdb.ota.crc);
+}
+#endif
+
 bool FirebaseData::isStream()
 {
     return _ss.con_mode == fb_esp_con_mode_rtdb_stream;
@@ -532,6 +548,88 @@ void FirebaseData::setResponseSize(uint16_t len)
         _ss.resp_size = 4 * (1 + (len / 4));
 }
 
+void FirebaseData::setAdaptiveBufferSize(bool enable)
+{
+    _ss.adaptive_buffer = enable;
+}
+
+void FirebaseData::updateBufferSize(size_t reqLen, size_t respLen, bool ovf)
+{
+    if (!_ss.adaptive_buffer)
+        return;
+
+    //let the next response fit in the payload buffer
+    if (ovf && _ss.resp_size < MAX_ADAPTIVE_RESPONSE_SIZE)
+        setResponseSize(_ss.resp_size * 2 > MAX_ADAPTIVE_RESPONSE_SIZE ? MAX_ADAPTIVE_RESPONSE_SIZE : _ss.resp_size * 2);
+
+#if defined(ESP8266)
+
+    //the server records are limited to the accepted fragment length, which also sets the buffers
+    if (tcpClient.mflnChecked && tcpClient.fragmentable)
+        return;
+
+    respLen += HTTP_RESPONSE_HEADER_RESERVED_SIZE;
+
+    uint8_t rxIdx = 0, txIdx = 0;
+    while (rxIdx < BSSL_BUFFER_SIZE_HIST_BUCKETS - 1 && (size_t)(512 << rxIdx) < respLen)
+        rxIdx++;
+    while (txIdx < BSSL_BUFFER_SIZE_HIST_BUCKETS - 1 && (size_t)(512 << txIdx) < reqLen)
+        txIdx++;
+
+    _ss.bssl_rx_hist[rxIdx]++;
+    _ss.bssl_tx_hist[txIdx]++;
+    _ss.bssl_hist_count++;
+
+    //the old samples fade out so the sizes follow the recent traffic
+    if (_ss.bssl_hist_count >= BSSL_BUFFER_SIZE_HIST_DECAY)
+    {
+        _ss.bssl_hist_count = 0;
+        for (uint8_t i = 0; i < BSSL_BUFFER_SIZE_HIST_BUCKETS; i++)
+        {
+            _ss.bssl_rx_hist[i] /= 2;
+            _ss.bssl_tx_hist[i] /= 2;
+            _ss.bssl_hist_count += _ss.bssl_rx_hist[i];
+        }
+    }
+
+    //the receive buffer should hold the largest record (response) seen,
+    //the request data is fragmented by the client and only needs to cover the most (90%) requests.
+    uint16_t total = 0, acc = 0;
+    for (uint8_t i = 0; i < BSSL_BUFFER_SIZE_HIST_BUCKETS; i++)
+    {
+        if (_ss.bssl_rx_hist[i] > 0)
+            rxIdx = i;
+        total += _ss.bssl_tx_hist[i];
+    }
+
+    for (txIdx = 0; txIdx < BSSL_BUFFER_SIZE_HIST_BUCKETS - 1; txIdx++)
+    {
+        acc += _ss.bssl_tx_hist[txIdx];
+        if (acc * 10 >= total * 9)
+            break;
+    }
+
+    uint16_t rx = 512 << rxIdx, tx = 512 << txIdx;
+
+    //grow at once, shrink only when there are enough samples
+    if (rx < _ss.bssl_rx_size && _ss.bssl_hist_count < BSSL_BUFFER_SIZE_SHRINK_MIN_SAMPLES)
+        rx = _ss.bssl_rx_size;
+    if (tx < _ss.bssl_tx_size && _ss.bssl_hist_count < BSSL_BUFFER_SIZE_SHRINK_MIN_SAMPLES)
+        tx = _ss.bssl_tx_size;
+
+    //the new sizes are set to the client with the next connection (see setSecure)
+    _ss.bssl_rx_size = rx;
+    _ss.bssl_tx_size = tx;
+
+#endif
+}
+
+void FirebaseData::setTransport(WiFiClient *client, bool offline)
+{
+    closeSession();
+    tcpClient.setTransport(client, offline);
+}
+
 void FirebaseData::stopWiFiClient()
 {
     if (tcpClient.stream())
@@ -692,6 +790,13 @@ int FirebaseData::payloadLength()
     return _ss.payload_length;
 }
 
+#if defined(ENABLE_FB_METRICS)
+FirebaseMetrics &FirebaseData::metrics()
+{
+    return _ss.metrics;
+}
+#endif
+
 int FirebaseData::maxPayloadLength()
 {
     return _ss.max_payload_length;
@@ -723,6 +828,8 @@ void FirebaseData::closeSession()
     else
         status |= ethLinkUp(_spi_ethernet_module);
 
+    status |= tcpClient._offline;
+
     if (status)
     {
         //close the socket and free the resources used by the BearSSL data
@@ -746,33 +853,153 @@ void FirebaseData::closeSession()
     }
 #endif
     _ss.connected = false;
+    _ss.tx_len = 0;
+}
+
+size_t FirebaseData::txBufSize()
+{
+#if defined(ESP8266)
+    //one BearSSL record per flush
+    if (_ss.bssl_tx_size < 512)
+        _ss.bssl_tx_size = 512;
+    return _ss.bssl_tx_size;
+#else
+    return TCP_GATHER_BUFFER_SIZE;
+#endif
 }
 
-int FirebaseData::tcpSend(const char *data)
+size_t FirebaseData::reserveTxBuf()
 {
-    size_t len = strlen(data);
+    size_t size = txBufSize();
+
+    //the buffer follows the size change when it is empty, the pending data is sent with the current size
+    if (_ss.tx_buf && _ss.tx_cap != size && _ss.tx_len == 0)
+    {
+        delete[] _ss.tx_buf;
+        _ss.tx_buf = nullptr;
+    }
+
+    if (!_ss.tx_buf)
+    {
+        _ss.tx_buf = new char[size];
+        _ss.tx_cap = size;
+        _ss.tx_len = 0;
+    }
+
+    return _ss.tx_cap;
+}
+
+int FirebaseData::tcpSend(const char *data, size_t len)
+{
+    int ret = tcpWrite(data, len);
+    if (ret != 0)
+        return ret;
+    return tcpFlush();
+}
+
+int FirebaseData::tcpWrite(const char *data, size_t len)
+{
+    if (!data)
+        return 0;
+
+    if (len == 0)
+        len = strlen(data);
+
+    size_t cap = reserveTxBuf();
+
+    while (len > 0)
+    {
+        //the large data is sent directly without copying
+        if (_ss.tx_len == 0 && len >= cap)
+            return tcpSendData(data, len);
+
+        size_t n = cap - _ss.tx_len;
+        if (n > len)
+            n = len;
+
+        memcpy(_ss.tx_buf + _ss.tx_len, data, n);
+        _ss.tx_len += n;
+        data += n;
+        len -= n;
+
+        if (_ss.tx_len == cap)
+        {
+            int ret = tcpFlush();
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+    return 0;
+}
+
+int FirebaseData::tcpWriteP(PGM_P data)
+{
+    size_t len = strlen_P(data);
+    size_t cap = reserveTxBuf();
+
+    while (len > 0)
+    {
+        size_t n = cap - _ss.tx_len;
+        if (n > len)
+            n = len;
+
+        memcpy_P(_ss.tx_buf + _ss.tx_len, data, n);
+        _ss.tx_len += n;
+        data += n;
+        len -= n;
+
+        if (_ss.tx_len == cap)
+        {
+            int ret = tcpFlush();
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+    return 0;
+}
+
+int FirebaseData::tcpFlush()
+{
+    if (!_ss.tx_buf || _ss.tx_len == 0)
+        return 0;
+
+    size_t len = _ss.tx_len;
+    _ss.tx_len = 0;
+    return tcpSendData(_ss.tx_buf, len);
+}
+
+int FirebaseData::tcpSendData(const char *data, size_t len)
+{
+    _ss.tx_count += len;
     uint8_t attempts = 0;
     uint8_t maxRetry = 1;
 
     if (Signer.getCfg())
         maxRetry = Signer.getCfg()->tcp_data_sending_retry;
 
-#if defined(ESP8266)
-    if (_ss.bssl_tx_size < 512)
-        _ss.bssl_tx_size = 512;
-    maxRetry *= (1 + (len / _ss.bssl_tx_size));
-#endif
+    if (!reconnect())
+        return FIREBASE_ERROR_TCP_ERROR_CONNECTION_LOST;
 
     int index = 0;
-    int ret = tcpSendChunk(data, index, len);
-    while (ret != 0 || index < (int)len)
+    int ret = 0;
+    while (index < (int)len)
     {
-        attempts++;
-        if (attempts > maxRetry)
-            break;
-        if (!reconnect())
-            return FIREBASE_ERROR_TCP_ERROR_CONNECTION_LOST;
         ret = tcpSendChunk(data, index, len);
+
+        //the connection is checked again only when the chunk sending was failed
+        if (ret != 0)
+        {
+            attempts++;
+            if (attempts > maxRetry)
+                break;
+#if defined(ENABLE_FB_METRICS)
+            _ss.metrics.retries++;
+#endif
+            if (!reconnect())
+                return FIREBASE_ERROR_TCP_ERROR_CONNECTION_LOST;
+        }
     }
     return ret;
 }
@@ -780,8 +1007,6 @@ int FirebaseData::tcpSend(const char *data)
 int FirebaseData::tcpSendChunk(const char *data, int &index, size_t len)
 {
     ut->idle();
-    if (!reconnect())
-        return FIREBASE_ERROR_TCP_ERROR_CONNECTION_LOST;
 #if defined(ESP8266)
     int chunkSize = len - index > _ss.bssl_tx_size ? _ss.bssl_tx_size : len - index;
 #else
@@ -800,6 +1025,9 @@ bool FirebaseData::reconnect(unsigned long dataTime)
 
     status |= (init()) ? ((_spi_ethernet_module) ? ethLinkUp(_spi_ethernet_module) : ethLinkUp(&(Signer.getCfg()->spi_ethernet_module))) : ethLinkUp(_spi_ethernet_module);
 
+    //the transport that does not use the network is always ready
+    status |= tcpClient._offline;
+
     if (dataTime > 0)
     {
         unsigned long tmo = DEFAULT_SERVER_RESPONSE_TIMEOUT;
@@ -852,6 +1080,9 @@ bool FirebaseData::reconnect(unsigned long dataTime)
 
                 if (millis() - Signer.getCfg()->_int.fb_last_reconnect_millis > Signer.getCfg()->timeout.wifiReconnect && !_ss.connected)
                 {
+#if defined(ENABLE_FB_METRICS)
+                    _ss.metrics.reconnects++;
+#endif
                     WiFi.reconnect();
                     Signer.getCfg()->_int.fb_last_reconnect_millis = millis();
                 }
@@ -863,6 +1094,9 @@ bool FirebaseData::reconnect(unsigned long dataTime)
             {
                 if (millis() - last_reconnect_millis > reconnect_tmo && !_ss.connected)
                 {
+#if defined(ENABLE_FB_METRICS)
+                    _ss.metrics.reconnects++;
+#endif
                     WiFi.reconnect();
                     last_reconnect_millis = millis();
                 }
@@ -892,12 +1126,23 @@ void FirebaseData::setTimeout()
     }
 }
 
-void FirebaseData::setSecure()
+void FirebaseData::setSecure(fb_transport_type type, const char *publicKey)
 {
     setTimeout();
 
     tcpClient.setMBFS(mbfs);
 
+#if defined(ESP8266)
+    //the buffer sizes are also used by the pinned key client
+    tcpClient._bsslRxSize = _ss.bssl_rx_size;
+    tcpClient._bsslTxSize = _ss.bssl_tx_size;
+#endif
+
+    //the plain client has no certificate and the pinned key replaces the certificate
+    tcpClient.setTransportType(type, publicKey);
+    if (type != fb_transport_type_secure)
+        return;
+
 #if defined(ESP8266)
     if (time(nullptr) > ESP_DEFAULT_TS)
     {
@@ -905,8 +1150,6 @@ void FirebaseData::setSecure()
             Signer.getCfg()->_int.fb_clock_rdy = true;
         tcpClient._clockReady = true;
     }
-    tcpClient._bsslRxSize = _ss.bssl_rx_size;
-    tcpClient._bsslTxSize = _ss.bssl_tx_size;
 #endif
 
     if (tcpClient._certType == -1 || _ss.cert_updated)
@@ -971,7 +1214,14 @@ bool FirebaseData::validRequest(const MB_String &path)
 
 bool FirebaseData::tokenReady()
 {
+#if defined(ENABLE_FB_METRICS)
+    unsigned long ms = millis();
+    bool ready = Signer.tokenReady();
+    _ss.metrics.addNestedPhase(fb_esp_metrics_phase_token, millis() - ms);
+    if (!ready)
+#else
     if (!Signer.tokenReady())
+#endif
     {
         _ss.http_code = FIREBASE_ERROR_TOKEN_NOT_READY;
         closeSession();
@@ -1009,6 +1259,14 @@ void FirebaseData::clear()
     if (_ss.jsonPtr)
         _ss.jsonPtr->clear();
 
+    if (_ss.tx_buf)
+    {
+        delete[] _ss.tx_buf;
+        _ss.tx_buf = nullptr;
+        _ss.tx_len = 0;
+        _ss.tx_cap = 0;
+    }
+
 #ifdef ENABLE_RTDB
 
     _dataAvailableCallback = NULL;
@@ -1860,8 +2118,6 @@ bool FCMObject::fcm_send(FirebaseData &fbdo, fb_esp_fcm_msg_type messageType)
     {
         fbdo._ss.http_code = FIREBASE_ERROR_TCP_ERROR_NOT_CONNECTED;
         fbdo.closeSession();
-        if (Signer.getCfg())
-            Signer.getCfg()->_int.fb_processing = false;
         return false;
     }
     else
@@ -1872,9 +2128,6 @@ bool FCMObject::fcm_send(FirebaseData &fbdo, fb_esp_fcm_msg_type messageType)
     if (!ret)
         fbdo.closeSession();
 
-    if (Signer.getCfg())
-        Signer.getCfg()->_int.fb_processing = false;
-
     return ret;
 }
 
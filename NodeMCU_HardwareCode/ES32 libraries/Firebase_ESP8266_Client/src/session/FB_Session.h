@@ -311,6 +311,17 @@ public:
   void setBSSLBufferSize(uint16_t rx, uint16_t tx);
 #endif
 
+  /** Enable the buffer sizes adaptation from the observed request and response sizes.
+   * 
+   * @param enable The boolean value to enable/disable.
+   * 
+   * @note The BearSSL receive and transmit buffers (ESP8266) are resized with the next connection,
+   * the current connection is kept. The buffers are not adapted when the server accepted the maximum
+   * fragment length, the buffers follow the fragment length.
+   * The response size limit is doubled after the buffer overflow error occurred.
+  */
+  void setAdaptiveBufferSize(bool enable);
+
   /** Set the HTTP response size limit.
    * 
    * @param len The server response buffer size limit. 
@@ -346,6 +357,18 @@ public:
   */
   WiFiClientSecure *getWiFiClient();
 
+  /** Use the external client as the transport instead of the internal secure client.
+   * 
+   * @param client The client, e.g. FB_Replay_Client (wcs/replay/FB_Replay_Client.h) that replays 
+   * the recorded responses for the offline benchmark, or nullptr to use the internal secure client again.
+   * @param offline Set true for the client that does not need the network e.g. FB_Replay_Client, 
+   * the WiFi status is then not checked before the request.
+   * 
+   * @note The request and response handling is not changed, only the bytes go through this client.
+   * The client is not owned by the Firebase Data object.
+  */
+  void setTransport(WiFiClient *client, bool offline = false);
+
   /** Close the keep-alive connection of the internal WiFi client.
    * 
    * @note This will release the memory used by internal WiFi client.
@@ -714,6 +737,20 @@ public:
   String pushName();
 #endif
 
+#if defined(ENABLE_RTDB) && defined(OTA_UPDATE_ENABLED)
+  /** Get the number of firmware bytes written to flash by the last downloadOTA call (RTDB only).
+   * 
+   * @return size_t number of bytes, this tells how far the interrupted download went.
+  */
+  size_t otaWrittenBytes();
+
+  /** Get the CRC-32 of the firmware bytes written to flash by the last downloadOTA call (RTDB only).
+   * 
+   * @return uint32_t CRC-32 (the same as zlib's crc32) of the written image.
+  */
+  uint32_t otaCRC32();
+#endif
+
   /** Get the stream connection status (RTDB only).
    * 
    * @return Boolean type status indicates whether the Firebase Data object is working with a stream or not.
@@ -778,6 +815,18 @@ public:
   */
   int payloadLength();
 
+#if defined(ENABLE_FB_METRICS)
+  /** Get the request metrics of this Firebase Data object (RTDB only).
+   * 
+   * @return The FirebaseMetrics object with the phase times of the last request, the counters 
+   * and the request latency histogram.
+   * 
+   * @note Available when ENABLE_FB_METRICS was defined in FirebaseFS.h, call metrics().reset() to clear, 
+   * metrics().printTo(Serial) to print.
+  */
+  FirebaseMetrics &metrics();
+#endif
+
   /** Get the maximum size of HTTP payload length returned from the server.
    * 
    * @return integer number of max payload length.
@@ -895,14 +944,21 @@ private:
   void closeSession();
   bool handleStreamRead();
   void checkOvf(size_t len, struct server_response_data_t &resp);
-  int tcpSend(const char *data);
+  int tcpSend(const char *data, size_t len = 0);
+  int tcpWrite(const char *data, size_t len = 0);
+  int tcpWriteP(PGM_P data);
+  int tcpFlush();
+  int tcpSendData(const char *data, size_t len);
   int tcpSendChunk(const char *data, int &index, size_t len);
+  size_t txBufSize();
+  size_t reserveTxBuf();
+  void updateBufferSize(size_t reqLen, size_t respLen, bool ovf);
   bool reconnect(unsigned long dataTime = 0);
   MB_String getDataType(uint8_t type);
   MB_String getMethod(uint8_t method);
   bool tokenReady();
   void setTimeout();
-  void setSecure();
+  void setSecure(fb_transport_type type = fb_transport_type_secure, const char *publicKey = nullptr);
   bool validRequest(const MB_String &path);
   void addQueue(struct fb_esp_rtdb_queue_info_t *qinfo);
 #ifdef ENABLE_RTDB
@@ -267,6 +267,97 @@ bool Firebase_Signer::isExpired()
     return ((unsigned long)time(nullptr) > config->signer.tokens.expires - config->signer.preRefreshSeconds || config->signer.tokens.expires == 0);
 }
 
+bool Firebase_Signer::isRefreshDue()
+{
+    if (!config || !auth || config->signer.bgRefreshSeconds == 0 || config->signer.tokens.expires == 0)
+        return false;
+
+    //only the tokens that can be renewed with the refresh token are refreshed in background,
+    //the service account (OAuth2) and legacy tokens use the blocking token generation.
+    if (!isAuthToken(false) || config->_int.rtok_len == 0 || config->_int.ltok_len > 0)
+        return false;
+
+    unsigned long lead = config->signer.bgRefreshSeconds + config->_int.fb_token_refresh_jitter;
+
+    if (lead <= config->signer.preRefreshSeconds || lead >= config->signer.tokens.expires)
+        return false;
+
+    return (unsigned long)time(nullptr) > config->signer.tokens.expires - lead;
+}
+
+bool Firebase_Signer::hasValidToken()
+{
+    if (!config || config->_int.atok_len == 0 || config->signer.tokens.expires == 0)
+        return false;
+
+    return (unsigned long)time(nullptr) < config->signer.tokens.expires - config->signer.preRefreshSeconds;
+}
+
+void Firebase_Signer::runBackgroundRefresh()
+{
+    if (_bg_refresh || config->signer.tokens.status == token_status_on_request || config->signer.tokens.status == token_status_on_refresh)
+        return;
+
+    if (millis() - config->signer.lastReqMillis < config->signer.reqTO && config->signer.lastReqMillis > 0)
+        return;
+
+    _bg_refresh = true;
+    config->signer.lastReqMillis = millis();
+
+#if defined(ESP32)
+
+    //created here before the task exists, the requests only lock it when it was created
+    if (!_authTokenMutex)
+        _authTokenMutex = xSemaphoreCreateMutex();
+
+    if (!_authTokenMutex)
+    {
+        _bg_refresh = false;
+        return;
+    }
+
+    TaskFunction_t taskCode = [](void *param)
+    {
+        Signer.backgroundRefreshTask();
+        Signer.getCfg()->_int.token_refresh_task_handle = NULL;
+        vTaskDelete(NULL);
+    };
+
+    if (xTaskCreatePinnedToCore(taskCode, "tokenRefreshTask", TOKEN_REFRESH_TASK_STACK_SIZE, NULL, 1, &config->_int.token_refresh_task_handle, 1) != pdPASS)
+        _bg_refresh = false;
+
+#elif defined(ESP8266)
+    set_scheduled_callback(std::bind(&Firebase_Signer::backgroundRefreshTask, this));
+#endif
+}
+
+void Firebase_Signer::backgroundRefreshTask()
+{
+    //the requests keep using the current token while it is being exchanged,
+    //the new token replaces it only when the exchange was succeeded.
+    //the token status is not changed here, the failed exchange is retried after reqTO.
+    if (!refreshToken())
+        config->signer.lastReqMillis = millis();
+
+    _bg_refresh = false;
+}
+
+void Firebase_Signer::lockAuthToken()
+{
+#if defined(ESP32)
+    if (_authTokenMutex)
+        xSemaphoreTake(_authTokenMutex, portMAX_DELAY);
+#endif
+}
+
+void Firebase_Signer::unlockAuthToken()
+{
+#if defined(ESP32)
+    if (_authTokenMutex)
+        xSemaphoreGive(_authTokenMutex);
+#endif
+}
+
 bool Firebase_Signer::handleToken()
 {
     if (!config || !auth)
@@ -582,13 +673,17 @@ bool Firebase_Signer::refreshToken()
     if (config->_int.ltok_len > 0 || (config->_int.rtok_len == 0 && config->_int.atok_len == 0))
         return false;
 
-    config->signer.tokens.status = token_status_on_refresh;
-    config->_int.fb_processing = true;
-    config->signer.tokens.error.code = 0;
-    config->signer.tokens.error.message.clear();
-    config->_int.fb_last_jwt_generation_error_cb_millis = 0;
-    sendTokenStatusCB();
-    config->_int.auth_token.clear();
+    //the background refresh should not block the other requests or change the token status
+    //those are read by the other tasks
+    if (!_bg_refresh)
+    {
+        config->signer.tokens.status = token_status_on_refresh;
+        config->_int.fb_processing = true;
+        config->signer.tokens.error.code = 0;
+        config->signer.tokens.error.message.clear();
+        config->_int.fb_last_jwt_generation_error_cb_millis = 0;
+        sendTokenStatusCB();
+    }
 
 #if defined(ESP32)
     config->signer.wcs = new FB_TCP_Client();
@@ -664,29 +759,40 @@ bool Firebase_Signer::refreshToken()
         if (parseJsonResponse(fb_esp_pgm_str_257))
         {
             error.code = config->signer.result->to<int>();
-            config->signer.tokens.status = token_status_error;
 
             if (parseJsonResponse(fb_esp_pgm_str_258))
                 error.message = config->signer.result->to<const char *>();
         }
 
-        config->signer.tokens.error = error;
-        tokenInfo.status = config->signer.tokens.status;
-        tokenInfo.type = config->signer.tokens.token_type;
-        tokenInfo.error = config->signer.tokens.error;
-        config->_int.fb_last_jwt_generation_error_cb_millis = 0;
-        if (error.code != 0)
-            sendTokenStatusCB();
+        if (!_bg_refresh)
+        {
+            if (error.code != 0)
+                config->signer.tokens.status = token_status_error;
+            config->signer.tokens.error = error;
+            tokenInfo.status = config->signer.tokens.status;
+            tokenInfo.type = config->signer.tokens.token_type;
+            tokenInfo.error = config->signer.tokens.error;
+            config->_int.fb_last_jwt_generation_error_cb_millis = 0;
+            if (error.code != 0)
+                sendTokenStatusCB();
+        }
 
         if (error.code == 0)
         {
+            //swap in the new token, the old one was still in use until now,
+            //the request that is sending the old token holds the lock (see FB_RTDB::sendHeader).
+            //the token type is checked under the lock, the database secret that replaces
+            //the token for the rules and index requests is kept (see FB_RTDB::storeToken)
+            lockAuthToken();
+
             if (isAuthToken(false))
             {
                 if (parseJsonResponse(fb_esp_pgm_str_208))
                 {
-                    config->_int.auth_token = config->signer.result->to<const char *>();
-                    config->_int.atok_len = strlen(config->signer.result->to<const char *>());
+                    MB_String token = config->signer.result->to<const char *>();
+                    config->_int.atok_len = token.length();
                     config->_int.ltok_len = 0;
+                    config->_int.auth_token.swap(token);
                 }
 
                 if (parseJsonResponse(fb_esp_pgm_str_209))
@@ -701,6 +807,9 @@ bool Firebase_Signer::refreshToken()
                 if (parseJsonResponse(fb_esp_pgm_str_187))
                     auth->token.uid = config->signer.result->to<const char *>();
             }
+
+            unlockAuthToken();
+
             return handleSignerError(0);
         }
 
@@ -724,7 +833,8 @@ void Firebase_Signer::setTokenError(int code)
 
     if (config->signer.tokens.error.message.length() == 0)
     {
-        config->_int.fb_processing = false;
+        if (!_bg_refresh)
+            config->_int.fb_processing = false;
         switch (code)
         {
         case FIREBASE_ERROR_TOKEN_SET_TIME:
@@ -766,6 +876,18 @@ void Firebase_Signer::setTokenError(int code)
 
 bool Firebase_Signer::handleSignerError(int code, int httpCode)
 {
+    //the background refresh keeps the current token and its status, only the resources are released
+    if (_bg_refresh)
+    {
+        if (config->signer.wcs)
+            delete config->signer.wcs;
+        if (config->signer.json)
+            delete config->signer.json;
+        if (config->signer.result)
+            delete config->signer.result;
+        return code == 0;
+    }
+
 
     switch (code)
     {
@@ -822,7 +944,8 @@ bool Firebase_Signer::handleSignerError(int code, int httpCode)
     if (config->signer.result)
         delete config->signer.result;
 
-    config->_int.fb_processing = false;
+    if (!_bg_refresh)
+        config->_int.fb_processing = false;
 
     if (code > 0 && code < 4)
     {
@@ -1845,6 +1968,9 @@ void Firebase_Signer::getExpiration(const char *exp)
     unsigned long ms = millis();
     config->signer.tokens.expires = ts + atoi(exp);
     config->signer.tokens.last_millis = ms;
+
+    //spread the background refresh of the devices those were signed in at the same time
+    config->_int.fb_token_refresh_jitter = config->signer.bgRefreshJitterSeconds > 0 ? random(0, config->signer.bgRefreshJitterSeconds + 1) : 0;
 }
 
 bool Firebase_Signer::handleEmailSending(MB_StringPtr payload, fb_esp_user_email_sending_type type)
@@ -1991,6 +2117,10 @@ void Firebase_Signer::checkToken()
     if (!config || !auth)
         return;
 
+    //the token is being refreshed in background, the refresh task updates the token and its expiration
+    if (_bg_refresh)
+        return;
+
     //if the time was set (changed) after token has been generated, update its expiration
     if (config->signer.tokens.expires > 0 && config->signer.tokens.expires < ESP_DEFAULT_TS && time(nullptr) > ESP_DEFAULT_TS)
         config->signer.tokens.expires += time(nullptr) - (millis() - config->signer.tokens.last_millis) / 1000 - 60;
@@ -2000,6 +2130,8 @@ void Firebase_Signer::checkToken()
 
     if (isAuthToken(true) && ((unsigned long)time(nullptr) > config->signer.tokens.expires - config->signer.preRefreshSeconds || config->signer.tokens.expires == 0))
         handleToken();
+    else if (isRefreshDue())
+        runBackgroundRefresh();
 }
 
 bool Firebase_Signer::tokenReady()
@@ -2008,6 +2140,11 @@ bool Firebase_Signer::tokenReady()
         return false;
 
     checkToken();
+
+    //the token is being refreshed in background, the current token is used until it expires.
+    if (_bg_refresh)
+        return hasValidToken();
+
     return config->signer.tokens.status == token_status_ready;
 };
 
@@ -2211,6 +2348,12 @@ void Firebase_Signer::errorToString(int httpCode, MB_String &buff)
     case FIREBASE_ERROR_INVALID_JSON_RULES:
         buff.appendP(fb_esp_pgm_str_581);
         return;
+    case FIREBASE_ERROR_BACKUP_CHUNK_INVALID:
+        buff.appendP(fb_esp_pgm_str_594);
+        return;
+    case FIREBASE_ERROR_SYSTEM_TIME_NOT_SET:
+        buff.appendP(fb_esp_pgm_str_211);
+        return;
 #if defined(FLASH_FS) || defined(SD_FS)
 
     case MB_FILE_ERROR_FLASH_STORAGE_IS_NOT_READY:
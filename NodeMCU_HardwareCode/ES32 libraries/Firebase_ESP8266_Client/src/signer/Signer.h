@@ -84,6 +84,12 @@ private:
     struct token_info_t tokenInfo;
     bool authenticated = false;
     bool _token_processing_task_enable = false;
+    //set by the request thread before the refresh starts and cleared by the refresh task when done
+    volatile bool _bg_refresh = false;
+#if defined(ESP32)
+    //guards the auth token that is replaced by the refresh task while the requests are sending it
+    SemaphoreHandle_t _authTokenMutex = NULL;
+#endif
     unsigned long unauthen_millis = 0;
     unsigned long unauthen_pause_duration = 3000;
 
@@ -95,6 +101,12 @@ private:
     bool userSigninDataReady();
     bool isAuthToken(bool admin);
     bool isExpired();
+    bool isRefreshDue();
+    bool hasValidToken();
+    void runBackgroundRefresh();
+    void backgroundRefreshTask();
+    void lockAuthToken();
+    void unlockAuthToken();
     bool handleToken();
     bool parseJsonResponse(PGM_P key_path);
     bool refreshToken();
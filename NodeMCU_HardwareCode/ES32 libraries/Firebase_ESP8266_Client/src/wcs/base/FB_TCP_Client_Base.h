@@ -332,79 +332,7 @@ public:
         if (!client)
             return setError(FIREBASE_ERROR_TCP_ERROR_CONNECTION_REFUSED);
 
-        char *tmp = nullptr;
-        char *buf = nullptr;
-        int p1 = 0;
-        int olen = 0;
-
-        if (chunkState == 0)
-        {
-            chunkState = 1;
-            chunkedSize = -1;
-            dataLen = 0;
-            buf = (char *)mbfs->newP(bufLen);
-            int readLen = readLine(buf, bufLen);
-            if (readLen)
-            {
-                p1 = strpos(buf, (const char *)MBSTRING_FLASH_MCR(";"), 0);
-                if (p1 == -1)
-                {
-                    p1 = strpos(buf, (const char *)MBSTRING_FLASH_MCR("\r\n"), 0);
-                }
-
-                if (p1 != -1)
-                {
-                    tmp = (char *)mbfs->newP(p1 + 1);
-                    memcpy(tmp, buf, p1);
-                    chunkedSize = hex2int(tmp);
-                    mbfs->delP(&tmp);
-                }
-
-                // last chunk
-                if (chunkedSize < 1)
-                    olen = -1;
-            }
-            else
-                chunkState = 0;
-
-            mbfs->delP(&buf);
-        }
-        else
-        {
-
-            if (chunkedSize > -1)
-            {
-                buf = (char *)mbfs->newP(bufLen);
-                int readLen = readLine(buf, bufLen);
-
-                if (readLen > 0)
-                {
-                    // chunk may contain trailing
-                    if (dataLen + readLen - 2 < chunkedSize)
-                    {
-                        dataLen += readLen;
-                        memcpy(out, buf, readLen);
-                        olen = readLen;
-                    }
-                    else
-                    {
-                        if (chunkedSize - dataLen > 0)
-                            memcpy(out, buf, chunkedSize - dataLen);
-                        dataLen = chunkedSize;
-                        chunkState = 0;
-                        olen = readLen;
-                    }
-                }
-                else
-                {
-                    olen = -1;
-                }
-
-                mbfs->delP(&buf);
-            }
-        }
-
-        return olen;
+        return MB_Chunked::read(client, out, chunkState, chunkedSize, dataLen, bufLen);
     }
 
     bool sendBase64(size_t bufSize, uint8_t *data, size_t len, bool flashMem)
@@ -518,74 +446,7 @@ public:
         if (!client)
             return setError(FIREBASE_ERROR_TCP_ERROR_CONNECTION_REFUSED);
 
-        char *tmp = nullptr;
-        int p1 = 0;
-        int olen = 0;
-
-        if (chunkState == 0)
-        {
-            chunkState = 1;
-            chunkedSize = -1;
-            dataLen = 0;
-            MB_String s;
-            int readLen = readLine(s);
-            if (readLen)
-            {
-                p1 = strpos(s.c_str(), (const char *)MBSTRING_FLASH_MCR(";"), 0);
-                if (p1 == -1)
-                {
-                    p1 = strpos(s.c_str(), (const char *)MBSTRING_FLASH_MCR("\r\n"), 0);
-                }
-
-                if (p1 != -1)
-                {
-                    tmp = (char *)mbfs->newP(p1 + 1);
-                    memcpy(tmp, s.c_str(), p1);
-                    chunkedSize = hex2int(tmp);
-                    mbfs->delP(&tmp);
-                }
-
-                // last chunk
-                if (chunkedSize < 1)
-                    olen = -1;
-            }
-            else
-                chunkState = 0;
-        }
-        else
-        {
-
-            if (chunkedSize > -1)
-            {
-                MB_String s;
-                int readLen = readLine(s);
-
-                if (readLen > 0)
-                {
-                    // chunk may contain trailing
-                    if (dataLen + readLen - 2 < chunkedSize)
-                    {
-                        dataLen += readLen;
-                        out += s;
-                        olen = readLen;
-                    }
-                    else
-                    {
-                        if (chunkedSize - dataLen > 0)
-                            out += s;
-                        dataLen = chunkedSize;
-                        chunkState = 0;
-                        olen = readLen;
-                    }
-                }
-                else
-                {
-                    olen = -1;
-                }
-            }
-        }
-
-        return olen;
+        return MB_Chunked::read(client, out, chunkState, chunkedSize, dataLen);
     }
 
     virtual void flush()
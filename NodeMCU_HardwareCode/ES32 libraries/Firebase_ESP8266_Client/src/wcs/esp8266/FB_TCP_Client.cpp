@@ -51,29 +51,34 @@ bool FB_TCP_Client::begin(const char *host, uint16_t port)
   _host = host;
   _port = port;
 
+  //the external and plain clients have no TLS buffers to set up
+  if (_transport || _transportType == fb_transport_type_plain)
+    return true;
+
   //probe for fragmentation support at the specified size
   if (!mflnChecked)
   {
     fragmentable = _wcs->probeMaxFragmentLength(_host.c_str(), _port, chunkSize);
-    if (fragmentable)
-    {
-      _bsslRxSize = chunkSize;
-      _bsslTxSize = chunkSize;
-      _wcs->setBufferSizes(_bsslRxSize, _bsslTxSize);
-    }
     mflnChecked = true;
   }
 
-  if (!fragmentable)
-    _wcs->setBufferSizes(_bsslRxSize, _bsslTxSize);
+  //the server records are limited to the fragment length, the own records can be smaller
+  if (fragmentable)
+  {
+    _bsslRxSize = chunkSize;
+    if (_bsslTxSize > chunkSize)
+      _bsslTxSize = chunkSize;
+  }
+
+  _wcs->setBufferSizes(_bsslRxSize, _bsslTxSize);
 
   return true;
 }
 
 bool FB_TCP_Client::connected()
 {
-  if (_wcs)
-    return (_wcs->connected());
+  if (client())
+    return (client()->connected());
   return false;
 }
 
@@ -88,7 +93,7 @@ int FB_TCP_Client::send(const char *data, size_t len)
   if (len == 0)
     return 0;
 
-  if (_wcs->write((const uint8_t *)data, len) != len)
+  if (client()->write((const uint8_t *)data, len) != len)
     return FIREBASE_ERROR_TCP_ERROR_SEND_PAYLOAD_FAILED;
 
   return 0;
@@ -97,23 +102,35 @@ int FB_TCP_Client::send(const char *data, size_t len)
 WiFiClient *FB_TCP_Client::stream(void)
 {
   if (connected())
-    return _wcs.get();
+    return client();
   return nullptr;
 }
 
 bool FB_TCP_Client::connect(void)
 {
+  if (!client())
+    return false;
+
   if (connected())
   {
-    while (_wcs->available() > 0)
-      _wcs->read();
+    while (client()->available() > 0)
+      client()->read();
     return true;
   }
 
-  _wcs->setTimeout(timeout);
+  client()->setTimeout(timeout);
 
-  if (!_wcs->connect(_host.c_str(), _port))
+#if defined(ENABLE_FB_METRICS)
+  unsigned long ms = millis();
+  bool ret = client()->connect(_host.c_str(), _port);
+  if (metrics)
+    metrics->addHandshake(millis() - ms, ret);
+  if (!ret)
+    return false;
+#else
+  if (!client()->connect(_host.c_str(), _port))
     return false;
+#endif
 
   return connected();
 }
@@ -126,8 +143,17 @@ void FB_TCP_Client::release()
     _wcs.reset(nullptr);
     _wcs.release();
   }
+  if (_tcp)
+  {
+    _tcp->stop();
+    _tcp.reset(nullptr);
+  }
   if (x509)
     delete x509;
+  if (_publicKey)
+    delete _publicKey;
+  _publicKey = nullptr;
+  _publicKeyPEM = nullptr;
 }
 
 void FB_TCP_Client::setCACert(const char *caCert)
@@ -191,6 +217,77 @@ void FB_TCP_Client::setMBFS(MB_File *mbfs)
   this->mbfs = mbfs;
 }
 
+void FB_TCP_Client::setTransport(WiFiClient *client, bool offline)
+{
+  if (_transport && _transport != client)
+    _transport->stop();
+  _transport = client;
+  _offline = client && offline;
+  mflnChecked = false;
+}
+
+void FB_TCP_Client::setTransportType(fb_transport_type type, const char *publicKey)
+{
+  bool changed = type != _transportType;
+
+  if (changed)
+  {
+    if (client())
+      client()->stop();
+
+    //the known key replaced the trust anchors, the certificate is set again by FirebaseData::setSecure
+    if (_transportType == fb_transport_type_pinned_key)
+      _certType = fb_cert_type_undefined;
+
+    _transportType = type;
+    mflnChecked = false;
+  }
+
+  if (type == fb_transport_type_plain)
+  {
+    if (!_tcp)
+    {
+      _tcp = std::unique_ptr<WiFiClient>(new WiFiClient());
+      _tcp->setNoDelay(true);
+    }
+  }
+  else if (type == fb_transport_type_pinned_key)
+  {
+    //the new client has no insecure mode and no trust anchors of the previous certificate,
+    //and no reference to the previous key
+    if (changed || publicKey != _publicKeyPEM || !_wcs)
+    {
+      if (_wcs)
+        _wcs->stop();
+      _wcs = std::unique_ptr<FB_ESP_SSL_CLIENT>(new FB_ESP_SSL_CLIENT());
+      _wcs->setBufferSizes(_bsslRxSize, _bsslTxSize);
+      _wcs->setNoDelay(true);
+    }
+
+    if (publicKey != _publicKeyPEM)
+    {
+      if (_publicKey)
+        delete _publicKey;
+      _publicKey = publicKey ? new BearSSL::PublicKey(publicKey) : nullptr;
+      _publicKeyPEM = publicKey;
+    }
+
+    //no certificate chain to parse and no clock required, the resumed session skips the key exchange
+    if (_publicKey)
+      _wcs->setKnownKey(_publicKey);
+    _wcs->setSession(&_session);
+  }
+}
+
+WiFiClient *FB_TCP_Client::client()
+{
+  if (_transport)
+    return _transport;
+  if (_transportType == fb_transport_type_plain)
+    return _tcp.get();
+  return _wcs.get();
+}
+
 #endif /* ESP8266 */
 
 #endif /* FB_TCP_Client_CPP */
\ No newline at end of file
@@ -35,6 +35,7 @@
 #include "MB_File.h"
 #include "FB_Net.h"
 #include "FB_Error.h"
+#include "FB_Metrics.h"
 
 class FB_TCP_Client
 {
@@ -84,6 +85,22 @@ public:
   bool connect(void);
   void setMBFS(MB_File *mbfs);
 
+  /**
+   * Use the external client instead of the internal secure client.
+   * \param client - The client e.g. WiFiClient for plain TCP or FB_Replay_Client, nullptr to use the secure client again.
+   * \param offline - The client does not need the network.
+   * The external client is not owned, it should exist as long as it is in use.
+  */
+  void setTransport(WiFiClient *client, bool offline = false);
+
+  /**
+   * Select the client type of the connection.
+   * \param type - fb_transport_type_secure, fb_transport_type_plain or fb_transport_type_pinned_key.
+   * \param publicKey - The PEM public key of the server for fb_transport_type_pinned_key.
+   * The current connection is closed when the type was changed.
+  */
+  void setTransportType(fb_transport_type type, const char *publicKey = nullptr);
+
 private:
   std::unique_ptr<FB_ESP_SSL_CLIENT> _wcs = std::unique_ptr<FB_ESP_SSL_CLIENT>(new FB_ESP_SSL_CLIENT());
   MB_String _host;
@@ -105,8 +122,20 @@ private:
   bool mflnChecked = false;
   X509List *x509 = nullptr;
   MB_File *mbfs = nullptr;
+  WiFiClient *_transport = nullptr;
+  bool _offline = false;
+  fb_transport_type _transportType = fb_transport_type_secure;
+  std::unique_ptr<WiFiClient> _tcp;
+  BearSSL::PublicKey *_publicKey = nullptr;
+  const char *_publicKeyPEM = nullptr;
+  BearSSL::Session _session;
+#if defined(ENABLE_FB_METRICS)
+  //the metrics of the session that uses this client
+  FirebaseMetrics *metrics = nullptr;
+#endif
 
   void release();
+  WiFiClient *client();
 };
 
 #endif /* ESP8266 */
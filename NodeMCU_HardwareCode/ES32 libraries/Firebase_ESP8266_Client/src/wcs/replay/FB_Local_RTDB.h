@@ -0,0 +1,1117 @@
+/**
+ * FB_Local_RTDB
+ *
+ * The local stand-in of the Firebase Realtime Database for the load and soak test of the device stack.
+ *
+ * FB_Local_RTDB keeps the database in memory and serves the part of the REST and streaming protocol
+ * that the library uses:
+ * PUT, POST, PATCH (multi-path), GET and DELETE of <path>.json, X-HTTP-Method-Override, print=silent,
+ * shallow, orderBy ($key, $value or the child path) with limitToFirst, limitToLast, startAt, endAt and equalTo,
+ * X-Firebase-ETag, if-match and if-none-match, the timestamp server value and the text/event-stream
+ * with put, patch and keep-alive events. The response bodies are sent with the Content-Length or the
+ * chunked transfer encoding (setChunkSize).
+ *
+ * Each FB_Local_RTDB_Client is one connection to the stand-in, it is set to the Firebase Data object
+ * with FirebaseData::setTransport(&client, true). The writes from any connection are sent to all streams
+ * at or under the changed path. The latency and the dropped connections are set per connection
+ * (see FB_Replay_Client.h), requestCount, eventCount and errorCount give the server side counts.
+ *
+ * Any auth is accepted unless setAuth was set, use the legacy token (database secret) as the token
+ * generation is not served. The security rules are not evaluated.
+ *
+ * This work is an extension of the Firebase ESP Client library by K. Suwatchai (Mobizt)
+ * Copyright (c) 2026 RFID Door Lock System contributors
+ *
+ * The MIT License (MIT)
+ */
+
+#ifndef FB_Local_RTDB_H
+#define FB_Local_RTDB_H
+
+#include <Arduino.h>
+#include <vector>
+#include <algorithm>
+#include <time.h>
+#include "FB_Replay_Client.h"
+#include "Utils.h"
+#include "json/MB_JSON/MB_JSON.h"
+
+#define FB_LOCAL_RTDB_KEEP_ALIVE_INTERVAL 30000
+
+class FB_Local_RTDB_Client;
+
+class FB_Local_RTDB
+{
+    friend class FB_Local_RTDB_Client;
+
+public:
+    FB_Local_RTDB()
+    {
+#if defined(ESP32)
+        mutex = xSemaphoreCreateRecursiveMutex();
+#endif
+    };
+
+    ~FB_Local_RTDB();
+
+    /** Only accept the requests with this auth (database secret), empty string to accept any auth.
+    */
+    void setAuth(const char *secret) { this->secret = secret ? secret : ""; }
+
+    /** Set the interval of the keep-alive event of the streams, 0 to disable.
+    */
+    void setKeepAliveInterval(uint32_t ms) { keepAliveInterval = ms; }
+
+    /** Send the response bodies with the chunked transfer encoding in chunks of this size, 0 to send the Content-Length.
+    */
+    void setChunkSize(size_t size) { chunkSize = size; }
+
+    /** Set the node data directly e.g. the initial data, the streams are notified.
+     *
+     * @param path The node path.
+     * @param json The JSON value e.g. {"a":1}, "text", 1.5 or null.
+     * @return Boolean type status indicates the JSON value was valid.
+    */
+    bool set(const char *path, const char *json);
+
+    /** Get the node data.
+     *
+     * @param path The node path.
+     * @param json The JSON value of the node, null for the node that does not exist.
+    */
+    void get(const char *path, MB_String &json);
+
+    //remove all data, the streams are not notified
+    void clear();
+
+    //the number of requests, the stream events (fan-out) and the error responses (4xx)
+    size_t requestCount() { return requests; }
+    size_t eventCount() { return events; }
+    size_t errorCount() { return errors; }
+
+    void resetCounters()
+    {
+        requests = 0;
+        events = 0;
+        errors = 0;
+    }
+
+    /** Handle the request of the connection.
+     *
+     * @param request The request that was written.
+     * @param response The response to send.
+     * @param client The connection, which becomes the stream when the event stream was requested.
+     * @return Boolean type status indicates the request was complete and the response was set.
+    */
+    bool handle(const MB_String &request, MB_String &response, FB_Local_RTDB_Client *client);
+
+private:
+    struct request_t
+    {
+        MB_String method;
+        std::vector<MB_String> path;
+        MB_String auth;
+        MB_String orderBy;
+        MB_String startAt;
+        MB_String endAt;
+        MB_String equalTo;
+        int limitToFirst = -1;
+        int limitToLast = -1;
+        bool hasFilter = false;
+        bool silent = false;
+        bool shallow = false;
+        bool stream = false;
+        bool etag = false;
+        MB_String ifMatch;
+        MB_String ifNoneMatch;
+        MB_String body;
+    };
+
+    struct item_t
+    {
+        MB_JSON *node = nullptr;
+        const MB_JSON *value = nullptr;
+    };
+
+    MB_JSON *root = nullptr;
+    std::vector<FB_Local_RTDB_Client *> clients;
+    MB_String secret;
+    uint32_t keepAliveInterval = FB_LOCAL_RTDB_KEEP_ALIVE_INTERVAL;
+    size_t chunkSize = 0;
+    uint64_t pushMillis = 0;
+    uint8_t pushRand[12];
+    size_t requests = 0;
+    size_t events = 0;
+    size_t errors = 0;
+#if defined(ESP32)
+    SemaphoreHandle_t mutex = NULL;
+#endif
+
+    void lock()
+    {
+#if defined(ESP32)
+        xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+#endif
+    }
+
+    void unlock()
+    {
+#if defined(ESP32)
+        xSemaphoreGiveRecursive(mutex);
+#endif
+    }
+
+    bool parseRequest(const MB_String &request, request_t &req, bool &complete)
+    {
+        complete = false;
+        const char *s = request.c_str();
+        const char *end = strstr(s, "\r\n\r\n");
+        if (!end)
+            return false;
+
+        size_t headerLen = end - s + 4;
+        size_t contentLen = 0;
+
+        //the request line
+        const char *p = strchr(s, ' ');
+        if (!p || p > end)
+            return false;
+        req.method.appendN(s, p - s);
+
+        const char *t = p + 1;
+        p = strchr(t, ' ');
+        if (!p || p > end)
+            return false;
+        MB_String target;
+        target.appendN(t, p - t);
+
+        //the header fields
+        MB_String value;
+        for (p = strstr(s, "\r\n") + 2; p < end; p = strstr(p, "\r\n") + 2)
+        {
+            if (headerValue(p, "Content-Length", value))
+                contentLen = atoi(value.c_str());
+            else if (headerValue(p, "X-HTTP-Method-Override", value))
+                req.method = value;
+            else if (headerValue(p, "Accept", value))
+                req.stream = strstr(value.c_str(), "text/event-stream") != nullptr;
+            else if (headerValue(p, "X-Firebase-ETag", value))
+                req.etag = strcmp(value.c_str(), "true") == 0;
+            else if (headerValue(p, "if-match", value))
+                req.ifMatch = value;
+            else if (headerValue(p, "if-none-match", value))
+                req.ifNoneMatch = value;
+        }
+
+        if (request.length() < headerLen + contentLen)
+            return false;
+
+        complete = true;
+        req.body.appendN(s + headerLen, contentLen);
+
+        //the path ends at .json, the query parameters are separated by ? or &
+        const char *q = nullptr;
+        for (p = strstr(target.c_str(), ".json"); p && !q; p = strstr(p + 1, ".json"))
+        {
+            if (p[5] == '\0' || p[5] == '?' || p[5] == '&')
+                q = p;
+        }
+
+        if (!q)
+            return false;
+
+        MB_String path;
+        path.appendN(target.c_str(), q - target.c_str());
+        splitPath(path.c_str(), req.path);
+
+        for (p = q + 5; *p;)
+        {
+            p++;
+            const char *e = p + strcspn(p, "?&");
+            const char *eq = (const char *)memchr(p, '=', e - p);
+            if (eq)
+            {
+                MB_String name, arg;
+                name.appendN(p, eq - p);
+                urlDecode(eq + 1, e - eq - 1, arg);
+
+                if (name == "auth")
+                    req.auth = arg;
+                else if (name == "print")
+                    req.silent = arg == "silent";
+                else if (name == "shallow")
+                    req.shallow = arg == "true";
+                else if (name == "orderBy")
+                    req.orderBy = arg;
+                else if (name == "startAt")
+                    req.startAt = arg;
+                else if (name == "endAt")
+                    req.endAt = arg;
+                else if (name == "equalTo")
+                    req.equalTo = arg;
+                else if (name == "limitToFirst")
+                    req.limitToFirst = atoi(arg.c_str());
+                else if (name == "limitToLast")
+                    req.limitToLast = atoi(arg.c_str());
+
+                if (name == "startAt" || name == "endAt" || name == "equalTo" || name == "limitToFirst" || name == "limitToLast")
+                    req.hasFilter = true;
+            }
+            p = e;
+        }
+
+        return true;
+    }
+
+    //get the value of the header field at the line start (case insensitive name)
+    static bool headerValue(const char *line, const char *name, MB_String &value)
+    {
+        size_t len = strlen(name);
+        if (strncasecmp(line, name, len) != 0 || line[len] != ':')
+            return false;
+
+        line += len + 1;
+        while (*line == ' ')
+            line++;
+
+        value.clear();
+        value.appendN(line, strcspn(line, "\r\n"));
+        return true;
+    }
+
+    static void urlDecode(const char *s, size_t len, MB_String &out)
+    {
+        out.clear();
+        for (size_t i = 0; i < len; i++)
+        {
+            if (s[i] == '%' && i + 2 < len && isxdigit(s[i + 1]) && isxdigit(s[i + 2]))
+            {
+                char hex[3] = {s[i + 1], s[i + 2], 0};
+                out += (char)strtol(hex, nullptr, 16);
+                i += 2;
+            }
+            else
+                out += s[i];
+        }
+    }
+
+    static void splitPath(const char *path, std::vector<MB_String> &segs)
+    {
+        segs.clear();
+        while (*path)
+        {
+            size_t len = strcspn(path, "/");
+            if (len > 0)
+            {
+                MB_String seg;
+                urlDecode(path, len, seg);
+                segs.push_back(seg);
+            }
+            path += len;
+            if (*path == '/')
+                path++;
+        }
+    }
+
+    //is a the same path as b or the parent path of b
+    static bool isPrefix(const std::vector<MB_String> &a, const std::vector<MB_String> &b)
+    {
+        if (a.size() > b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (!(a[i] == b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    static void joinPath(const std::vector<MB_String> &segs, size_t from, MB_String &path)
+    {
+        path = "/";
+        for (size_t i = from; i < segs.size(); i++)
+        {
+            if (i > from)
+                path += "/";
+            path += segs[i];
+        }
+    }
+
+    //the non-negative integer key (array index)
+    static bool arrayIndex(const char *key, int &index)
+    {
+        size_t len = strlen(key);
+        if (len == 0 || len > 9 || (len > 1 && key[0] == '0') || strspn(key, "0123456789") != len)
+            return false;
+        index = atoi(key);
+        return true;
+    }
+
+    uint64_t timestamp()
+    {
+        if (time(nullptr) > 1600000000)
+            return (uint64_t)time(nullptr) * 1000 + millis() % 1000;
+        return millis();
+    }
+
+    void pushKey(MB_String &key)
+    {
+        char buf[21];
+        UtilsClass::makePushID(buf, timestamp(), pushMillis, pushRand);
+        key = buf;
+    }
+
+    //convert the value to the stored form, the arrays are stored as the objects of the index keys,
+    //the null values and the empty objects are removed, nullptr is returned for null
+    MB_JSON *importNode(MB_JSON *value)
+    {
+        if (!value || MB_JSON_IsNull(value))
+        {
+            MB_JSON_Delete(value);
+            return nullptr;
+        }
+
+        if (!MB_JSON_IsArray(value) && !MB_JSON_IsObject(value))
+            return value;
+
+        MB_JSON *sv = MB_JSON_GetObjectItemCaseSensitive(value, ".sv");
+        if (sv && MB_JSON_IsString(sv) && strcmp(sv->valuestring, "timestamp") == 0)
+        {
+            MB_JSON_Delete(value);
+            return MB_JSON_CreateNumber((double)timestamp());
+        }
+
+        bool isArray = MB_JSON_IsArray(value);
+        MB_JSON *obj = MB_JSON_CreateObject();
+        MB_String key;
+        int index = 0;
+
+        for (MB_JSON *child = value->child; child; index++)
+        {
+            MB_JSON *next = child->next;
+            MB_JSON_DetachItemViaPointer(value, child);
+
+            if (isArray)
+            {
+                key.clear();
+                key += index;
+            }
+            else
+                key = child->string;
+
+            MB_JSON *v = importNode(child);
+            if (v)
+                MB_JSON_AddItemToObject(obj, key.c_str(), v);
+            child = next;
+        }
+
+        MB_JSON_Delete(value);
+
+        if (!obj->child)
+        {
+            MB_JSON_Delete(obj);
+            return nullptr;
+        }
+
+        return obj;
+    }
+
+    //copy the stored value to the response form, the object of the integer keys is sent as array
+    //when more than half of its indexes are used as the server does
+    static MB_JSON *exportNode(const MB_JSON *node)
+    {
+        if (!MB_JSON_IsObject(node))
+            return MB_JSON_Duplicate(node, true);
+
+        int count = 0, max = -1, index = 0;
+        bool isArray = true;
+        for (MB_JSON *child = node->child; child && isArray; child = child->next)
+        {
+            isArray = arrayIndex(child->string, index);
+            count++;
+            if (index > max)
+                max = index;
+        }
+
+        if (isArray && count * 2 > max + 1)
+        {
+            MB_JSON *arr = MB_JSON_CreateArray();
+            MB_String key;
+            for (int i = 0; i <= max; i++)
+            {
+                key.clear();
+                key += i;
+                MB_JSON *child = MB_JSON_GetObjectItemCaseSensitive(node, key.c_str());
+                MB_JSON_AddItemToArray(arr, child ? exportNode(child) : MB_JSON_CreateNull());
+            }
+            return arr;
+        }
+
+        MB_JSON *obj = MB_JSON_CreateObject();
+        for (MB_JSON *child = node->child; child; child = child->next)
+            MB_JSON_AddItemToObject(obj, child->string, exportNode(child));
+        return obj;
+    }
+
+    static void printNode(const MB_JSON *node, MB_String &out)
+    {
+        out.clear();
+        if (!node)
+        {
+            out = "null";
+            return;
+        }
+
+        MB_JSON *e = exportNode(node);
+        char *s = MB_JSON_PrintUnformatted(e);
+        if (s)
+        {
+            out = s;
+            MB_JSON_free(s);
+        }
+        MB_JSON_Delete(e);
+    }
+
+    //the ETag of the printed value (FNV-1a)
+    static void etagOf(const MB_String &value, MB_String &etag)
+    {
+        if (value == "null")
+        {
+            etag = "null_etag";
+            return;
+        }
+
+        uint32_t h = 2166136261UL;
+        for (size_t i = 0; i < value.length(); i++)
+            h = (h ^ (uint8_t)value[i]) * 16777619UL;
+
+        char buf[9];
+        snprintf(buf, sizeof(buf), "%08x", (unsigned int)h);
+        etag = buf;
+    }
+
+    MB_JSON *findNode(const std::vector<MB_String> &segs, size_t count)
+    {
+        MB_JSON *node = root;
+        for (size_t i = 0; node && i < count; i++)
+            node = MB_JSON_IsObject(node) ? MB_JSON_GetObjectItemCaseSensitive(node, segs[i].c_str()) : nullptr;
+        return node;
+    }
+
+    MB_JSON *findNode(const std::vector<MB_String> &segs) { return findNode(segs, segs.size()); }
+
+    //set the stored value (from importNode) to the path, nullptr removes the node and its empty parents
+    void setNode(const std::vector<MB_String> &segs, MB_JSON *value)
+    {
+        if (segs.size() == 0)
+        {
+            MB_JSON_Delete(root);
+            root = value;
+            return;
+        }
+
+        if (!value)
+        {
+            for (size_t n = segs.size(); n > 0; n--)
+            {
+                MB_JSON *parent = findNode(segs, n - 1);
+                if (!parent || !MB_JSON_IsObject(parent))
+                    return;
+                MB_JSON_DeleteItemFromObjectCaseSensitive(parent, segs[n - 1].c_str());
+                if (parent->child)
+                    return;
+            }
+            MB_JSON_Delete(root);
+            root = nullptr;
+            return;
+        }
+
+        if (!MB_JSON_IsObject(root))
+        {
+            MB_JSON_Delete(root);
+            root = MB_JSON_CreateObject();
+        }
+
+        MB_JSON *parent = root;
+        for (size_t i = 0; i + 1 < segs.size(); i++)
+        {
+            MB_JSON *child = MB_JSON_GetObjectItemCaseSensitive(parent, segs[i].c_str());
+            if (!MB_JSON_IsObject(child))
+            {
+                MB_JSON *obj = MB_JSON_CreateObject();
+                if (child)
+                    MB_JSON_ReplaceItemInObjectCaseSensitive(parent, segs[i].c_str(), obj);
+                else
+                    MB_JSON_AddItemToObject(parent, segs[i].c_str(), obj);
+                child = obj;
+            }
+            parent = child;
+        }
+
+        if (MB_JSON_GetObjectItemCaseSensitive(parent, segs.back().c_str()))
+            MB_JSON_ReplaceItemInObjectCaseSensitive(parent, segs.back().c_str(), value);
+        else
+            MB_JSON_AddItemToObject(parent, segs.back().c_str(), value);
+    }
+
+    //the sort order of the values: null, false, true, numbers, strings then objects
+    static int typeRank(const MB_JSON *v)
+    {
+        if (!v || MB_JSON_IsNull(v))
+            return 0;
+        if (MB_JSON_IsFalse(v))
+            return 1;
+        if (MB_JSON_IsTrue(v))
+            return 2;
+        if (MB_JSON_IsNumber(v))
+            return 3;
+        if (MB_JSON_IsString(v))
+            return 4;
+        return 5;
+    }
+
+    static int compareValue(const MB_JSON *a, const MB_JSON *b)
+    {
+        int ra = typeRank(a), rb = typeRank(b);
+        if (ra != rb)
+            return ra < rb ? -1 : 1;
+        if (ra == 3)
+            return a->valuedouble < b->valuedouble ? -1 : (a->valuedouble > b->valuedouble ? 1 : 0);
+        if (ra == 4)
+            return strcmp(a->valuestring, b->valuestring);
+        return 0;
+    }
+
+    //the integer keys are sorted first by their value, then the other keys
+    static int compareKey(const char *a, const char *b)
+    {
+        int ia = 0, ib = 0;
+        bool na = arrayIndex(a, ia), nb = arrayIndex(b, ib);
+        if (na && nb)
+            return ia < ib ? -1 : (ia > ib ? 1 : 0);
+        if (na != nb)
+            return na ? -1 : 1;
+        return strcmp(a, b);
+    }
+
+    //compare the child to the parsed startAt, endAt or equalTo argument
+    static int compareArg(const item_t &item, const MB_JSON *v, const MB_String &arg, bool byKey)
+    {
+        if (byKey)
+            return compareKey(item.node->string, v && MB_JSON_IsString(v) ? v->valuestring : arg.c_str());
+        return v ? compareValue(item.value, v) : 0;
+    }
+
+    //apply orderBy and the filters to the children of the node
+    MB_JSON *queryNode(const MB_JSON *node, const request_t &req)
+    {
+        MB_String orderBy = req.orderBy;
+        if (orderBy.length() > 1 && orderBy[0] == '"' && orderBy[orderBy.length() - 1] == '"')
+            orderBy = orderBy.substr(1, orderBy.length() - 2);
+
+        bool byKey = orderBy == "$key";
+        bool byValue = orderBy == "$value";
+        if (orderBy == "$priority")
+            orderBy = ".priority";
+
+        std::vector<MB_String> childPath;
+        splitPath(orderBy.c_str(), childPath);
+
+        std::vector<item_t> items;
+        if (MB_JSON_IsObject(node))
+        {
+            for (MB_JSON *child = node->child; child; child = child->next)
+            {
+                item_t item;
+                item.node = child;
+                if (byValue)
+                    item.value = child;
+                else if (!byKey)
+                {
+                    const MB_JSON *v = child;
+                    for (size_t i = 0; v && i < childPath.size(); i++)
+                        v = MB_JSON_IsObject(v) ? MB_JSON_GetObjectItemCaseSensitive(v, childPath[i].c_str()) : nullptr;
+                    item.value = v;
+                }
+                items.push_back(item);
+            }
+        }
+
+        std::stable_sort(items.begin(), items.end(), [byKey](const item_t &a, const item_t &b) {
+            int r = byKey ? 0 : compareValue(a.value, b.value);
+            if (r == 0)
+                r = compareKey(a.node->string, b.node->string);
+            return r < 0;
+        });
+
+        MB_String startAt = req.equalTo.length() > 0 ? req.equalTo : req.startAt;
+        MB_String endAt = req.equalTo.length() > 0 ? req.equalTo : req.endAt;
+        MB_JSON *start = startAt.length() > 0 ? MB_JSON_Parse(startAt.c_str()) : nullptr;
+        MB_JSON *end = endAt.length() > 0 ? MB_JSON_Parse(endAt.c_str()) : nullptr;
+
+        std::vector<item_t> selected;
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            if (startAt.length() > 0 && compareArg(items[i], start, startAt, byKey) < 0)
+                continue;
+            if (endAt.length() > 0 && compareArg(items[i], end, endAt, byKey) > 0)
+                continue;
+            selected.push_back(items[i]);
+        }
+
+        MB_JSON_Delete(start);
+        MB_JSON_Delete(end);
+
+        size_t first = 0, last = selected.size();
+        if (req.limitToFirst >= 0 && (size_t)req.limitToFirst < last)
+            last = req.limitToFirst;
+        if (req.limitToLast >= 0 && (size_t)req.limitToLast < last - first)
+            first = last - req.limitToLast;
+
+        MB_JSON *obj = MB_JSON_CreateObject();
+        for (size_t i = first; i < last; i++)
+            MB_JSON_AddItemToObject(obj, selected[i].node->string, MB_JSON_Duplicate(selected[i].node, true));
+        return obj;
+    }
+
+    MB_JSON *shallowNode(const MB_JSON *node)
+    {
+        if (!MB_JSON_IsObject(node))
+            return MB_JSON_Duplicate(node, true);
+
+        MB_JSON *obj = MB_JSON_CreateObject();
+        for (MB_JSON *child = node->child; child; child = child->next)
+            MB_JSON_AddItemToObject(obj, child->string, MB_JSON_IsObject(child) ? MB_JSON_CreateTrue() : MB_JSON_Duplicate(child, true));
+        return obj;
+    }
+
+    void reply(MB_String &response, int code, const MB_String &body, const MB_String &etag)
+    {
+        const char *status = "OK";
+        switch (code)
+        {
+        case 204:
+            status = "No Content";
+            break;
+        case 304:
+            status = "Not Modified";
+            break;
+        case 400:
+            status = "Bad Request";
+            break;
+        case 401:
+            status = "Unauthorized";
+            break;
+        case 405:
+            status = "Method Not Allowed";
+            break;
+        case 412:
+            status = "Precondition Failed";
+            break;
+        default:
+            break;
+        }
+
+        if (code >= 400)
+            errors++;
+
+        response = "HTTP/1.1 ";
+        response += code;
+        response += " ";
+        response += status;
+        response += "\r\n";
+        if (body.length() > 0)
+            response += "Content-Type: application/json; charset=utf-8\r\n";
+        if (chunkSize > 0 && body.length() > 0)
+            response += "Transfer-Encoding: chunked";
+        else
+        {
+            response += "Content-Length: ";
+            response += body.length();
+        }
+        response += "\r\nConnection: keep-alive\r\n";
+        if (etag.length() > 0)
+        {
+            response += "ETag: ";
+            response += etag;
+            response += "\r\n";
+        }
+        response += "\r\n";
+
+        if (chunkSize == 0 || body.length() == 0)
+        {
+            response += body;
+            return;
+        }
+
+        //<size in hex>\r\n<data>\r\n ... 0\r\n\r\n
+        char size[16];
+        for (size_t i = 0; i < body.length(); i += chunkSize)
+        {
+            size_t n = body.length() - i < chunkSize ? body.length() - i : chunkSize;
+            snprintf(size, sizeof(size), "%x\r\n", (unsigned)n);
+            response += size;
+            response += body.substr(i, n);
+            response += "\r\n";
+        }
+        response += "0\r\n\r\n";
+    }
+
+    void replyError(MB_String &response, int code, const char *error)
+    {
+        MB_String body = "{\n  \"error\" : \"";
+        body += error;
+        body += "\"\n}\n";
+        reply(response, code, body, MB_String());
+    }
+
+    static void event(MB_String &out, const char *type, const MB_String &path, const MB_String &data)
+    {
+        out += "event: ";
+        out += type;
+        out += "\ndata: {\"path\":\"";
+        out += path;
+        out += "\",\"data\":";
+        out += data;
+        out += "}\n\n";
+    }
+
+    //send the put or patch events to the streams at or under the written path
+    void notify(const std::vector<MB_String> &segs, const MB_String *patch, const std::vector<MB_String> *keys);
+
+    void detach(FB_Local_RTDB_Client *client)
+    {
+        lock();
+        for (size_t i = 0; i < clients.size(); i++)
+        {
+            if (clients[i] == client)
+            {
+                clients.erase(clients.begin() + i);
+                break;
+            }
+        }
+        unlock();
+    }
+};
+
+class FB_Local_RTDB_Client : public FB_Replay_Client
+{
+    friend class FB_Local_RTDB;
+
+public:
+    FB_Local_RTDB_Client(FB_Local_RTDB &server) : server(&server)
+    {
+        server.lock();
+        server.clients.push_back(this);
+        server.unlock();
+    };
+
+    ~FB_Local_RTDB_Client()
+    {
+        if (server)
+            server->detach(this);
+    };
+
+    //the connection is the open event stream
+    bool isStream() { return streaming; }
+
+    int available()
+    {
+        if (server && streaming)
+        {
+            server->lock();
+
+            //the dropped stream does not receive the events
+            if (!isOpen())
+            {
+                streaming = false;
+                queued.clear();
+            }
+            else if (queued.length() == 0 && server->keepAliveInterval > 0 && millis() - eventMillis >= server->keepAliveInterval)
+            {
+                queued = "event: keep-alive\ndata: null\n\n";
+                server->events++;
+            }
+
+            if (streaming && queued.length() > 0)
+            {
+                pushStreamData(queued.c_str());
+                queued.clear();
+                eventMillis = millis();
+            }
+
+            server->unlock();
+        }
+
+        return FB_Replay_Client::available();
+    }
+
+    void stop()
+    {
+        if (server)
+            server->lock();
+        streaming = false;
+        queued.clear();
+        if (server)
+            server->unlock();
+        FB_Replay_Client::stop();
+    }
+
+protected:
+    bool respond(const MB_String &request, MB_String &response)
+    {
+        if (!server)
+            return true;
+        return server->handle(request, response, this);
+    }
+
+private:
+    FB_Local_RTDB *server = nullptr;
+    bool streaming = false;
+    std::vector<MB_String> streamPath;
+    //the events that were sent by the server since the last read
+    MB_String queued;
+    unsigned long eventMillis = 0;
+};
+
+inline FB_Local_RTDB::~FB_Local_RTDB()
+{
+    for (size_t i = 0; i < clients.size(); i++)
+        clients[i]->server = nullptr;
+    MB_JSON_Delete(root);
+#if defined(ESP32)
+    vSemaphoreDelete(mutex);
+#endif
+}
+
+inline bool FB_Local_RTDB::set(const char *path, const char *json)
+{
+    MB_JSON *value = MB_JSON_Parse(json);
+    if (!value)
+        return false;
+
+    std::vector<MB_String> segs;
+    splitPath(path, segs);
+
+    lock();
+    setNode(segs, importNode(value));
+    notify(segs, nullptr, nullptr);
+    unlock();
+    return true;
+}
+
+inline void FB_Local_RTDB::get(const char *path, MB_String &json)
+{
+    std::vector<MB_String> segs;
+    splitPath(path, segs);
+
+    lock();
+    printNode(findNode(segs), json);
+    unlock();
+}
+
+inline void FB_Local_RTDB::clear()
+{
+    lock();
+    MB_JSON_Delete(root);
+    root = nullptr;
+    unlock();
+}
+
+inline bool FB_Local_RTDB::handle(const MB_String &request, MB_String &response, FB_Local_RTDB_Client *client)
+{
+    request_t req;
+    bool complete = false;
+    bool valid = parseRequest(request, req, complete);
+
+    if (!complete)
+        return false;
+
+    lock();
+
+    requests++;
+    client->streaming = false;
+    client->queued.clear();
+
+    MB_String value, etag, empty;
+
+    if (!valid)
+        replyError(response, 400, "Invalid path. Paths must end with .json");
+    else if (secret.length() > 0 && !(req.auth == secret))
+        replyError(response, 401, "Permission denied");
+    else if (req.hasFilter && req.orderBy.length() == 0)
+        replyError(response, 400, "orderBy must be defined when other query parameters are defined");
+    else if (req.method == "GET")
+    {
+        MB_JSON *node = findNode(req.path);
+        if (req.stream)
+        {
+            printNode(node, value);
+            response = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream; charset=utf-8\r\nCache-Control: no-cache\r\n\r\n";
+            event(response, "put", "/", value);
+            events++;
+            client->streaming = true;
+            client->streamPath = req.path;
+            client->eventMillis = millis();
+        }
+        else
+        {
+            if (req.orderBy.length() > 0 || req.shallow)
+            {
+                MB_JSON *result = req.orderBy.length() > 0 ? queryNode(node, req) : shallowNode(node);
+                printNode(result, value);
+                MB_JSON_Delete(result);
+            }
+            else
+                printNode(node, value);
+
+            etagOf(value, etag);
+            if (req.ifNoneMatch.length() > 0 && req.ifNoneMatch == etag)
+                reply(response, 304, empty, etag);
+            else
+                reply(response, req.silent ? 204 : 200, req.silent ? empty : value, req.etag ? etag : empty);
+        }
+    }
+    else if (req.method == "PUT" || req.method == "POST" || req.method == "PATCH" || req.method == "DELETE")
+    {
+        MB_JSON *data = nullptr;
+        if (!(req.method == "DELETE"))
+        {
+            data = MB_JSON_Parse(req.body.c_str());
+            if (!data || (req.method == "PATCH" && !MB_JSON_IsObject(data)))
+            {
+                MB_JSON_Delete(data);
+                replyError(response, 400, "Invalid data; couldn't parse JSON object, array, or value.");
+                unlock();
+                return true;
+            }
+        }
+
+        if (req.ifMatch.length() > 0)
+        {
+            printNode(findNode(req.path), value);
+            etagOf(value, etag);
+            if (!(req.ifMatch == etag))
+            {
+                MB_JSON_Delete(data);
+                reply(response, 412, value, etag);
+                unlock();
+                return true;
+            }
+            etag.clear();
+        }
+
+        if (req.method == "PATCH")
+        {
+            //multi-path update, each key is the path relative to the request path
+            std::vector<MB_String> keys, segs;
+            printNode(data, value);
+            for (MB_JSON *child = data->child; child; child = child->next)
+                keys.push_back(child->string);
+
+            for (size_t i = 0; i < keys.size(); i++)
+            {
+                splitPath(keys[i].c_str(), segs);
+                segs.insert(segs.begin(), req.path.begin(), req.path.end());
+                setNode(segs, importNode(MB_JSON_DetachItemFromObjectCaseSensitive(data, keys[i].c_str())));
+            }
+            MB_JSON_Delete(data);
+            notify(req.path, &value, &keys);
+        }
+        else
+        {
+            std::vector<MB_String> segs = req.path;
+            if (req.method == "POST")
+            {
+                MB_String key;
+                pushKey(key);
+                segs.push_back(key);
+                value = "{\"name\":\"";
+                value += key;
+                value += "\"}";
+            }
+
+            setNode(segs, importNode(data));
+            notify(segs, nullptr, nullptr);
+
+            if (!(req.method == "POST"))
+                printNode(findNode(segs), value);
+            if (req.etag)
+            {
+                MB_String stored;
+                printNode(findNode(req.path), stored);
+                etagOf(stored, etag);
+            }
+        }
+
+        reply(response, req.silent ? 204 : 200, req.silent ? empty : value, etag);
+    }
+    else
+        replyError(response, 405, "Method not allowed");
+
+    unlock();
+    return true;
+}
+
+inline void FB_Local_RTDB::notify(const std::vector<MB_String> &segs, const MB_String *patch, const std::vector<MB_String> *keys)
+{
+    MB_String path, data;
+    std::vector<MB_String> keySegs;
+
+    for (size_t i = 0; i < clients.size(); i++)
+    {
+        FB_Local_RTDB_Client *client = clients[i];
+        if (!client->streaming)
+            continue;
+
+        const std::vector<MB_String> &listen = client->streamPath;
+        size_t count = 0;
+
+        if (isPrefix(listen, segs))
+        {
+            //the stream is at or above the written path
+            joinPath(segs, listen.size(), path);
+            if (patch)
+                event(client->queued, "patch", path, *patch);
+            else
+            {
+                printNode(findNode(segs), data);
+                event(client->queued, "put", path, data);
+            }
+            count++;
+        }
+        else if (isPrefix(segs, listen))
+        {
+            //the stream is under the written path, only the changes under the stream path are sent
+            size_t n = patch ? keys->size() : 1;
+            for (size_t k = 0; k < n; k++)
+            {
+                keySegs = segs;
+                if (patch)
+                {
+                    std::vector<MB_String> rel;
+                    splitPath((*keys)[k].c_str(), rel);
+                    keySegs.insert(keySegs.end(), rel.begin(), rel.end());
+                }
+
+                if (isPrefix(keySegs, listen))
+                {
+                    printNode(findNode(listen), data);
+                    event(client->queued, "put", "/", data);
+                    count++;
+                }
+                else if (isPrefix(listen, keySegs))
+                {
+                    joinPath(keySegs, listen.size(), path);
+                    printNode(findNode(keySegs), data);
+                    event(client->queued, "put", path, data);
+                    count++;
+                }
+            }
+        }
+
+        events += count;
+    }
+}
+
+#endif
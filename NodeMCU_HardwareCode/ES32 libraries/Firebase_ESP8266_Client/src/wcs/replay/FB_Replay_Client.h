@@ -0,0 +1,269 @@
+/**
+ * FB_Replay_Client
+ *
+ * The replay client class for the offline benchmark and test of the request engine.
+ *
+ * The client replays the recorded server responses (the raw HTTP response or the event stream data)
+ * in place of the network connection and keeps the bytes that were written by the library.
+ * It is set to the Firebase Data object by FirebaseData::setTransport.
+ *
+ * Each request takes the next response of the queue, the last response is replayed again when
+ * the repeat mode was set. The stream event data can be pushed at any time to the open stream.
+ *
+ * The derived class can generate the response from the request instead (see FB_Local_RTDB.h).
+ * The response latency and the dropped connections can be injected for the error handling test.
+ *
+ * This work is an extension of the Firebase ESP Client library by K. Suwatchai (Mobizt)
+ * Copyright (c) 2026 RFID Door Lock System contributors
+ *
+ * The MIT License (MIT)
+ */
+
+#ifndef FB_Replay_Client_H
+#define FB_Replay_Client_H
+
+#include <Arduino.h>
+#include <vector>
+#if defined(ESP32)
+#include <WiFi.h>
+#elif defined(ESP8266)
+#include <ESP8266WiFi.h>
+#endif
+#include "json/MB_String.h"
+
+class FB_Replay_Client : public WiFiClient
+{
+public:
+    FB_Replay_Client(){};
+    ~FB_Replay_Client(){};
+
+    /** Add the recorded response e.g. "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\ntrue".
+     *
+     * @param data The response data.
+     * @param len The length of data, 0 for the null terminated string.
+    */
+    void addResponse(const char *data, size_t len = 0)
+    {
+        MB_String s;
+        s.appendN(data, len ? len : strlen(data));
+        responses.push_back(s);
+    }
+
+    /** Push the event data (e.g. "event: put\ndata: {...}\n\n") to the response that is currently read.
+     *
+     * @param data The event data.
+    */
+    void pushStreamData(const char *data)
+    {
+        current.erase(0, pos);
+        pos = 0;
+        current += data;
+    }
+
+    /** Replay the last response again for all later requests (for the benchmark loop).
+     *
+     * @param repeat The repeat mode.
+    */
+    void setRepeat(bool repeat) { this->repeat = repeat; }
+
+    void clearResponses()
+    {
+        responses.clear();
+        index = 0;
+        current.clear();
+        pos = 0;
+    }
+
+    /** Set the connection status that the library sees, false to simulate the dropped connection.
+    */
+    void setConnected(bool connected) { isConnected = connected; }
+
+    /** Delay the response of each request as the server and network latency.
+     *
+     * @param ms The time in ms from the last byte written until the response is available.
+    */
+    void setLatency(uint32_t ms) { latency = ms; }
+
+    /** Drop the connection instead of sending the response.
+     *
+     * @param percent The percentage of requests (0 - 100) that their connection will be dropped.
+    */
+    void setDropRate(uint8_t percent) { dropRate = percent; }
+
+    //the number of requests, the dropped requests, the connections and the bytes that were written
+    size_t requestCount() { return requests; }
+    size_t dropCount() { return drops; }
+    size_t connectCount() { return connects; }
+    size_t bytesWritten() { return written; }
+
+    //the last request (the bytes that were written since the previous response was taken)
+    const char *lastRequest() { return request.c_str(); }
+
+    int connect(IPAddress, uint16_t port) { return connect("", port); }
+
+    int connect(const char *, uint16_t)
+    {
+        isConnected = true;
+        connects++;
+        return 1;
+    }
+
+    //the response is not taken here as the request may still be written
+    uint8_t connected() { return isConnected || pos < current.length(); }
+
+    size_t write(uint8_t b) { return write(&b, 1); }
+
+    size_t write(const uint8_t *buf, size_t size)
+    {
+        if (!isConnected)
+            return 0;
+
+        if (!requested)
+        {
+            request.clear();
+            requests++;
+            requested = true;
+        }
+
+        request.appendN((const char *)buf, size);
+        written += size;
+        writeMillis = millis();
+        return size;
+    }
+
+    int available()
+    {
+        if (pos >= current.length() && requested && millis() - writeMillis >= latency)
+            next();
+        return current.length() - pos;
+    }
+
+    int read()
+    {
+        if (available() == 0)
+            return -1;
+        return (uint8_t)current[pos++];
+    }
+
+    int read(uint8_t *buf, size_t size)
+    {
+        size_t n = available();
+        if (n > size)
+            n = size;
+        memcpy(buf, current.c_str() + pos, n);
+        pos += n;
+        return n;
+    }
+
+    size_t readBytes(char *buf, size_t size) { return read((uint8_t *)buf, size); }
+
+    size_t readBytes(uint8_t *buf, size_t size) { return read(buf, size); }
+
+    int peek()
+    {
+        if (available() == 0)
+            return -1;
+        return (uint8_t)current[pos];
+    }
+
+    size_t peekBytes(uint8_t *buf, size_t size)
+    {
+        size_t n = available();
+        if (n > size)
+            n = size;
+        memcpy(buf, current.c_str() + pos, n);
+        return n;
+    }
+
+    void flush() {}
+
+    void stop()
+    {
+        isConnected = false;
+        requested = false;
+        current.clear();
+        pos = 0;
+    }
+
+protected:
+    //the connection was not stopped or dropped
+    bool isOpen() { return isConnected; }
+
+    /** Get the response of the request.
+     *
+     * @param request The request that was written.
+     * @param response The response to send.
+     * @return Boolean type status indicates the request was complete and the response was set.
+     *
+     * @note The default response is the next response of the queue, it is taken when the header and
+     * the content (Content-Length) of the request were written.
+    */
+    virtual bool respond(const MB_String &request, MB_String &response)
+    {
+        if (!requestComplete(request))
+            return false;
+
+        if (index < responses.size())
+            response = responses[index++];
+        else if (repeat && responses.size() > 0)
+            response = responses[responses.size() - 1];
+        return true;
+    }
+
+    static bool requestComplete(const MB_String &request)
+    {
+        const char *s = request.c_str();
+        const char *end = strstr(s, "\r\n\r\n");
+        if (!end)
+            return false;
+
+        size_t contentLen = 0;
+        for (const char *p = strstr(s, "\r\n"); p && p < end; p = strstr(p + 2, "\r\n"))
+        {
+            if (strncasecmp(p + 2, "Content-Length:", 15) == 0)
+                contentLen = atoi(p + 17);
+        }
+
+        return request.length() >= (size_t)(end - s) + 4 + contentLen;
+    }
+
+private:
+    std::vector<MB_String> responses;
+    size_t index = 0;
+    MB_String current;
+    size_t pos = 0;
+    MB_String request;
+    bool requested = false;
+    bool repeat = false;
+    bool isConnected = false;
+    uint32_t latency = 0;
+    uint8_t dropRate = 0;
+    unsigned long writeMillis = 0;
+    size_t requests = 0;
+    size_t drops = 0;
+    size_t connects = 0;
+    size_t written = 0;
+
+    //take the response of the request that was written
+    void next()
+    {
+        MB_String response;
+        if (!respond(request, response))
+            return;
+
+        requested = false;
+        current.clear();
+        pos = 0;
+
+        if (dropRate > 0 && (uint8_t)random(100) < dropRate)
+        {
+            isConnected = false;
+            drops++;
+            return;
+        }
+
+        current = response;
+    }
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include <SPI.h> 
 #include <RFID.h>
 #include "FirebaseESP8266.h"                                                                              // Install Firebase ESP8266 library
+#include <addons/Attendance/AttendanceAggregator.h>                                                       // Per user daily attendance summary
 
  
 #include <NTPClient.h>
@@ -35,6 +36,10 @@ String alertMsg;
 String StrNumber;
 long int rfidnum = 0;
 String device_id="IEEE Adgitm EXECOMM 2022";
+String summaryPath = "/summary";
+AttendanceAggregator summary;                                                                            //Keeps the per user daily durations and counts
+unsigned long summaryMillis = 0;
+const unsigned long summaryInterval = 60000;                                                             //The changed summary nodes are written once a minute
 //boolean checkIn = true;
 
 
@@ -71,6 +76,11 @@ void setup() {
   connect();
   Firebase.begin(FIREBASE_HOST, FIREBASE_AUTH);
   Firebase.reconnectWiFi(true);
+
+  timeClient.update();
+  Firebase.setSystemTime(timeClient.getEpochTime() - utcOffsetInSeconds);           //UTC time for the push keys
+  Firebase.setLocalPushID(firebaseData, true);                                     //Retried pushes won't duplicate the attendance
+  summary.load(firebaseData, summaryPath.c_str(), timeClient.getEpochTime());     //Continue today's summary after restart
 }
 
 
@@ -89,6 +99,7 @@ void checkAccess (String temp)    //Function to check if an identified tag Curre
           lcd.print(alertMsg);
           delay(1000);
 
+          json.clear();                                                      //The global json keeps the previous event
           json.add("time", String(timeClient.getFormattedDate()));
           json.add("id", device_id);
           json.add("uid", temp);
@@ -101,6 +112,8 @@ void checkAccess (String temp)    //Function to check if an identified tag Curre
           } else {
             Serial.println(firebaseData.errorReason());
           }
+
+          summary.addEvent(temp.c_str(), timeClient.getEpochTime(), 1);      //Written by the summary timer in loop
       }
       else if (firebaseData.intData() == 1)   //If the lock is open then close it
       { 
@@ -111,6 +124,7 @@ void checkAccess (String temp)    //Function to check if an identified tag Curre
 
           Firebase.setInt(firebaseData, uidPath+"/users/"+temp,0);
           
+          json.clear();                                                      //The global json keeps the previous event
           json.add("time", String(timeClient.getFormattedDate()));
           json.add("id", device_id);
           json.add("uid", temp);
@@ -120,6 +134,8 @@ void checkAccess (String temp)    //Function to check if an identified tag Curre
           } else {
             Serial.println(firebaseData.errorReason());
           }
+
+          summary.addEvent(temp.c_str(), timeClient.getEpochTime(), 0);
       }
       
  
@@ -183,6 +199,11 @@ void loop() {
   }
   rfid.halt();
 
+  if (millis() - summaryMillis >= summaryInterval) {                            //Writes only the changed summary nodes of the taps since the last update
+    summaryMillis = millis();
+    summary.update(firebaseData, summaryPath.c_str());                          //The failed update is kept dirty for the next interval
+  }
+
   lcd.setCursor(1,0);   
   lcd.print("SCAN YOUR RFID");
   lcd.setCursor(2,1);   